@@ -0,0 +1,80 @@
+/**
+ * @file    CivilDate.h
+ * @brief   Proleptic Gregorian date <-> day-number arithmetic, constexpr.
+ *
+ * @details
+ * Stands in for mktime() / gmtime() wherever the firmware turns calendar
+ * fields into an epoch or back.  Those calls go through newlib's TZ state,
+ * are not reentrant and cost far more than the few integer operations below.
+ * Day numbers count days since 1970-01-01; all arithmetic is UTC.
+ *
+ * The algorithms are H. Hinnant's days_from_civil / civil_from_days, exact
+ * over the full int32_t day range.  @c fromFields() additionally carries
+ * out-of-range months and days the way mktime() normalises them.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+namespace CivilDate {
+
+struct Ymd {
+    int year;
+    int month;   // 1..12
+    int day;     // 1..31
+};
+
+/// Days since 1970-01-01 of @p y - @p m - @p d (@p m 1..12, @p d 1..31).
+constexpr int32_t daysFromCivil( int32_t y, int m, int d ) {
+    y -= ( m <= 2 );
+    int32_t  era = ( y >= 0 ? y : y - 399 ) / 400;
+    uint32_t yoe = (uint32_t)( y - era * 400 );                             // [0, 399]
+    uint32_t doy = ( 153 * (uint32_t)( m + ( m > 2 ? -3 : 9 ) ) + 2 ) / 5 + (uint32_t)d - 1;   // [0, 365]
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                   // [0, 146096]
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+/// Calendar date of day number @p day.
+constexpr Ymd civilFromDays( int32_t day ) {
+    day += 719468;
+    int32_t  era = ( day >= 0 ? day : day - 146096 ) / 146097;
+    uint32_t doe = (uint32_t)( day - era * 146097 );                        // [0, 146096]
+    uint32_t yoe = ( doe - doe / 1460 + doe / 36524 - doe / 146096 ) / 365; // [0, 399]
+    uint32_t doy = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );               // [0, 365]
+    uint32_t mp  = ( 5 * doy + 2 ) / 153;                                   // [0, 11]
+    int      m   = (int)( mp < 10 ? mp + 3 : mp - 9 );
+    return { (int)( (int32_t)yoe + era * 400 + ( m <= 2 ) ), m, (int)( doy - ( 153 * mp + 2 ) / 5 + 1 ) };
+}
+
+/// Days since 1970-01-01 for possibly out-of-range fields: month overflow
+/// carries into the year, day overflow (including day 0) past the first of
+/// the month – as mktime() normalises them.
+constexpr int32_t fromFields( int32_t y, int32_t m, int32_t d ) {
+    int32_t mon0 = m - 1;
+    int32_t year = y + ( mon0 >= 0 ? mon0 / 12 : ( mon0 - 11 ) / 12 );
+    mon0 -= ( year - y ) * 12;
+    return daysFromCivil( year, (int)mon0 + 1, 1 ) + ( d - 1 );
+}
+
+/// tm_yday (0-based day of year) of @p day.
+constexpr int yearDay( int32_t day ) {
+    return (int)( day - daysFromCivil( civilFromDays( day ).year, 1, 1 ) );
+}
+
+/// tm_wday (0 = Sunday) of @p day.  1970-01-01 was a Thursday.
+constexpr int weekDay( int32_t day ) { return (int)( ( day % 7 + 11 ) % 7 ); }
+
+/// UTC epoch of the given fields, normalised like timegm() / mktime() in UTC.
+constexpr time_t toEpoch( int32_t y, int32_t mon, int32_t d, int32_t h, int32_t mi, int32_t s ) {
+    return (time_t)fromFields( y, mon, d ) * 86400 + (time_t)h * 3600 + (time_t)mi * 60 + s;
+}
+
+static_assert( daysFromCivil( 1970,  1,  1 ) == 0,     "epoch" );
+static_assert( daysFromCivil( 2000,  3,  1 ) == 11017, "leap century" );
+static_assert( civilFromDays( 11016 ).day == 29,       "2000-02-29" );
+static_assert( fromFields( 2024, 13, 0 ) == daysFromCivil( 2024, 12, 31 ), "carry" );
+static_assert( weekDay( 0 ) == 4,                      "Thursday" );
+
+} // namespace CivilDate
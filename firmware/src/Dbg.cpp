@@ -1,5 +1,105 @@
 #include "Dbg.h"
+#include "Deadlines.h"
+#include "JsonParserGeneratorRK.h"
 
 namespace SFDBG {
 bool enabled = false; // default OFF (safe)
+
+static Rec      s_ring[RING_N];
+static uint32_t s_noted   = 0;      // next record's sequence number
+static uint32_t s_flushed = 0;      // records before this one have been published
+static int      s_page    = 0;
+static int      s_dlFlush = -1;
+
+static void onFlushDue(void *) { flush(); }
+
+void note(Tag tag, Code code, int32_t id, uint16_t arg) {
+#if SFDBG_COMPILED
+    s_ring[s_noted % RING_N] = { (uint32_t)Time.now(), id, arg, (uint8_t)tag, (uint8_t)code };
+    s_noted++;
+    if (enabled && !deadlines.armed(s_dlFlush)) deadlines.arm(s_dlFlush, MIN_GAP_MS);
+#else
+    (void)tag; (void)code; (void)id; (void)arg;
+#endif
+}
+
+uint32_t noted() { return s_noted; }
+
+static int retained() { return s_noted < (uint32_t)RING_N ? (int)s_noted : RING_N; }
+
+bool at(int i, Rec &r) {
+    if (i < 0 || i >= retained()) return false;
+    r = s_ring[(s_noted - 1 - i) % RING_N];
+    return true;
+}
+
+static void writeRec(JSONBufferWriter &w, const Rec &r) {
+    w.beginArray();
+        w.value((unsigned int)r.t);
+        w.value((int)r.tag);
+        w.value((int)r.code);
+        w.value((int)r.id);
+        w.value((int)r.arg);
+    w.endArray();
+}
+
+int setLogPage(int page) {
+    s_page = max(page, 0);
+    return s_page;
 }
+
+String showLog() {
+    int n     = retained();
+    int pages = (n + LOG_PAGE - 1) / LOG_PAGE;
+
+    char buf[622];
+    memset(buf, 0, sizeof(buf));
+    JSONBufferWriter w(buf, sizeof(buf) - 1);
+    w.beginObject();
+        w.name("N").value((unsigned int)s_noted);
+        w.name("P").value(s_page);
+        w.name("NP").value(pages);
+        w.name("R").beginArray();
+        Rec r;
+        for (int i = s_page * LOG_PAGE; i < (s_page + 1) * LOG_PAGE && at(i, r); i++) writeRec(w, r);
+        w.endArray();
+    w.endObject();
+    return String(buf);
+}
+
+void flush() {
+#if SFDBG_COMPILED
+    if (!enabled) return;
+    uint32_t oldest = s_noted - (uint32_t)retained();
+    if (s_flushed < oldest) s_flushed = oldest;     // overwritten before it was sent
+    if (s_flushed == s_noted) return;
+
+    char buf[622];
+    memset(buf, 0, sizeof(buf));
+    JSONBufferWriter w(buf, sizeof(buf) - 1);
+    w.beginObject();
+        w.name("T").value("LOG");
+        w.name("N").value((unsigned int)s_noted);
+        w.name("R").beginArray();
+        for (int k = 0; k < LOG_PAGE && s_flushed != s_noted; k++, s_flushed++) {
+            writeRec(w, s_ring[s_flushed % RING_N]);
+        }
+        w.endArray();
+    w.endObject();
+    Particle.publish("SFDBG", buf, PRIVATE);
+
+    if (s_flushed != s_noted) deadlines.arm(s_dlFlush, MIN_GAP_MS);
+#endif
+}
+
+void setup() {
+    s_noted = s_flushed = 0;
+    s_page  = 0;
+    s_dlFlush = deadlines.add(onFlushDue);
+    Particle.variable("s_DbgLog", showLog);
+    Particle.function("s_DbgPage", static_cast<int(*)(String)>([](String s) -> int {
+        return setLogPage(s.toInt());
+    }));
+}
+
+} // namespace SFDBG
@@ -32,4 +32,61 @@ inline void pub(const char* tag, const String& msg, bool force = false) {
 #endif
 }
 
+// ── Diagnostic ring ───────────────────────────────────────────────────────────
+// Per-event failures found in loops over the event table (applicability,
+// mark resolution, purge, ingest, EEPROM load) are not published one by one:
+// a forced pub() per event would hit the cloud rate limit on a large table.
+// They go to a fixed RAM ring of compact records instead.  Read it with the
+// paged s_DbgLog variable (s_DbgPage selects the page, newest first); while
+// debug is enabled, flush() also publishes unsent records as one batched
+// "SFDBG" event at most every MIN_GAP_MS.  Keep pub(..., true) for messages
+// that are urgent and happen once per request.
+
+enum Tag : uint8_t {
+    TAG_EM = 1,         // EventManager
+};
+
+enum Code : uint8_t {
+    JUR_FAIL = 1,       // arg = event JUR intern code
+    FLG_FAIL,           // arg = event FLG intern code
+    SJR_FAIL,           // arg = unit SJR count
+    BMK_FAIL,           // begin mark did not resolve
+    EMK_FAIL,           // end mark did not resolve
+    PURGE_EXPIRED,
+    PURGE_NO_BEGIN,
+    PURGE_INVALID,
+    INTERN_FULL,        // JUR/FLG string table full
+    PARSE_FAIL,         // event rejected by applyEvent(); id 0 if IDV missing
+    SLOT_CRC_FAIL,      // id = EEPROM record number, not event ID
+    NOT_STORED,         // event kept in RAM only: no packed form or EEPROM full
+};
+
+struct Rec {
+    uint32_t t;         // Time.now()
+    int32_t  id;        // event ID
+    uint16_t arg;
+    uint8_t  tag;
+    uint8_t  code;
+};
+
+static const int RING_N   = 32;     // records kept (oldest overwritten)
+static const int LOG_PAGE = 12;     // records per s_DbgLog page / flush publish
+
+// Record one diagnostic; never publishes directly.
+void     note(Tag tag, Code code, int32_t id, uint16_t arg = 0);
+// Records noted since setup(), including any overwritten.
+uint32_t noted();
+// Copy the @p i-th newest retained record (0 = newest).  False if none.
+bool     at(int i, Rec &r);
+
+// {"N":noted,"P":page,"NP":pages,"R":[[t,tag,code,id,arg],...]}, newest first.
+String   showLog();
+int      setLogPage(int page);
+
+// Publish unsent records (LOG_PAGE per event) if enabled.  Driven by a deadline.
+void     flush();
+
+// Clear the ring, register s_DbgLog / s_DbgPage and the flush deadline.
+void     setup();
+
 } // namespace SFDBG
@@ -0,0 +1,122 @@
+#include "Deadlines.h"
+#include "Particle.h"
+
+DeadlineScheduler deadlines;
+
+uint64_t DeadlineScheduler::now() {
+    uint32_t ms = (uint32_t)millis();
+    if ( ms < _lastMs ) _wraps++;
+    _lastMs = ms;
+    return ( (uint64_t)_wraps << 32 ) | ms;
+}
+
+int DeadlineScheduler::add( Callback fn, void *ctx ) {
+    if ( _count >= MAX || fn == nullptr ) return -1;
+    _e[_count] = { fn, ctx, 0, -1 };
+    return _count++;
+}
+
+void DeadlineScheduler::arm( int id, uint32_t delayMs ) {
+    if ( !valid( id ) ) return;
+    place( id, now() + delayMs );
+}
+
+void DeadlineScheduler::rearm( int id, uint32_t periodMs ) {
+    if ( !valid( id ) ) return;
+    place( id, _e[id].due + periodMs );
+}
+
+void DeadlineScheduler::disarm( int id ) {
+    if ( valid( id ) && _e[id].pos >= 0 ) remove( id );
+}
+
+bool DeadlineScheduler::armed( int id ) const {
+    return valid( id ) && _e[id].pos >= 0;
+}
+
+int DeadlineScheduler::poll() {
+    if ( _n == 0 ) return 0;
+    uint64_t t = now();
+    if ( _e[_heap[0]].due > t ) return 0;          // the common case: nothing due
+
+    // Each id runs at most once per poll, even if its callback re-arms it
+    // with no delay; anything it arms is picked up by the next poll()
+    uint16_t ran = 0;
+    int count = 0;
+    while ( _n > 0 && _e[_heap[0]].due <= t && !( ran & ( 1u << _heap[0] ) ) ) {
+        int id = _heap[0];
+        remove( id );
+        ran |= (uint16_t)( 1u << id );
+        _e[id].fn( _e[id].ctx );
+        count++;
+    }
+    return count;
+}
+
+uint32_t DeadlineScheduler::msUntilNext() {
+    if ( _n == 0 ) return IDLE;
+    uint64_t t = now(), due = _e[_heap[0]].due;
+    if ( due <= t ) return 0;
+    return ( due - t >= IDLE ) ? IDLE - 1 : (uint32_t)( due - t );
+}
+
+void DeadlineScheduler::clear() {
+    _count  = 0;
+    _n      = 0;
+    _lastMs = 0;
+    _wraps  = 0;
+}
+
+// ── Heap ─────────────────────────────────────────────────────────────────────
+
+void DeadlineScheduler::place( int id, uint64_t due ) {
+    bool later = _e[id].pos >= 0 && due > _e[id].due;
+    _e[id].due = due;
+    if ( _e[id].pos < 0 ) {
+        _e[id].pos = (int8_t)_n;
+        _heap[_n++] = (int8_t)id;
+        siftUp( _e[id].pos );
+    } else if ( later ) {
+        siftDown( _e[id].pos );
+    } else {
+        siftUp( _e[id].pos );
+    }
+}
+
+void DeadlineScheduler::remove( int id ) {
+    int i = _e[id].pos;
+    _e[id].pos = -1;
+    if ( --_n == i ) return;
+    _heap[i] = _heap[_n];
+    _e[_heap[i]].pos = (int8_t)i;
+    siftDown( i );
+    siftUp( _e[_heap[i]].pos );
+}
+
+void DeadlineScheduler::swap( int i, int j ) {
+    int8_t a = _heap[i];
+    _heap[i] = _heap[j];
+    _heap[j] = a;
+    _e[_heap[i]].pos = (int8_t)i;
+    _e[_heap[j]].pos = (int8_t)j;
+}
+
+void DeadlineScheduler::siftUp( int i ) {
+    while ( i > 0 ) {
+        int p = ( i - 1 ) / 2;
+        if ( _e[_heap[p]].due <= _e[_heap[i]].due ) return;
+        swap( i, p );
+        i = p;
+    }
+}
+
+void DeadlineScheduler::siftDown( int i ) {
+    for ( ;; ) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if ( l < _n && _e[_heap[l]].due < _e[_heap[m]].due ) m = l;
+        if ( r < _n && _e[_heap[r]].due < _e[_heap[m]].due ) m = r;
+        if ( m == i ) return;
+        swap( i, m );
+        i = m;
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file    Deadlines.h
+ * @brief   One min-heap of millis() deadlines for all time-driven firmware work.
+ *
+ * @details
+ * Each module used to poll its own millis() stamp on every loop():
+ * EventManager's software timer, HalyardManager's forced-station expiry and
+ * move timeout, the status heartbeat, the lid-closed countdown and the
+ * fault-recovery timeout.  They now register a callback here once (at
+ * setup) and arm it with a delay; loop() calls @c poll(), which compares
+ * the clock with the heap top and returns at once when nothing is due.
+ * @c msUntilNext() says how long the unit could sleep.
+ *
+ * Deadlines are kept on a 64-bit millisecond clock extended from millis(),
+ * so the 49.7-day wrap is invisible to callers and any 32-bit delay is
+ * valid.  poll() must therefore run at least once per wrap, which loop()
+ * guarantees.
+ *
+ * Callbacks run from poll() on the loop() thread, never from an ISR.  They
+ * may arm or disarm any deadline, including their own; a deadline armed
+ * again from its own callback does not run twice in the same poll().
+ * Storage is fixed (@c MAX entries); add() returns -1 when full.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class DeadlineScheduler {
+public:
+    typedef void (*Callback)( void *ctx );
+
+    static const int      MAX  = 8;
+    static const uint32_t IDLE = 0xFFFFFFFFu;   // msUntilNext() with nothing armed
+
+    /// Register @p fn (disarmed).  Returns its id, or -1 if the table is full.
+    int      add        ( Callback fn, void *ctx = nullptr );
+    /// Run @p id's callback @p delayMs from now (re-arming moves it).
+    void     arm        ( int id, uint32_t delayMs );
+    /// Run @p id's callback @p periodMs after its last due time – drift-free
+    /// for periodic work armed from its own callback.
+    void     rearm      ( int id, uint32_t periodMs );
+    void     disarm     ( int id );
+    bool     armed      ( int id ) const;
+
+    /// Run every callback that is due.  Returns the number run.
+    int      poll       ();
+    /// Milliseconds until the earliest armed deadline (0 if overdue, IDLE if none).
+    uint32_t msUntilNext();
+
+    /// Drop every registration, as after a reset.
+    void     clear      ();
+
+private:
+    struct Entry {
+        Callback fn;
+        void    *ctx;
+        uint64_t due;
+        int8_t   pos;      // index in _heap, -1 when disarmed
+    };
+
+    uint64_t now        ();
+    void     place      ( int id, uint64_t due );
+    void     remove     ( int id );
+    void     siftUp     ( int i );
+    void     siftDown   ( int i );
+    void     swap       ( int i, int j );
+    bool     valid      ( int id ) const { return id >= 0 && id < _count; }
+
+    Entry    _e[MAX];
+    int8_t   _heap[MAX];   // ids, min-heap on _e[id].due
+    int      _count = 0;   // registered ids
+    int      _n     = 0;   // armed ids (heap size)
+
+    uint32_t _lastMs = 0;  // millis() at the last now()
+    uint32_t _wraps  = 0;
+};
+
+extern DeadlineScheduler deadlines;
@@ -1,23 +1,33 @@
 #include "Particle.h"
 #include "ConfigDefaults.h"
 #include "EEPROMManager.h"
+#include "EEPROMShadow.h"
+#include "CivilDate.h"
 #include "HalyardManager.h"
 #include "FlagUtils.h"
 #include "SmartFlagFSM.h"
 #include "Sensor.h"
 #include <time.h>
+#include <stddef.h>
 
 // These must be defined in main firmware
 extern HalyardManager halMgr1;
 extern FSMController fsm;
 extern Sensor lidSensor;        // Lid sensor
 
+// Status log and config slots (defined below)
+static void eraseStatusLog();
+static void appendStatus(const StatusData &st);
+static int  scanStatusLog(int slots, StatusRec &best);
+static void statusFromRec(const StatusRec &r, StatusData &st);
+static void eraseConfigSlots(bool withExt);
+
 // ====================
 // Validation & Migration
 // ====================
 bool validateOrMigrateEEPROM() {
     EEPROMHeader hdr;
-    EEPROM.get(EEPROM_ADDR_HEADER, hdr);
+    eepromShadow.get(EEPROM_ADDR_HEADER, hdr);
 
     if (hdr.magic != EEPROM_MAGIC) {
         Log.info("EEPROM not initialized or wrong magic. Initializing...");
@@ -47,10 +57,11 @@ void initEEPROM() {
         .flags = 0,
         .lastWriteUTC = Time.now()
     };
-    EEPROM.put(EEPROM_ADDR_HEADER, hdr);
+    eepromShadow.put(EEPROM_ADDR_HEADER, hdr);
 
     ConfigData cfg = ConfigDefaults::makeDefaultConfig();
-    EEPROM.put(EEPROM_ADDR_CONFIG, cfg);
+    eraseConfigSlots(false);            // CFGX is left to validateOrInitConfigExt()
+    writeConfig(cfg);
 
     StatusData status = {};  // Zero-initialize the whole struct
     status.reboot_count = 0;
@@ -65,14 +76,19 @@ void initEEPROM() {
     // status.LID = false;
     status.NSTA = FLAG_UNKNOWN;
 
-    EEPROM.put(EEPROM_ADDR_STATUS, status);
+    eraseStatusLog();
+    appendStatus(status);
 
     EventHeader eventHeader = {0};
-    EEPROM.put(EEPROM_ADDR_EVENT_HDR, eventHeader);
+    eepromShadow.put(EEPROM_ADDR_EVENT_HDR, eventHeader);
+
+    EventStrings strings = {};
+    eepromShadow.put(EEPROM_ADDR_EVENT_LIST, strings);
 
     Log.info("EEPROM initialized with magic 'G3'.");
 }
 
+// v3 FlagEvent slots that fit the event region
 static uint8_t maxEventsInEEPROM() {
     int upperBound = EEPROM_ADDR_CFGX;  // CFGX starts here
     int bytesAvailable = upperBound - EEPROM_ADDR_EVENT_LIST;
@@ -86,13 +102,13 @@ bool migrateEEPROM(uint8_t oldVersion) {
 
         // Read existing data from v1 layout
         ConfigData cfg_v1;
-        EEPROM.get(EEPROM_ADDR_CONFIG, cfg_v1);
+        eepromShadow.get(EEPROM_ADDR_CONFIG, cfg_v1);
 
         StatusData st_v1;
-        EEPROM.get(EEPROM_ADDR_STATUS, st_v1);
+        eepromShadow.get(EEPROM_ADDR_STATUS, st_v1);
 
         EventHeader eh;
-        EEPROM.get(EEPROM_ADDR_EVENT_HDR, eh);
+        eepromShadow.get(EEPROM_ADDR_EVENT_HDR, eh);
 
         // Read event list (bounded)
         uint8_t maxEv = maxEventsInEEPROM();
@@ -104,7 +120,7 @@ bool migrateEEPROM(uint8_t oldVersion) {
             events = new FlagEvent[count];
             for (uint8_t i = 0; i < count; i++) {
                 int addr = EEPROM_ADDR_EVENT_LIST + i * sizeof(FlagEvent);
-                EEPROM.get(addr, events[i]);
+                eepromShadow.get(addr, events[i]);
             }
         }
 
@@ -112,21 +128,21 @@ bool migrateEEPROM(uint8_t oldVersion) {
         initEEPROM();
 
         // Restore preserved data
-        EEPROM.put(EEPROM_ADDR_CONFIG, cfg_v1);
+        writeConfig(cfg_v1);
 
         // For v2: keep everything we read, and ensure new field is initialized.
         // In v1, reboot_count bytes would have been part of reserved, likely 0.
         // We still enforce explicit init here.
         st_v1.reboot_count = 0;
-        EEPROM.put(EEPROM_ADDR_STATUS, st_v1);
+        eepromShadow.put(EEPROM_ADDR_STATUS, st_v1);
 
         eh.eventCount = count; // ensure bounded
-        EEPROM.put(EEPROM_ADDR_EVENT_HDR, eh);
+        eepromShadow.put(EEPROM_ADDR_EVENT_HDR, eh);
 
         if (events && count > 0) {
             for (uint8_t i = 0; i < count; i++) {
                 int addr = EEPROM_ADDR_EVENT_LIST + i * sizeof(FlagEvent);
-                EEPROM.put(addr, events[i]);
+                eepromShadow.put(addr, events[i]);
             }
             delete[] events;
         }
@@ -136,23 +152,156 @@ bool migrateEEPROM(uint8_t oldVersion) {
         return true;
     }
 
-    if (oldVersion == 2 && EEPROM_VERSION == 3) {
+    if (oldVersion == 2 && EEPROM_VERSION >= 3) {
         // FlagEvent struct grew from 64 to 80 bytes — old event data at old offsets
         // is layout-incompatible with the new struct.  Preserve config and status;
         // clear the event list.  Events will re-arrive via cloud subscription.
 
         ConfigData cfg_v2;
-        EEPROM.get(EEPROM_ADDR_CONFIG, cfg_v2);
+        eepromShadow.get(EEPROM_ADDR_CONFIG, cfg_v2);
 
         StatusData st_v2;
-        EEPROM.get(EEPROM_ADDR_STATUS, st_v2);
+        eepromShadow.get(EEPROM_ADDR_STATUS, st_v2);
+
+        ConfigExt x;
+        eepromShadow.get(EEPROM_ADDR_CFGX, x);
+
+        initEEPROM();   // writes new header (current version) and zeroes event list
+
+        eraseConfigSlots(true);         // tag bytes held v2 status
+        writeConfig(cfg_v2);
+        writeConfigExt(x);              // validateOrInitConfigExt() repairs it if unset
+        appendStatus(st_v2);
+
+        SFDBG::pub("EEP", String::format("Migrated v2->v%u: cfg/status kept, events cleared (struct resize)",
+                                         EEPROM_VERSION), true);
+        return true;
+    }
+
+    if (oldVersion == 3 && EEPROM_VERSION >= 4) {
+        // FlagEvent slots become packed records.  The records start inside the
+        // v3 slot area, so every slot is read before anything is written.
+        ConfigData cfg_v3;
+        eepromShadow.get(EEPROM_ADDR_CONFIG, cfg_v3);
+
+        StatusData st_v3;
+        eepromShadow.get(EEPROM_ADDR_STATUS, st_v3);
+
+        ConfigExt x;
+        eepromShadow.get(EEPROM_ADDR_CFGX, x);
+
+        EventHeader eh;
+        eepromShadow.get(EEPROM_ADDR_EVENT_HDR, eh);
+        bool slotCRC = (eh.flags & EVH_FLAG_CRC) != 0;
+
+        // Sparse CRC images use every slot; older ones the first eventCount
+        uint8_t maxEv = maxEventsInEEPROM();
+        uint8_t nSlots = slotCRC ? maxEv : (eh.eventCount < maxEv ? eh.eventCount : maxEv);
+        FlagEvent* events = new FlagEvent[maxEv];
+        int count = 0;
+        for (uint8_t i = 0; i < nSlots; i++) {
+            FlagEvent &e = events[count];
+            if (!readEventSlot(i, e)) continue;
+            if (slotCRC && e.crc8 != eventCRC(e)) continue;
+            if (e.idv[0] != '\0') count++;
+        }
+
+        initEEPROM();
+        eraseConfigSlots(true);         // tag bytes held v3 status
+        writeConfig(cfg_v3);
+        writeConfigExt(x);
+        appendStatus(st_v3);
+
+        // Strings as NUL-terminated copies: JUR of record i at 2i, FLG at 2i + 1
+        typedef char V3Str[sizeof(FlagEvent::jur) + 1];
+        V3Str* text = new V3Str[2 * count];
+        const char** strs = new const char*[2 * count];
+        int* idx = new int[2 * count];
+        for (int i = 0; i < count; i++) {
+            memset(text[2 * i], 0, sizeof(V3Str));
+            memset(text[2 * i + 1], 0, sizeof(V3Str));
+            memcpy(text[2 * i],     events[i].jur, sizeof(events[i].jur));
+            memcpy(text[2 * i + 1], events[i].flg, sizeof(events[i].flg));
+            strs[2 * i]     = text[2 * i];
+            strs[2 * i + 1] = text[2 * i + 1];
+        }
+        EventStrings tab = {};
+        layoutEventStrings(tab, strs, 2 * count, idx);
+        writeEventStrings(tab);
+
+        int kept = 0, offset = 0;
+        for (int i = 0; i < count; i++) {
+            const FlagEvent &e = events[i];
+            int id = 0, ver = 0;
+            if (sscanf(e.idv, "%d.%d", &id, &ver) < 1 || id <= 0) continue;
+
+            TimeMark marks[2];
+            const char (*fields[2])[20] = { &e.bmk, &e.emk };
+            for (int m = 0; m < 2; m++) {
+                if (unpackEventMark(*fields[m], marks[m])) continue;
+                char str[sizeof(e.bmk) + 1] = {0};
+                memcpy(str, *fields[m], sizeof(e.bmk));
+                marks[m] = TimeMarks::compile(str);
+            }
+
+            PackedEvent rec;
+            if (idx[2 * i] < 0 || idx[2 * i + 1] < 0 ||
+                !packEvent(rec, id, ver, marks[0], marks[1], (uint8_t)idx[2 * i], (uint8_t)idx[2 * i + 1],
+                           e.sjrList, e.sjrCount) ||
+                offset + rec.len > EVENT_RECS_BYTES) {
+                continue;
+            }
+            writePackedEvent(offset, rec);
+            offset += rec.len;
+            kept++;
+        }
+
+        eh = {};
+        eh.eventCount = (uint8_t)kept;
+        eh.flags      = EVH_FLAG_CRC;
+        writeEventHeader(eh);
+
+        delete[] idx;
+        delete[] strs;
+        delete[] text;
+        delete[] events;
+
+        SFDBG::pub("EEP", String::format("Migrated v3->v%u: cfg/status kept, %d of %d events packed",
+                                         EEPROM_VERSION, kept, count), true);
+        return true;
+    }
+
+    if ((oldVersion == 4 || oldVersion == 5) && EEPROM_VERSION == 6) {
+        // Events stay where they are.  StatusData comes from the v4 block or
+        // the 16-slot v5 log; ConfigData / ConfigExt are committed from their
+        // A blocks.  The tags overwrite the v4 status block and the B slots
+        // the end of the v5 log, so everything is read first.
+        StatusData st = {};
+        if (oldVersion == 4) {
+            eepromShadow.get(EEPROM_ADDR_STATUS, st);
+        } else {
+            StatusRec best = {};
+            if (scanStatusLog(16, best) >= 0) statusFromRec(best, st);
+        }
+        ConfigData cfg;
+        ConfigExt  x;
+        eepromShadow.get(EEPROM_ADDR_CONFIG, cfg);
+        eepromShadow.get(EEPROM_ADDR_CFGX, x);
 
-        initEEPROM();   // writes new header (version 3) and zeroes event list
+        eraseConfigSlots(true);
+        writeConfig(cfg);
+        writeConfigExt(x);
+        eraseStatusLog();
+        appendStatus(st);
 
-        EEPROM.put(EEPROM_ADDR_CONFIG, cfg_v2);
-        EEPROM.put(EEPROM_ADDR_STATUS, st_v2);
+        EEPROMHeader hdr;
+        eepromShadow.get(EEPROM_ADDR_HEADER, hdr);
+        hdr.version = EEPROM_VERSION;
+        hdr.lastWriteUTC = Time.now();
+        eepromShadow.put(EEPROM_ADDR_HEADER, hdr);
 
-        SFDBG::pub("EEP", "Migrated v2->v3: cfg/status kept, events cleared (struct resize)", true);
+        SFDBG::pub("EEP", String::format("Migrated v%u->v%u: status log, A/B config slots",
+                                         oldVersion, EEPROM_VERSION), true);
         return true;
     }
 
@@ -163,35 +312,289 @@ bool migrateEEPROM(uint8_t oldVersion) {
 
 void bumpRebootCount() {
     StatusData st;
-    EEPROM.get(EEPROM_ADDR_STATUS, st);
+    readStatus(st);
 
     st.reboot_count += 1;
-    st.TIME = Time.now();               // optional: treat as write time
-    EEPROM.put(EEPROM_ADDR_STATUS, st);
+    writeStatus(st);                    // stamps TIME
 
     // SFDBG::pub("BOOT", String::format("reboot_count=%lu", (unsigned long)st.reboot_count), true);
 }
 
+// ====================
+// Status log
+// ====================
+// The current StatusData is kept in RAM (s_st) along with the slot and seq of
+// the record it came from.  An append writes one StatusRec to the next slot;
+// the old record stays valid until then, so a torn write loses only the
+// newest change.
+static StatusData     s_st;
+static int            s_stSlot   = -1;     // slot of the newest record, -1 if none
+static uint16_t       s_stSeq    = 0;
+static bool           s_stLoaded = false;
+static StatusLogStats s_stStats  = {};
+
+uint8_t statusRecCRC(const StatusRec &r) {
+    const uint8_t *p = (const uint8_t *)&r;
+    uint8_t crc = 0;
+    for (size_t i = 0; i < sizeof(StatusRec); i++) {
+        if (i == offsetof(StatusRec, crc8)) continue;
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool sameStatus(const StatusData &a, const StatusData &b) {
+    return a.OSTA == b.OSTA && a.NSTA == b.NSTA && a.EVLD == b.EVLD && a.NEXT == b.NEXT &&
+           a.TIME == b.TIME && a.reboot_count == b.reboot_count &&
+           strncmp(a.AEID, b.AEID, sizeof(a.AEID)) == 0;
+}
+
+// Slot of the newest valid record among the first @p slots, or -1.
+static int scanStatusLog(int slots, StatusRec &best) {
+    int slot = -1;
+    for (int i = 0; i < slots; i++) {
+        StatusRec r;
+        eepromShadow.get(EEPROM_ADDR_STATUS_LOG + i * (int)sizeof(StatusRec), r);
+        if (r.magic != STATUS_REC_MAGIC || r.crc8 != statusRecCRC(r)) continue;
+        if (slot < 0 || (int16_t)(r.seq - best.seq) > 0) {
+            best = r;
+            slot = i;
+        }
+    }
+    return slot;
+}
+
+static void statusFromRec(const StatusRec &r, StatusData &st) {
+    st = {};
+    st.OSTA         = (FlagStation)r.OSTA;
+    st.NSTA         = (FlagStation)r.NSTA;
+    st.EVLD         = r.EVLD;
+    st.NEXT         = r.NEXT;
+    st.TIME         = r.TIME;
+    st.reboot_count = r.reboot_count;
+    memcpy(st.AEID, r.AEID, sizeof(st.AEID));
+    st.AEID[sizeof(st.AEID) - 1] = '\0';
+}
+
+static void loadStatusLog() {
+    if (s_stLoaded) return;
+    s_stLoaded = true;
+
+    StatusRec best = {};
+    s_stSlot = scanStatusLog(STATUS_LOG_SLOTS, best);
+
+    if (s_stSlot < 0) {
+        s_st = {};
+        s_st.OSTA = FLAG_UNKNOWN;
+        s_st.NSTA = FLAG_UNKNOWN;
+        s_stSeq   = 0;
+        Log.warn("Status log empty or corrupt; status reset.");
+        return;
+    }
+    s_stSeq = best.seq;
+    statusFromRec(best, s_st);
+}
+
+// Write @p st as is (no TIME stamp) to the slot after the newest record.
+static void appendStatus(const StatusData &st) {
+    loadStatusLog();
+
+    StatusRec r = {};
+    r.magic        = STATUS_REC_MAGIC;
+    r.seq          = (uint16_t)(s_stSeq + 1);
+    r.NEXT         = st.NEXT;
+    r.TIME         = st.TIME;
+    r.reboot_count = st.reboot_count;
+    memcpy(r.AEID, st.AEID, sizeof(r.AEID));
+    r.OSTA         = (uint8_t)st.OSTA;
+    r.NSTA         = (uint8_t)st.NSTA;
+    r.EVLD         = st.EVLD;
+    r.crc8         = statusRecCRC(r);
+
+    int slot = (s_stSlot + 1) % STATUS_LOG_SLOTS;
+    eepromShadow.put(EEPROM_ADDR_STATUS_LOG + slot * (int)sizeof(StatusRec), r);
+    s_stSlot = slot;
+    s_stSeq  = r.seq;
+    s_st     = st;
+    s_stStats.appends++;
+}
+
+// Invalidate every record; the next append starts again at slot 0.
+static void eraseStatusLog() {
+    for (int i = 0; i < STATUS_LOG_SLOTS; i++) {
+        eepromShadow.write(EEPROM_ADDR_STATUS_LOG + i * (int)sizeof(StatusRec), 0xFF);
+    }
+    s_st       = {};
+    s_stSlot   = -1;
+    s_stSeq    = 0;
+    s_stLoaded = true;
+}
+
+void reloadStatusLog() {
+    s_stLoaded = false;
+    s_stStats  = {};
+}
+
 // ====================
 // Wrappers
 // ====================
-void readConfig(ConfigData &cfg) {
-    EEPROM.get(EEPROM_ADDR_CONFIG, cfg);
+// ---- A/B commit ----
+// Each record has two payload slots and a CommitTag per slot.  Committing
+// writes the slot that is not live, then its tag with the next seq; until
+// the tag is complete the CRC fails and the previous slot stays live.  With
+// no live slot the commit goes to B, leaving the pre-v6 block in A as the
+// fallback configData() / configExt() read.
+struct ABRecord {
+    int addr[2];            // payload slots A, B
+    int tag[2];             // their CommitTags
+};
+static const ABRecord AB_CONFIG = { { EEPROM_ADDR_CONFIG, EEPROM_ADDR_CONFIG_B },
+                                    { EEPROM_ADDR_CFG_TAGS, EEPROM_ADDR_CFG_TAGS + 8 } };
+static const ABRecord AB_CFGX   = { { EEPROM_ADDR_CFGX, EEPROM_ADDR_CFGX_B },
+                                    { EEPROM_ADDR_CFG_TAGS + 16, EEPROM_ADDR_CFG_TAGS + 24 } };
+
+struct ABState {
+    bool     scanned;
+    int      slot;          // live slot, -1 if neither is valid
+    uint32_t seq;
+};
+
+// CRC-32 (IEEE, reflected), a nibble at a time from a 64-byte table
+static uint32_t crc32Update(uint32_t crc, const uint8_t *p, size_t n) {
+    static const uint32_t T[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    for (size_t i = 0; i < n; i++) {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ T[crc & 15];
+        crc = (crc >> 4) ^ T[crc & 15];
+    }
+    return crc;
+}
 
-    bool changed = false;
-    changed |= ConfigDefaults::applyDefaults(cfg);
-    changed |= ConfigDefaults::validateAndClamp(cfg);
+static uint32_t commitCRC(uint32_t seq, const void *payload, size_t n) {
+    uint32_t crc = crc32Update(0xFFFFFFFFu, (const uint8_t *)&seq, sizeof(seq));
+    return ~crc32Update(crc, (const uint8_t *)payload, n);
+}
 
-    // Optional but recommended: write back repaired config so it persists.
-    if (changed) {
-        writeConfig(cfg);
-        Log.info("Config repaired (defaults/clamp) and written back to EEPROM.");
-        SFDBG::pub("CFG", "repaired+writeback");
+// Find the live slot of @p r and copy its payload into @p out; false (and
+// @p out untouched) if neither slot is valid.
+template <typename T>
+static bool loadAB(const ABRecord &r, ABState &st, T &out) {
+    st.scanned = true;
+    st.slot    = -1;
+    st.seq     = 0;
+    for (int i = 0; i < 2; i++) {
+        CommitTag tag;
+        T payload;
+        eepromShadow.get(r.tag[i], tag);
+        eepromShadow.get(r.addr[i], payload);
+        if (tag.crc32 != commitCRC(tag.seq, &payload, sizeof(payload))) continue;
+        if (st.slot < 0 || (int32_t)(tag.seq - st.seq) > 0) {
+            st.slot = i;
+            st.seq  = tag.seq;
+            out     = payload;
+        }
     }
+    return st.slot >= 0;
 }
 
-void writeConfig(const ConfigData &cfg) {
-    EEPROM.put(EEPROM_ADDR_CONFIG, cfg);
+template <typename T>
+static void commitAB(const ABRecord &r, ABState &st, const T &payload) {
+    if (!st.scanned) {
+        T live;
+        loadAB(r, st, live);
+    }
+    int slot = (st.slot == 1) ? 0 : 1;
+    CommitTag tag = { st.seq + 1, 0 };
+    tag.crc32 = commitCRC(tag.seq, &payload, sizeof(payload));
+
+    eepromShadow.put(r.addr[slot], payload);
+    eepromShadow.commit();              // payload reaches EEPROM before its tag
+    eepromShadow.put(r.tag[slot], tag);
+    eepromShadow.commit();
+    st.slot = slot;
+    st.seq  = tag.seq;
+}
+
+// Invalidate both tags; the next commit goes to slot B.
+static void eraseAB(const ABRecord &r, ABState &st) {
+    const CommitTag blank = { 0xFFFFFFFFu, 0xFFFFFFFFu };
+    eepromShadow.put(r.tag[0], blank);
+    eepromShadow.put(r.tag[1], blank);
+    st = { true, -1, 0 };
+}
+
+// ---- Config cache ----
+// ConfigData / ConfigExt are read on every heartbeat and config query, so
+// they are kept in RAM.  The first read after reset loads the live slot; every
+// write goes through writeConfig() / writeConfigExt(), which commit, update
+// the copy and bump the generation, so the cache never needs re-reading.
+static ConfigData s_cfg;
+static ConfigExt  s_cfgx;
+static ABState    s_cfgAB      = {};
+static ABState    s_cfgxAB     = {};
+static bool       s_cfgLoaded  = false;
+static bool       s_cfgxLoaded = false;
+static uint32_t   s_cfgGen     = 0;
+
+static void eraseConfigSlots(bool withExt) {
+    eraseAB(AB_CONFIG, s_cfgAB);
+    if (withExt) eraseAB(AB_CFGX, s_cfgxAB);
+}
+
+const ConfigData &configData() {
+    if (!s_cfgLoaded) {
+        s_cfgLoaded = true;
+        if (!loadAB(AB_CONFIG, s_cfgAB, s_cfg)) {
+            // No committed slot (pre-v6 image, or torn past both): repair from block A
+            eepromShadow.get(EEPROM_ADDR_CONFIG, s_cfg);
+            writeConfig(s_cfg);
+            Log.info("Config had no valid slot; repaired (defaults/clamp) and committed.");
+            SFDBG::pub("CFG", "repaired+writeback");
+        }
+    }
+    return s_cfg;
+}
+
+const ConfigExt &configExt() {
+    if (!s_cfgxLoaded) {
+        s_cfgxLoaded = true;
+        if (!loadAB(AB_CFGX, s_cfgxAB, s_cfgx)) {
+            eepromShadow.get(EEPROM_ADDR_CFGX, s_cfgx);   // validateOrInitConfigExt() checks it
+        }
+    }
+    return s_cfgx;
+}
+
+uint32_t configGeneration() {
+    return s_cfgGen;
+}
+
+void reloadConfigCache() {
+    s_cfgLoaded = s_cfgxLoaded = false;
+    s_cfgAB  = {};
+    s_cfgxAB = {};
+    s_cfgGen++;
+}
+
+void readConfig(ConfigData &cfg) {
+    cfg = configData();
+}
+
+void writeConfig(const ConfigData &cfgIn) {
+    ConfigData cfg = cfgIn;
+    ConfigDefaults::applyDefaults(cfg);
+    ConfigDefaults::validateAndClamp(cfg);
+
+    commitAB(AB_CONFIG, s_cfgAB, cfg);
+    s_cfg       = cfg;
+    s_cfgLoaded = true;
+    s_cfgGen++;
 }
 
 static const char* moveStatusToCode(FlagMoveStatus status) {
@@ -216,16 +619,27 @@ void initConfigExt() {
     x.stall_limit_ma = 1800;     // default 1800 mA
     x.move_timeout_sec = 120;    // default 120 sec
 
-    EEPROM.put(EEPROM_ADDR_CFGX, x);
+    writeConfigExt(x);
     SFDBG::pub("CFGX", "init defaults", true);
 }
 
 void readConfigExt(ConfigExt &x) {
-    EEPROM.get(EEPROM_ADDR_CFGX, x);
+    x = configExt();
 }
 
 void writeConfigExt(const ConfigExt &x) {
-    EEPROM.put(EEPROM_ADDR_CFGX, x);
+    commitAB(AB_CFGX, s_cfgxAB, x);
+    s_cfgx       = x;
+    s_cfgxLoaded = true;
+    s_cfgGen++;
+}
+
+void readSunTable(SunTable &t) {
+    eepromShadow.get(EEPROM_ADDR_SUNTAB, t);
+}
+
+void writeSunTable(const SunTable &t) {
+    eepromShadow.put(EEPROM_ADDR_SUNTAB, t);
 }
 
 static bool clampConfigExt(ConfigExt &x) {
@@ -268,58 +682,285 @@ bool validateOrInitConfigExt() {
 }
 
 void readStatus(StatusData &status) {
-    EEPROM.get(EEPROM_ADDR_STATUS, status);
+    loadStatusLog();
+    status = s_st;
 }
 
 void writeStatus(const StatusData &statusIn) {
+    loadStatusLog();
+    s_stStats.writes++;
 
     StatusData status = statusIn;
+    status.TIME = s_st.TIME;
+    if (sameStatus(status, s_st)) return;      // e.g. saveOSTA() of the same station
+
     status.TIME = Time.now();
-    EEPROM.put(EEPROM_ADDR_STATUS, status);
+    appendStatus(status);
+}
+
+StatusLogStats statusLogStats() {
+    return s_stStats;
 }
 
 void readEventHeader(EventHeader &hdr) {
-    EEPROM.get(EEPROM_ADDR_EVENT_HDR, hdr);
+    eepromShadow.get(EEPROM_ADDR_EVENT_HDR, hdr);
 }
 
 void writeEventHeader(const EventHeader &hdr) {
-    EEPROM.put(EEPROM_ADDR_EVENT_HDR, hdr);
+    eepromShadow.put(EEPROM_ADDR_EVENT_HDR, hdr);
 }
 
-bool readEvent(uint8_t index, FlagEvent &evt) {
-    EventHeader hdr;
-    readEventHeader(hdr);
-    if (index >= hdr.eventCount) return false;
+// CRC-8 (poly 0x07) over every byte of the record except crc8 itself
+uint8_t eventCRC(const FlagEvent &evt) {
+    const uint8_t *p = (const uint8_t *)&evt;
+    const size_t skip = offsetof(FlagEvent, crc8);
+    uint8_t crc = 0;
+    for (size_t i = 0; i < sizeof(FlagEvent); i++) {
+        if (i == skip) continue;
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// The TimeMark sits at an odd offset inside the record, so it is copied
+// rather than cast; unused bytes stay zero so unchanged marks compare equal.
+void packEventMark(char (&field)[20], const TimeMark &m) {
+    static_assert(1 + sizeof(TimeMark) <= sizeof(field), "TimeMark does not fit a mark field");
+    memset(field, 0, sizeof(field));
+    field[0] = EVM_COMPILED;
+    memcpy(field + 1, &m, sizeof(TimeMark));
+}
+
+bool unpackEventMark(const char (&field)[20], TimeMark &m) {
+    if ((uint8_t)field[0] != EVM_COMPILED) return false;
+    memcpy(&m, field + 1, sizeof(TimeMark));
+    return true;
+}
+
+bool readEventSlot(uint8_t index, FlagEvent &evt) {
+    if (index >= maxEventsInEEPROM()) return false;
 
     int addr = EEPROM_ADDR_EVENT_LIST + index * sizeof(FlagEvent);
-    EEPROM.get(addr, evt);
+    eepromShadow.get(addr, evt);
+    return true;
+}
+
+// ---- v4 packed event region ----
+
+void readEventStrings(EventStrings &t) {
+    eepromShadow.get(EEPROM_ADDR_EVENT_LIST, t);
+}
+
+int writeEventStrings(const EventStrings &t) {
+    EventStrings stored;
+    readEventStrings(stored);
+    int bytes = 0;
+    for (int i = 0; i < EVS_STR_N; i++) {
+        if (memcmp(stored.s[i], t.s[i], EVS_STR_LEN) == 0) continue;
+        eepromShadow.put(EEPROM_ADDR_EVENT_LIST + i * EVS_STR_LEN, t.s[i]);
+        bytes += EVS_STR_LEN;
+    }
+    return bytes;
+}
+
+static int findEventString(const EventStrings &t, const char *s) {
+    if (s[0] == '\0') return 0;
+    for (int i = 1; i < EVS_STR_N; i++) {
+        if (strncmp(t.s[i], s, EVS_STR_LEN - 1) == 0 && t.s[i][0] != '\0') return i;
+    }
+    return -1;
+}
+
+void layoutEventStrings(EventStrings &t, const char *const *strs, int n, int *idx, uint32_t pinned) {
+    bool used[EVS_STR_N] = { true };
+    for (int i = 1; i < EVS_STR_N; i++) used[i] = (pinned >> i) & 1;
+    for (int i = 0; i < n; i++) {
+        idx[i] = findEventString(t, strs[i]);
+        if (idx[i] >= 0) used[idx[i]] = true;
+    }
+    for (int i = 1; i < EVS_STR_N; i++) {
+        if (!used[i]) memset(t.s[i], 0, EVS_STR_LEN);
+    }
+    memset(t.s[0], 0, EVS_STR_LEN);
+
+    for (int i = 0; i < n; i++) {
+        if (idx[i] >= 0) continue;
+        idx[i] = findEventString(t, strs[i]);       // placed for an earlier string
+        for (int k = 1; k < EVS_STR_N && idx[i] < 0; k++) {
+            if (used[k]) continue;
+            strncpy(t.s[k], strs[i], EVS_STR_LEN - 1);
+            used[k] = true;
+            idx[i]  = k;
+        }
+    }
+}
+
+bool packMark(PackedMark &p, const TimeMark &m) {
+    p = {};
+    if (m.kind > 7 || m.minutes < 0 || m.minutes > 0x1FFF) return false;
+    if (m.year != 0 || m.month != 0 || m.day != 0) {
+        if (m.year < 2000 || m.year > 2127 || m.month > 15 || m.day > 31) return false;
+        p.date = (uint16_t)((m.year - 2000) << 9 | m.month << 5 | m.day);
+        if (p.date == 0) return false;              // 2000-00-00 reads back as no date
+    }
+    p.kindMin = (uint16_t)(m.kind << 13 | m.minutes);
+    return true;
+}
+
+TimeMark unpackMark(const PackedMark &p) {
+    TimeMark m = {};
+    if (p.date != 0) {
+        m.year  = (uint16_t)(2000 + (p.date >> 9));
+        m.month = (uint8_t)((p.date >> 5) & 0x0F);
+        m.day   = (uint8_t)(p.date & 0x1F);
+    }
+    m.kind    = (uint8_t)(p.kindMin >> 13);
+    m.minutes = (int16_t)(p.kindMin & 0x1FFF);
+    return m;
+}
+
+bool packEvent(PackedEvent &e, int32_t id, int32_t ver, const TimeMark &bmk, const TimeMark &emk,
+               uint8_t jur, uint8_t flg, const uint16_t *sjr, int nSjr) {
+    memset(&e, 0, sizeof(e));
+    if (id <= 0 || ver < 0 || ver > 0xFFFF || jur >= EVS_STR_N || flg >= EVS_STR_N) return false;
+    if (!packMark(e.bmk, bmk) || !packMark(e.emk, emk)) return false;
+
+    nSjr = min(max(nSjr, 0), 7);
+    e.len  = (uint8_t)(PACKED_EVENT_BASE + 2 * nSjr);
+    e.jur  = jur;
+    e.flg  = flg;
+    e.idLo = (uint16_t)((uint32_t)id & 0xFFFF);
+    e.idHi = (uint16_t)((uint32_t)id >> 16);
+    e.ver  = (uint16_t)ver;
+    for (int j = 0; j < nSjr; j++) e.sjrList[j] = sjr[j];
+    return true;
+}
+
+// CRC-8 (poly 0x07) over the record's len bytes except crc8 itself
+uint8_t packedCRC(const PackedEvent &e) {
+    const uint8_t *p = (const uint8_t *)&e;
+    uint8_t crc = 0;
+    for (int i = 0; i < e.len && i < (int)sizeof(e); i++) {
+        if (i == (int)offsetof(PackedEvent, crc8)) continue;
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool plausibleLen(int offset, uint8_t len) {
+    return len >= PACKED_EVENT_BASE && len <= sizeof(PackedEvent) && (len & 1) == 0 &&
+           offset >= 0 && offset + len <= EVENT_RECS_BYTES;
+}
+
+bool readPackedEvent(int offset, PackedEvent &e) {
+    memset(&e, 0, sizeof(e));
+    uint8_t *p = (uint8_t *)&e;
+    p[0] = eepromShadow.read(EEPROM_ADDR_EVENT_RECS + offset);
+    if (!plausibleLen(offset, e.len)) return false;
+    for (int i = 1; i < e.len; i++) p[i] = eepromShadow.read(EEPROM_ADDR_EVENT_RECS + offset + i);
     return true;
 }
 
-bool writeEvent(uint8_t index, const FlagEvent &evt) {
+bool writePackedEvent(int offset, const PackedEvent &e) {
+    if (!plausibleLen(offset, e.len)) return false;
+
+    PackedEvent sealed = e;
+    sealed.crc8 = packedCRC(sealed);
+
+    const uint8_t *p = (const uint8_t *)&sealed;
+    int addr = EEPROM_ADDR_EVENT_RECS + offset;
+    bool same = true;
+    for (int i = 0; i < sealed.len && same; i++) same = eepromShadow.read(addr + i) == p[i];
+    if (same) return false;                                                // unchanged
+
+    for (int i = 0; i < sealed.len; i++) eepromShadow.write(addr + i, p[i]);
+    return true;
+}
+
+uint32_t eventStringRefs() {
+    eepromShadow.commit();
+
     EventHeader hdr;
     readEventHeader(hdr);
-    if (index >= hdr.eventCount) return false;
+    uint32_t refs = 0;
+    PackedEvent e;
+    int offset = 0;
+    for (int n = 0; n < hdr.eventCount && readPackedEvent(offset, e); n++) {
+        offset += e.len;
+        if (e.crc8 != packedCRC(e) || e.jur >= EVS_STR_N || e.flg >= EVS_STR_N) continue;
+        refs |= (1u << e.jur) | (1u << e.flg);
+    }
+    return refs & ~1u;                  // entry 0 is always ""
+}
 
-    int addr = EEPROM_ADDR_EVENT_LIST + index * sizeof(FlagEvent);
-    EEPROM.put(addr, evt);
-    return true;
+int readEventTable(EventHeader &hdr, EventStrings &t, PackedEvent *recs, int max) {
+    readEventHeader(hdr);
+    readEventStrings(t);
+
+    int n = (hdr.eventCount < max) ? hdr.eventCount : max;
+    int got = 0, offset = 0;
+    while (got < n && readPackedEvent(offset, recs[got])) {
+        offset += recs[got].len;
+        got++;
+    }
+    return got;
+}
+
+EventTableWrite writeEventTable(const EventStrings &t, const PackedEvent *recs, int n) {
+    EventTableWrite w = {};
+    int offset = 0;
+    while (w.stored < n && plausibleLen(offset, recs[w.stored].len)) {
+        offset += recs[w.stored].len;
+        w.stored++;
+    }
+
+    EventHeader stored;
+    readEventHeader(stored);
+    EventHeader hdr = {};
+    hdr.eventCount = (uint8_t)w.stored;
+    hdr.flags      = EVH_FLAG_CRC;
+    bool newHdr    = stored.eventCount != hdr.eventCount || stored.flags != hdr.flags;
+    bool shrinking = hdr.eventCount < stored.eventCount;
+
+    if (newHdr && shrinking) {
+        writeEventHeader(hdr);
+        eepromShadow.commit();
+    }
+
+    w.bytesWritten += writeEventStrings(t);
+    offset = 0;
+    for (int i = 0; i < w.stored; i++) {
+        if (writePackedEvent(offset, recs[i])) {
+            w.recsWritten++;
+            w.bytesWritten += recs[i].len;
+        }
+        offset += recs[i].len;
+    }
+
+    if (newHdr && !shrinking) {
+        eepromShadow.commit();
+        writeEventHeader(hdr);
+    }
+    if (newHdr) w.bytesWritten += sizeof(EventHeader);
+    return w;
 }
 
 // ====================
 // JSON Helpers
 // ====================
 String configToJSON() {
-    ConfigData cfg;
-    readConfig(cfg);
-
-    ConfigExt x;
-    readConfigExt(x);
+    const ConfigData &cfg = configData();
+    const ConfigExt  &x   = configExt();      // follows initConfigExt() below
 
     // Ensure CFGX is initialized (safe, cheap)
     if (x.magic != CFGX_MAGIC || x.version != CFGX_VERSION) {
         initConfigExt();
-        readConfigExt(x);
     }
 
     char buffer[256];
@@ -344,6 +985,18 @@ String configToJSON() {
     writer.name("SLM").value((int)x.stall_limit_ma);      // Stall Limit (mA)
     writer.name("TMO").value((int)x.move_timeout_sec);    // Timeout (sec)
 
+    char tzr[TzRules::MAX_LEN + 1];
+    TzRules::format((x.flags & CFGX_FLAG_TZRULE) ? x.tzRule : TzRules::northAmerica(), tzr, sizeof(tzr));
+    writer.name("TZR").value(tzr);                        // DST rule
+
+    writer.name("SUB").beginArray();                      // extra jurisdiction topics
+    for (int i = 0; i < 2 && (x.flags & CFGX_FLAG_SUB); i++) {
+        char t[sizeof(x.subTopics[i]) + 1] = {0};
+        memcpy(t, x.subTopics[i], sizeof(x.subTopics[i]));
+        if (t[0]) writer.value(t);
+    }
+    writer.endArray();
+
     writer.endObject();
 
     // Lock down output length (prevents buffer tail artifacts)
@@ -463,19 +1116,15 @@ void saveNSTA (FlagStation nsta) {
 }
 
 time_t parseUTC(const String& utcString) {
-    
-    struct tm t = {0};
+
+    int y, mon, d, h, mi, s;
     if (sscanf(utcString.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d",
-       &t.tm_year, &t.tm_mon, &t.tm_mday,
-       &t.tm_hour, &t.tm_min, &t.tm_sec) !=6) {
+       &y, &mon, &d, &h, &mi, &s) != 6) {
         return 0; // Invalid format
     }
 
-    t.tm_year -= 1900;
-    t.tm_mon -= 1;
-
-    time_t localTime = mktime(&t);  // Interprets the tm structure as local time
-    return localTime;               // Convert to time_t in UTC
+    // Pure arithmetic: no dependence on the C library's TZ state
+    return CivilDate::toEpoch(y, mon, d, h, mi, s);
 }
 
 
@@ -485,6 +1134,7 @@ time_t parseUTC(const String& utcString) {
 int setConfigHandler(String data) {
     if (jsonToConfig(data)) {
         halMgr1.applyConfigExtToRuntime();
+        scheduleStatusReport();      // status_period_sec may have changed
         return 1;
     }
     return -1;
@@ -4,24 +4,49 @@
 #include "Particle.h"
 #include "HalyardManager.h"
 #include "FlagUtils.h"
+#include "TimeMark.h"
+#include "TzRule.h"
 
 // ====================
 // Constants
 // ====================
 #define EEPROM_MAGIC    0x4733  // 'G3'
-#define EEPROM_VERSION  3
+#define EEPROM_VERSION  6
 #define EEPROM_TOTAL_BYTES 2047
 
 #define CFGX_MAGIC   0xC0DE
 #define CFGX_VERSION 2
+#define CFGX_FLAG_TZRULE 0x01   // ConfigExt.tzRule is set (else North American rules)
+#define CFGX_FLAG_SUB    0x02   // ConfigExt.subTopics holds extra jurisdiction topics
 #define EEPROM_ADDR_CFGX (EEPROM_TOTAL_BYTES - 64)   // 1983
 
 // EEPROM layout offsets
 #define EEPROM_ADDR_HEADER     0
 #define EEPROM_ADDR_CONFIG     16
-#define EEPROM_ADDR_STATUS     80
+#define EEPROM_ADDR_STATUS     80       // v4 and earlier; v5 keeps StatusData in the status log
 #define EEPROM_ADDR_EVENT_HDR  144
 #define EEPROM_ADDR_EVENT_LIST 152
+#define EEPROM_ADDR_EVENT_RECS 536      // v4: packed records after the EventStrings table
+
+// Annual sun table lives above the 2 KB working image (device EEPROM is 4 KB)
+#define SUNTAB_MAGIC   0x5354   // 'ST'
+#define SUNTAB_VERSION 1
+#define SUNTAB_DAYS    366
+#define SUNTAB_NONE    0xFFFF   // no usable sun event that day (polar / out of range)
+#define EEPROM_ADDR_SUNTAB 2048
+#define EEPROM_DEVICE_BYTES 4096
+
+// v5: StatusData as an append-only ring of StatusRec records above the sun table
+#define STATUS_REC_MAGIC      0x53     // 'S'
+#define STATUS_LOG_SLOTS      12       // 16 in v5
+#define EEPROM_ADDR_STATUS_LOG 3584
+
+// v6: ConfigData and ConfigExt each have two slots, A (the original block) and
+// B.  A commit writes the idle slot, then its CommitTag; the newest slot whose
+// tag CRC matches is the live one, so a reset mid-commit keeps the previous.
+#define EEPROM_ADDR_CFG_TAGS   80       // CommitTag[4]: CONFIG A, B, CFGX A, B (v4 status block)
+#define EEPROM_ADDR_CONFIG_B   3968
+#define EEPROM_ADDR_CFGX_B     4032
 
 // ====================
 // Data Structures
@@ -57,6 +82,12 @@ struct ConfigData {
 };
 static_assert(sizeof(ConfigData) == 64, "ConfigData must be 64 bytes");
 
+struct CommitTag {
+    uint32_t seq;            // commit count for this record (wraps)
+    uint32_t crc32;          // CRC-32 of seq followed by the slot's payload
+};
+static_assert(sizeof(CommitTag) == 8, "CommitTag must be 8 bytes");
+
 // --- StatusData ---
 #define STATUSDATA_SIZE 64
 struct StatusData {
@@ -76,31 +107,103 @@ struct StatusData {
 };
 static_assert(sizeof(StatusData) == 64, "StatusData must be 64 bytes");
 
+// One status log record: the StatusData fields in use.  The newest valid
+// record (highest seq, serial-number order) is the current status; each write
+// goes to the slot after it, so the slots wear evenly.
+struct StatusRec {
+    uint8_t  magic;          // STATUS_REC_MAGIC
+    uint8_t  crc8;           // statusRecCRC() of this record
+    uint16_t seq;            // append count (wraps)
+    uint32_t NEXT;
+    uint32_t TIME;
+    uint32_t reboot_count;
+    char     AEID[12];
+    uint8_t  OSTA;           // FlagStation
+    uint8_t  NSTA;           // FlagStation
+    uint8_t  EVLD;
+    uint8_t  pad;
+};
+static_assert(sizeof(StatusRec) == 32, "StatusRec must be 32 bytes");
+
 // --- Events ---
+#define EVH_FLAG_CRC 0x01   // EventHeader.flags: every record carries a crc8
+
 struct EventHeader {
-    uint8_t eventCount;
-    uint8_t reserved[7];
+    uint8_t eventCount;      // v4: packed records stored
+    uint8_t flags;           // EVH_FLAG_* (0 on v3 images written before slot CRCs)
+    uint8_t reserved[6];
 };
 static_assert(sizeof(EventHeader) == 8, "EventHeader must be 8 bytes");
 
+// v4 event region (EEPROM_ADDR_EVENT_LIST .. EEPROM_ADDR_CFGX):
+//   EventStrings   JUR / FLG text, referenced by index from each record
+//   PackedEvent... back to back from EEPROM_ADDR_EVENT_RECS, eventCount of them
+// A record stores only PACKED_EVENT_BASE bytes plus 2 per SJR entry.  The
+// table is also EventManager's intern table size, so every string it accepts
+// can be stored.
+#define EVS_STR_N   32      // entry 0 is always ""
+#define EVS_STR_LEN 12      // bytes per entry, NUL-padded (EventManager STR_MAX)
+
+struct EventStrings {
+    char s[EVS_STR_N][EVS_STR_LEN];
+};
+static_assert(sizeof(EventStrings) == 384, "EventStrings must be 384 bytes");
+static_assert(EVS_STR_N <= 32, "eventStringRefs() keeps one bit per entry");
+
+// TimeMark in 4 bytes.  date = (year - 2000) << 9 | month << 5 | day, or 0 for
+// a mark with no date (TBD); kindMin = kind << 13 | minutes.
+struct PackedMark {
+    uint16_t date;
+    uint16_t kindMin;
+};
+
+struct PackedEvent {
+    uint8_t    len;          // bytes in this record: PACKED_EVENT_BASE + 2 * SJR count
+    uint8_t    crc8;         // packedCRC() of this record
+    uint8_t    jur;          // EventStrings index
+    uint8_t    flg;          // EventStrings index
+    uint16_t   idLo;         // event ID
+    uint16_t   idHi;
+    uint16_t   ver;          // event version
+    PackedMark bmk;
+    PackedMark emk;
+    uint16_t   sjrList[7];   // only the first (len - PACKED_EVENT_BASE) / 2 are stored
+};
+#define PACKED_EVENT_BASE   ((int)offsetof(PackedEvent, sjrList))
+#define EVENT_RECS_BYTES    (EEPROM_ADDR_CFGX - EEPROM_ADDR_EVENT_RECS)
+static_assert(PACKED_EVENT_BASE == 18, "PackedEvent header must be 18 bytes");
+
+// --- v3 FlagEvent slots (read only by the v3 -> v4 migration) ---
+
+// FlagEvent.bmk / .emk hold either a mark string (older images) or, when the
+// first byte is EVM_COMPILED, a TimeMark in the following bytes.  A mark
+// string never starts with a control character, so the two cannot collide.
+#define EVM_COMPILED 0x01
+
 struct FlagEvent {
     char     idv[12];        // Event IDV
     char     flg[3];         // Flag abbreviation
-    char     bmk[20];        // Begin mark
-    char     emk[20];        // End mark
+    char     bmk[20];        // Begin mark (EVM_COMPILED + TimeMark, or string)
+    char     emk[20];        // End mark   (same)
     uint8_t  deleted;        // DEL flag
     char     jur[8];         // Jurisdiction string (e.g. "FE-US")
     uint8_t  sjrCount;       // Number of valid sjrList entries (0..7)
-    uint8_t  reserved2;      // alignment pad
+    uint8_t  crc8;           // eventCRC() of this record (was alignment pad)
     uint16_t sjrList[7];     // Sub-jurisdiction IDs (uint16_t; max 7 entries)
 };
 static_assert(sizeof(FlagEvent) == 80, "FlagEvent must be 80 bytes");
 
+// v3 firmware kept at most 20 events; the region holds four times as many
+// records without SJR entries (1447 / 18 = 80).
+#define EVENT_V3_MAX 20
+static_assert(EVENT_RECS_BYTES / PACKED_EVENT_BASE >= 4 * EVENT_V3_MAX,
+              "v4 event region must hold 4x the v3 event table");
+
 // --- ConfigExt (CFGX) ---
 struct ConfigExt {
     uint16_t magic;            // CFGX_MAGIC
     uint8_t  version;          // CFGX_VERSION
-    uint8_t  flags;            // future use
+    uint8_t  flags;            // CFGX_FLAG_*
 
     uint16_t stall_limit_ma;   // current-based stall threshold (mA). default 1800
     uint16_t move_timeout_sec; // timeout-based stall threshold (sec). default 120
@@ -109,10 +212,29 @@ struct ConfigExt {
     uint8_t  sjrPad;           // alignment padding
     uint16_t sjrList[5];       // unit's configured sub-jurisdiction IDs (up to 5)
 
-    uint8_t reserved[44];      // pad to 64 bytes
+    TzRule   tzRule;           // DST rule for local-time marks (CFGX_FLAG_TZRULE)
+
+    char     subTopics[2][10]; // extra jurisdiction topics beyond FED/STA (CFGX_FLAG_SUB)  // JSON: SUB
+
+    uint8_t reserved[10];      // pad to 64 bytes
 };
 static_assert(sizeof(ConfigExt) == 64, "ConfigExt must be 64 bytes");
 
+// --- SunTable ---
+// UTCSunEvent() for every tm_yday at one site, stored as unsigned offsets from
+// a per-kind base so each day fits 16 bits at full one-second resolution.
+// Index [0] = sunset, [1] = sunrise (same rs convention as UTCSunEvent()).
+struct SunTable {
+    uint16_t magic;            // SUNTAB_MAGIC
+    uint8_t  version;          // SUNTAB_VERSION
+    uint8_t  flags;            // future use
+    float    LAT;              // site the table was computed for (ConfigData.LAT)
+    float    LNG;              //                                 (ConfigData.LNG)
+    int32_t  base[2];          // seconds past 00:00 UTC subtracted from each entry
+    uint16_t sec[2][SUNTAB_DAYS];  // seconds - base, or SUNTAB_NONE
+};
+static_assert(sizeof(SunTable) == 20 + 4 * SUNTAB_DAYS, "SunTable layout changed");
+
 // ====================
 // Compile-time EEPROM layout checks
 
@@ -128,6 +250,27 @@ static_assert(EEPROM_ADDR_STATUS + sizeof(StatusData) <= EEPROM_ADDR_EVENT_HDR,
 static_assert(EEPROM_ADDR_EVENT_HDR + sizeof(EventHeader) <= EEPROM_ADDR_EVENT_LIST,
               "EEPROM overlap: EVENT_HDR spills into EVENT_LIST");
 
+static_assert(EEPROM_ADDR_EVENT_LIST + sizeof(EventStrings) <= EEPROM_ADDR_EVENT_RECS,
+              "EEPROM overlap: EventStrings spills into EVENT_RECS");
+
+static_assert(EEPROM_ADDR_CFGX + sizeof(ConfigExt) <= EEPROM_ADDR_SUNTAB,
+              "EEPROM overlap: CFGX spills into SUNTAB");
+
+static_assert(EEPROM_ADDR_SUNTAB + sizeof(SunTable) <= EEPROM_ADDR_STATUS_LOG,
+              "EEPROM overlap: SUNTAB spills into STATUS_LOG");
+
+static_assert(EEPROM_ADDR_STATUS_LOG + STATUS_LOG_SLOTS * sizeof(StatusRec) <= EEPROM_ADDR_CONFIG_B,
+              "EEPROM overlap: STATUS_LOG spills into CONFIG_B");
+
+static_assert(EEPROM_ADDR_CFG_TAGS + 4 * sizeof(CommitTag) <= EEPROM_ADDR_EVENT_HDR,
+              "EEPROM overlap: CFG_TAGS spills into EVENT_HDR");
+
+static_assert(EEPROM_ADDR_CONFIG_B + sizeof(ConfigData) <= EEPROM_ADDR_CFGX_B,
+              "EEPROM overlap: CONFIG_B spills into CFGX_B");
+
+static_assert(EEPROM_ADDR_CFGX_B + sizeof(ConfigExt) <= EEPROM_DEVICE_BYTES,
+              "EEPROM overflow: CFGX_B exceeds device EEPROM");
+
 // ====================
 // Core Functions
 // ====================
@@ -139,20 +282,93 @@ void initConfigExt();
 bool validateOrInitConfigExt();
 void readConfigExt(ConfigExt &x);
 void writeConfigExt(const ConfigExt &x);
+void readSunTable(SunTable &t);
+void writeSunTable(const SunTable &t);
 // ====================
 // Wrapper Functions
 // ====================
 void readConfig(ConfigData &cfg);
 void writeConfig(const ConfigData &cfg);
 
+// RAM copies of ConfigData / ConfigExt, loaded from the live A/B slot on first
+// use after reset and updated by writeConfig() / writeConfigExt(), which
+// commit to the other slot; readConfig() / readConfigExt() copy from them.
+// ConfigData is defaulted and clamped when committed, so a slot that passes
+// its CRC needs no repair.  configGeneration() changes on every write.
+const ConfigData &configData();
+const ConfigExt  &configExt();
+uint32_t configGeneration();
+// Forget the RAM copies so the next read loads EEPROM again (as after reset).
+void reloadConfigCache();
+
+// StatusData lives in RAM, loaded from the newest status log record on first
+// use after reset.  writeStatus() stamps TIME and appends a record, unless no
+// field other than TIME changed, in which case nothing is written.
 void readStatus(StatusData &status);
 void writeStatus(const StatusData &status);
+uint8_t statusRecCRC(const StatusRec &r);
+// Forget the RAM copy so the next read scans the log again (as after reset).
+void reloadStatusLog();
+
+struct StatusLogStats {
+    uint32_t writes;         // writeStatus() calls since reset
+    uint32_t appends;        // records written
+};
+StatusLogStats statusLogStats();
 
 void readEventHeader(EventHeader &hdr);
 void writeEventHeader(const EventHeader &hdr);
 
-bool readEvent(uint8_t index, FlagEvent &evt);
-bool writeEvent(uint8_t index, const FlagEvent &evt);
+// v4 packed event region.  Offsets are bytes from EEPROM_ADDR_EVENT_RECS.
+void readEventStrings(EventStrings &t);
+// Rewrites only the entries that differ; returns the bytes written.
+int  writeEventStrings(const EventStrings &t);
+// Give each of @p strs[0..n-1] an index in @p t: strings already present keep
+// theirs, the rest take entries no listed string uses and @p pinned (bit per
+// entry) does not hold.  @p idx[i] is -1 when the table is full.
+void layoutEventStrings(EventStrings &t, const char *const *strs, int n, int *idx, uint32_t pinned = 0);
+// Entries the records on EEPROM reference (bit per entry).  Commits the
+// shadow first, so these are the records a reset would leave.  Pinning them
+// in layoutEventStrings() keeps a torn flush (strings written, records not)
+// from pairing an old record with another string.
+uint32_t eventStringRefs();
+
+// Mark packing; packMark() returns false when @p m has no 4-byte form.
+bool     packMark(PackedMark &p, const TimeMark &m);
+TimeMark unpackMark(const PackedMark &p);
+// Fill @p e (len included); false if a field does not fit the packed form.
+bool     packEvent(PackedEvent &e, int32_t id, int32_t ver, const TimeMark &bmk, const TimeMark &emk,
+                   uint8_t jur, uint8_t flg, const uint16_t *sjr, int nSjr);
+uint8_t  packedCRC(const PackedEvent &e);
+// False if the length byte at @p offset is implausible or runs past the region.
+bool readPackedEvent(int offset, PackedEvent &e);
+// Stamps crc8 and writes only when the stored bytes differ; true if written.
+bool writePackedEvent(int offset, const PackedEvent &e);
+
+// The whole v4 event table in one pass.  readEventTable() reads the header
+// once and returns the records it could locate, at most @p max and never more
+// than eventCount (crc8 is left to the caller: see packedCRC()).
+int readEventTable(EventHeader &hdr, EventStrings &t, PackedEvent *recs, int max);
+
+struct EventTableWrite {
+    int stored;          // records that fit the region (recs[0..stored-1])
+    int recsWritten;     // records physically rewritten
+    int bytesWritten;    // strings, records and header bytes rewritten
+};
+// Write @p t, recs[0..n-1] back to back and a header with the stored count.
+// A count that shrinks reaches EEPROM before the records and one that grows
+// after them, so it never covers records from a different table.  @p t must
+// keep the eventStringRefs() entries (see layoutEventStrings()).
+EventTableWrite writeEventTable(const EventStrings &t, const PackedEvent *recs, int n);
+
+// v3 slots, bounded by the v3 EEPROM capacity.
+uint8_t eventCRC(const FlagEvent &evt);
+
+// Compiled BMK / EMK fields.  unpackEventMark() returns false for a legacy
+// mark string, which the caller compiles with TimeMarks::compile().
+void packEventMark(char (&field)[20], const TimeMark &m);
+bool unpackEventMark(const char (&field)[20], TimeMark &m);
+bool readEventSlot(uint8_t index, FlagEvent &evt);
 
 // ====================
 // JSON Helpers
@@ -162,6 +378,9 @@ bool jsonToConfig(const String &jsonStr);
 
 void saveOSTA (FlagStation osta);
 
+// "YYYY-MM-DDTHH:MM:SS" (UTC) to epoch; 0 if malformed
+time_t parseUTC(const String& utcString);
+
 bool jsonToStatus(const String &jsonStr);
 
 // ====================
@@ -0,0 +1,79 @@
+#include "EEPROMShadow.h"
+#include "Particle.h"
+
+#include <string.h>
+
+EEPROMShadow eepromShadow;
+
+void EEPROMShadow::begin() {
+    _loaded = false;
+    load();
+}
+
+void EEPROMShadow::load() {
+    if ( _loaded ) return;
+    HAL_EEPROM_Get( 0, _img, BYTES );
+    memset( _dirty, 0, sizeof(_dirty) );
+    _lo     = BYTES;
+    _hi     = -1;
+    _loaded = true;
+}
+
+uint8_t EEPROMShadow::read( int addr ) {
+    uint8_t v;
+    getBytes( addr, &v, 1 );
+    return v;
+}
+
+void EEPROMShadow::write( int addr, uint8_t value ) {
+    putBytes( addr, &value, 1 );
+}
+
+void EEPROMShadow::getBytes( int addr, uint8_t *dst, size_t n ) {
+    load();
+    size_t inImg = ( addr < BYTES ) ? ( (size_t)( BYTES - addr ) < n ? (size_t)( BYTES - addr ) : n ) : 0;
+    if ( inImg ) memcpy( dst, &_img[addr], inImg );
+    if ( inImg < n ) HAL_EEPROM_Get( (uint32_t)( addr + inImg ), dst + inImg, n - inImg );
+}
+
+void EEPROMShadow::putBytes( int addr, const uint8_t *src, size_t n ) {
+    load();
+    _stats.logicalWrites++;
+    _stats.logicalBytes += (uint32_t)n;
+
+    size_t inImg = ( addr < BYTES ) ? ( (size_t)( BYTES - addr ) < n ? (size_t)( BYTES - addr ) : n ) : 0;
+    for ( size_t k = 0; k < inImg; k++ ) {
+        int i = addr + (int)k;
+        if ( _img[i] == src[k] ) continue;
+        _img[i] = src[k];
+        _dirty[i >> 3] |= (uint8_t)( 1u << ( i & 7 ) );
+        if ( i < _lo ) _lo = i;
+        if ( i > _hi ) _hi = i;
+    }
+    if ( inImg < n ) {
+        HAL_EEPROM_Put( (uint32_t)( addr + inImg ), src + inImg, n - inImg );
+        _stats.physicalWrites++;
+        _stats.physicalBytes += (uint32_t)( n - inImg );
+    }
+}
+
+int EEPROMShadow::commit() {
+    int spans = 0;
+    int i = _lo;
+    while ( i <= _hi ) {
+        if ( !isDirty( i ) ) { i++; continue; }
+        int start = i, end = i;          // end: last dirty byte of the span
+        for ( int j = i + 1; j <= _hi && j <= end + GAP; j++ ) {
+            if ( isDirty( j ) ) end = j;
+        }
+        HAL_EEPROM_Put( (uint32_t)start, &_img[start], (size_t)( end - start + 1 ) );
+        _stats.physicalWrites++;
+        _stats.physicalBytes += (uint32_t)( end - start + 1 );
+        spans++;
+        i = end + 1;
+    }
+    if ( _hi >= 0 ) memset( &_dirty[_lo >> 3], 0, (size_t)( ( _hi >> 3 ) - ( _lo >> 3 ) + 1 ) );
+    _lo = BYTES;
+    _hi = -1;
+    return spans;
+}
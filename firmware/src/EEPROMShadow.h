@@ -0,0 +1,78 @@
+/**
+ * @file    EEPROMShadow.h
+ * @brief   RAM mirror of the 2 KB EEPROM working image with deferred,
+ *          coalesced write-back.
+ *
+ * @details
+ * EEPROMManager used to reach EEPROM for every field it touched: each event
+ * load re-read the EventHeader, every status and config update was its own
+ * read-modify-write.  It now goes through this shadow instead:
+ *
+ *  - @c begin() copies bytes [0, @c BYTES) into RAM; every read of that range
+ *    is served from the copy;
+ *  - a write updates the copy and marks only the bytes that actually changed;
+ *  - @c commit() writes the marked bytes back as spans (runs closer than
+ *    @c GAP clean bytes are merged).  loop() commits once per pass; code that
+ *    needs an ordering point (the A/B config commit) calls it directly.
+ *
+ * Addresses at or above @c BYTES (the sun table, status log and config B
+ * slots, which keep their own RAM copies) pass straight through to EEPROM.
+ * Until commit() a reset loses the pending bytes, never the previous image.
+ *
+ * @c stats() compares the writes asked for (logical) with what reached
+ * EEPROM (physical).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class EEPROMShadow {
+public:
+    static const int BYTES = 2048;    // the working image, EEPROM_TOTAL_BYTES rounded up
+    static const int GAP   = 8;       // clean bytes that still merge two dirty runs
+
+    struct Stats {
+        uint32_t logicalWrites;   // put() / write() calls
+        uint32_t logicalBytes;    // bytes passed to them
+        uint32_t physicalWrites;  // spans written to EEPROM (commit and pass-through)
+        uint32_t physicalBytes;   // bytes in those spans
+    };
+
+    /// Load the image from EEPROM, dropping anything not yet committed.
+    void     begin   ();
+
+    uint8_t  read    ( int addr );
+    void     write   ( int addr, uint8_t value );
+    template <typename T> T &get( int addr, T &t ) {
+        getBytes( addr, (uint8_t *)&t, sizeof(T) );
+        return t;
+    }
+    template <typename T> const T &put( int addr, const T &t ) {
+        putBytes( addr, (const uint8_t *)&t, sizeof(T) );
+        return t;
+    }
+
+    /// Write every changed byte back to EEPROM.  Returns the spans written.
+    int      commit  ();
+    bool     dirty   () const { return _hi >= 0; }
+
+    const Stats &stats() const { return _stats; }
+    void     resetStats() { _stats = {}; }
+
+private:
+    void     load    ();
+    void     getBytes( int addr, uint8_t *dst, size_t n );
+    void     putBytes( int addr, const uint8_t *src, size_t n );
+    bool     isDirty ( int i ) const { return _dirty[i >> 3] & ( 1u << ( i & 7 ) ); }
+
+    uint8_t  _img[BYTES];
+    uint8_t  _dirty[BYTES / 8];
+    int      _lo     = BYTES;     // dirty bytes lie in [_lo, _hi]
+    int      _hi     = -1;
+    bool     _loaded = false;
+    Stats    _stats  = {};
+};
+
+extern EEPROMShadow eepromShadow;
@@ -0,0 +1,87 @@
+#include "EventIndex.h"
+
+#include <algorithm>
+
+namespace EventIndex {
+
+int merge( EventSpan *spans, int n ) {
+    if ( n <= 0 ) return 0;
+
+    std::sort( spans, spans + n, []( const EventSpan &a, const EventSpan &b ) {
+        return a.begin < b.begin;
+    } );
+
+    int out = 0;
+    for ( int i = 1; i < n; i++ ) {
+        if ( spans[i].begin <= spans[out].end ) {
+            if ( spans[i].end > spans[out].end ) spans[out].end = spans[i].end;
+        } else {
+            spans[++out] = spans[i];
+        }
+    }
+    return out + 1;
+}
+
+// Last span with begin <= t, or -1
+static int lastAtOrBefore( const EventSpan *spans, int n, time_t t ) {
+    int lo = 0, hi = n;   // first index with begin > t lies in [lo, hi]
+    while ( lo < hi ) {
+        int mid = lo + (hi - lo) / 2;
+        if ( spans[mid].begin <= t ) lo = mid + 1;
+        else                         hi = mid;
+    }
+    return lo - 1;
+}
+
+int find( const EventSpan *spans, int n, time_t t ) {
+    int i = lastAtOrBefore( spans, n, t );
+    return ( i >= 0 && spans[i].end > t ) ? i : -1;
+}
+
+int firstAfter( const EventSpan *spans, int n, time_t t ) {
+    int i = lastAtOrBefore( spans, n, t ) + 1;
+    return ( i < n ) ? i : -1;
+}
+
+FlagStation query( const EventSpan *spans, int n, time_t t,
+                   time_t &nextChange, FlagStation &nextSta ) {
+    int cur = find( spans, n, t );
+    if ( cur >= 0 ) {
+        nextChange = spans[cur].end;
+        nextSta    = FLAG_FULL;
+        return FLAG_HALF;
+    }
+
+    int nxt = firstAfter( spans, n, t );
+    if ( nxt >= 0 ) {
+        nextChange = spans[nxt].begin;
+        nextSta    = FLAG_HALF;
+        return FLAG_FULL;
+    }
+
+    nextChange = 0;
+    nextSta    = FLAG_UNKNOWN;
+    return FLAG_FULL;
+}
+
+int transitions( const EventSpan *spans, int n, time_t from, time_t to, time_t openEnd,
+                 EventTransition *out, int skip, int maxOut ) {
+    int total = 0;
+    auto emit = [&]( time_t at, FlagStation sta ) {
+        int k = total++ - skip;
+        if ( k >= 0 && k < maxOut ) out[k] = { at, sta };
+    };
+
+    int i = find( spans, n, from );
+    if ( i < 0 ) i = firstAfter( spans, n, from );
+    if ( i < 0 ) return 0;
+
+    for ( ; i < n && spans[i].begin <= to; i++ ) {
+        if ( spans[i].end <= spans[i].begin ) continue;          // empty window: never HALF
+        if ( spans[i].begin > from )                         emit( spans[i].begin, FLAG_HALF );
+        if ( spans[i].end != openEnd && spans[i].end <= to ) emit( spans[i].end,   FLAG_FULL );
+    }
+    return total;
+}
+
+} // namespace EventIndex
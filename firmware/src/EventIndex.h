@@ -0,0 +1,68 @@
+/**
+ * @file    EventIndex.h
+ * @brief   Sorted, merged interval index over applicable events' [GMTbegin, GMTend).
+ *
+ * @details
+ * Replaces the fixed-point overlap loop that @c EventManager::setNextEvent()
+ * used to run over all N_EVENTS until the in-progress end time stopped moving
+ * (O(N²) worst case).  Here the caller fills an @c EventSpan array, @c merge()
+ * sorts it by begin and coalesces overlapping or touching spans in one pass,
+ * and @c query() answers "ordered station now / next change" with a binary
+ * search over the merged spans.
+ *
+ * Merge rules match Gen2 @c setNextEvent() exactly:
+ *  - a span that begins at or before the current merged end joins it
+ *    (touching windows chain, so the flag does not bounce to FULL between them)
+ *  - open-ended events (@c GMTend == 0) are given an end of now + 30 days by
+ *    the caller before merging
+ *
+ * @c transitions() walks the same merged spans forward to list every station
+ * change in a horizon, which backs the s_Timeline variable.
+ *
+ * Storage is caller-owned so the index never allocates; EventManager keeps a
+ * fixed @c EventSpan[N_EVENTS] member.
+ */
+
+#pragma once
+
+#include "application.h"      // time_t
+#include "HalyardManager.h"   // FlagStation enum
+
+/// One half-open schedule window [begin, end) during which the flag is at HALF.
+struct EventSpan {
+    time_t begin;
+    time_t end;
+};
+
+/// One station change on the forward timeline.
+struct EventTransition {
+    time_t      at;
+    FlagStation sta;   // FLAG_HALF at a span's begin, FLAG_FULL at its end
+};
+
+namespace EventIndex {
+
+/// Sort @p spans[0..n) by begin and merge overlapping / touching spans in place.
+/// Returns the number of merged spans (<= n); spans[0..result) are disjoint
+/// and strictly ordered.
+int merge( EventSpan *spans, int n );
+
+/// Index of the merged span containing @p t, or -1.  O(log n).
+int find( const EventSpan *spans, int n, time_t t );
+
+/// Index of the first merged span beginning strictly after @p t, or -1.  O(log n).
+int firstAfter( const EventSpan *spans, int n, time_t t );
+
+/// Station the flag should hold at @p t, plus the next change time/station.
+/// @p nextChange is 0 and @p nextSta is FLAG_UNKNOWN when nothing is pending.
+FlagStation query( const EventSpan *spans, int n, time_t t,
+                   time_t &nextChange, FlagStation &nextSta );
+
+/// Station changes in (@p from, @p to], in time order.  A span ending exactly
+/// at @p openEnd stands for an open-ended event and contributes no FULL change.
+/// Changes [skip, skip + maxOut) are written to @p out; returns the total in
+/// the window so callers can page.
+int transitions( const EventSpan *spans, int n, time_t from, time_t to, time_t openEnd,
+                 EventTransition *out, int skip, int maxOut );
+
+} // namespace EventIndex
@@ -21,12 +21,12 @@
  *
  * EEPROM layout (from EEPROMManager.h):
  *  - @c EEPROM_ADDR_EVENT_HDR (144): EventHeader struct (8 bytes)
- *  - @c EEPROM_ADDR_EVENT_LIST   (152): FlagEvent[N_EVENTS] array
+ *  - @c EEPROM_ADDR_EVENT_LIST   (152): EventStrings (JUR / FLG text)
+ *  - @c EEPROM_ADDR_EVENT_RECS   (344): PackedEvent records, back to back
  *
  * @note  Particle.unsubscribe() drops ALL subscriptions for the device — there
- *        is no topic-specific form.  EventManager currently owns all subscriptions;
- *        if other modules ever need their own, they must be re-registered inside
- *        resetSubscriptions().
+ *        is no topic-specific form.  Topics therefore go through the
+ *        subscription registry (Subscriptions.h), which other modules share.
  *
  * @note  JSON_BUF is set to 1024 bytes.  Particle publish payloads are limited to
  *        622 bytes; keep showConfig() and showEvent() output within that limit.
@@ -37,30 +37,92 @@
 #include "FlagUtils.h"
 #include "Dbg.h"
 
+#include <strings.h>   // strncasecmp
+
 // JSON working buffer size – keep in line with rest of Gen3 codebase
 static const int JSON_BUF = 1024;
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  Static member definitions
+//  Inbound JSON  –  jsmn tokens over a static buffer, no heap per message
+//
+//  receiveEvent(), receiveEvents() and configScheduler() tokenize into
+//  s_jsonIn; keys are matched in place and values copied straight into the
+//  destination fields.  JSON_TOKENS covers a full JSON_BUF payload of events
+//  (an event with a 7-entry SJR list is ~25 tokens); a larger payload fails
+//  to parse rather than growing the pool.
 // ─────────────────────────────────────────────────────────────────────────────
-const char EventManager::FED_FLAG[3] = "US";
+typedef JsonParserGeneratorRK::jsmntok_t JTok;
 
-// Global instance
-EventManager evMgr;
+static const int JSON_TOKENS = 128;
+static JsonParserStatic<JSON_BUF, JSON_TOKENS> s_jsonIn;
+
+// Tokenize @p json; returns the outermost token or nullptr
+static const JTok *jsonParse( const char *json ) {
+    s_jsonIn.clear();
+    if ( json == nullptr || !s_jsonIn.addString( json ) || !s_jsonIn.parse() ) return nullptr;
+    return ( s_jsonIn.getTokens() < s_jsonIn.getTokensEnd() ) ? s_jsonIn.getTokens() : nullptr;
+}
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  sfEventHandler  –  file-scope static Particle subscription callback
+//  Event table I/O scratch  –  loadFromEEPROM() / saveToEEPROM()
 //
-//  Particle.subscribe() requires a plain (non-capturing) function pointer.
-//  This forwarder bridges that requirement to the evMgr instance method.
-//  Both the federal (e.g. "FE-US") and state (e.g. "FE-OH") subscriptions point here;
-//  the topic argument is available if needed for diagnostics but eventApplies()
-//  does the real jurisdiction filtering inside receiveEvent().
+//  N_EVENTS packed records plus the string layout are too large for the
+//  application thread's stack, so they live here.
 // ─────────────────────────────────────────────────────────────────────────────
-static void sfEventHandler( const char * /*topic*/, const char *data ) {
-    evMgr.receiveEvent( String(data) );
+static struct {
+    PackedEvent  recs[EventManager::N_EVENTS];
+    int32_t      ids [EventManager::N_EVENTS];
+    const char  *strs[2 * EventManager::N_EVENTS];
+    int          idx [2 * EventManager::N_EVENTS];
+} s_evIO;
+
+// First token after @p t and everything nested inside it
+static const JTok *jsonNext( const JTok *t ) {
+    const JTok *end = s_jsonIn.getTokensEnd();
+    const JTok *n   = t + 1;
+    while ( n < end && n->start < t->end ) n++;
+    return n;
+}
+
+// Case-insensitive key compare without copying the key
+static bool jsonKeyIs( const JTok *key, const char *name ) {
+    size_t n = strlen( name );
+    return (size_t)( key->end - key->start ) == n &&
+           strncasecmp( s_jsonIn.getBuffer() + key->start, name, n ) == 0;
+}
+
+// Unescaped string (or primitive text) into @p dst, always terminated
+static void jsonStr( const JTok *t, char *dst, size_t len ) {
+    size_t n = len;
+    s_jsonIn.getTokenValue( t, dst, n );
+}
+
+static double jsonNum( const JTok *t ) {
+    char tmp[24];
+    s_jsonIn.copyTokenValue( t, tmp, sizeof(tmp) );
+    return strtod( tmp, nullptr );
+}
+
+static int jsonInt( const JTok *t ) {
+    char tmp[16];
+    s_jsonIn.copyTokenValue( t, tmp, sizeof(tmp) );
+    return atoi( tmp );
 }
 
+static bool jsonBool( const JTok *t ) {
+    bool b = false;
+    s_jsonIn.getTokenValue( t, b );
+    return b;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Static member definitions
+// ─────────────────────────────────────────────────────────────────────────────
+const char EventManager::FED_FLAG[3] = "US";
+
+// Global instance
+EventManager evMgr;
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  Constructor / destructor
 // ─────────────────────────────────────────────────────────────────────────────
@@ -71,6 +133,8 @@ EventManager::EventManager()
       _tzOffset(0.0f), _doDST(false), _sjrCount(0)
 {
     memset( _sjrList, 0, sizeof(_sjrList) );
+    memset( _strTab,  0, sizeof(_strTab)  );
+    invalidateSunCache();
 }
 
 EventManager::~EventManager() {
@@ -81,47 +145,56 @@ EventManager::~EventManager() {
 // ─────────────────────────────────────────────────────────────────────────────
 void EventManager::setup( void (*setStationCB)(FlagStation) ) {
     _setStationCB = setStationCB;
+    _dlCheck      = deadlines.add( onCheckDue, this );   // armed by updEventTimer()
     loadConfig();                   // pull ConfigData / ConfigExt into local cache
     _configured = ( loadFromEEPROM() == 0 );
-    reprocessEvents();              // re-evaluate stored events against current config / time
+    reprocessEvents( EVD_ALL );     // applies is not persisted: resolve and check every slot once
 
     // Register Particle cloud variables and ring-buffer inspector
     Particle.variable( "s_EventLIST",  [this](){ return showEventList();      } );
+    Particle.function( "s_EvLPage",    [this](String s) -> int { return setEventListPage(s.toInt()); } );
     Particle.variable( "s_ShowConfig", [this](){ return showConfig();          } );
     Particle.variable( "s_Event",      [this](){ return showEventAtCursor();   } );
     Particle.function( "s_EvIdx",      [this](String s) -> int { return setShowIdx(s.toInt()); } );
-
-    // Register subscriptions for this unit's jurisdictions.
-    // configScheduler() will call resetSubscriptions() again if jurisdictions change.
+    Particle.variable( "s_BatchRC",    [this](){ return showBatchResult();     } );
+    Particle.variable( "s_EvDigest",   [this](){ return showDigest();          } );
+    Particle.variable( "s_EvHave",     [this](){ return showHaveList();        } );
+    Particle.function( "s_EvHavePg",   [this](String s) -> int { return setHavePage(s.toInt()); } );
+    Particle.variable( "s_Timeline",   [this](){ return showTimeline();        } );
+    Particle.function( "s_TlPage",     [this](String s) -> int {
+        int comma = s.indexOf(',');
+        return setTimelinePage( s.toInt(), comma >= 0 ? s.substring(comma + 1).toInt() : 0 );
+    } );
+
+    // Route this unit's jurisdiction topics.
+    // configScheduler() will call updateSubscriptions() again if they change.
     // main.ino registers the Particle.function("s_Config") binding separately.
-    resetSubscriptions();
+    updateSubscriptions();
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  resetSubscriptions()  –  drop all subscriptions and re-register for the
-//                           current jurFederal and jurState values.
+//  updateSubscriptions()  –  declare the FED, STA and SUB topics to the
+//                            subscription registry
 //
 //  Must be called:
-//    1) Once during setup(), after loadConfig() has populated _jurFederal/_jurState
-//    2) Any time configScheduler() changes FED or STA fields
+//    1) Once during setup(), after loadConfig() has populated the topics
+//    2) Any time configScheduler() changes FED, STA or SUB
 //
-//  Particle.unsubscribe() has no topic-specific form – it drops ALL subscriptions
-//  for this device.  That is fine here because EventManager owns all subscriptions.
-//  If other parts of the firmware ever need their own subscriptions, coordinate
-//  so that resetSubscriptions() re-registers those as well.
+//  The registry replaces this owner's routes and subscribes only to topics
+//  no active subscription already covers, so events on unchanged topics keep
+//  arriving while the set changes.
 // ─────────────────────────────────────────────────────────────────────────────
-void EventManager::resetSubscriptions() {
-    Particle.unsubscribe();   // drop all existing subscriptions
-
-    if ( _jurFederal.length() > 0 ) {
-        Particle.subscribe( _jurFederal, sfEventHandler );
-        SFDBG::pub("EM", "subscribed to " + _jurFederal, true);
-    }
+void EventManager::updateSubscriptions() {
+    const char *topics[2 + SUB_MAX] = { _jurFederal.c_str(), _jurState.c_str() };
+    for ( int i = 0; i < SUB_MAX; i++ ) topics[2 + i] = _jurExtra[i].c_str();
+    subscriptions.setTopics( onEvent, this, topics, 2 + SUB_MAX );
+}
 
-    if ( _jurState.length() > 0 && _jurState != _jurFederal ) {
-        Particle.subscribe( _jurState, sfEventHandler );
-        SFDBG::pub("EM", "subscribed to " + _jurState, true);
-    }
+//  onEvent()  –  registry handler for every jurisdiction topic.  The topic is
+//  available for diagnostics; eventApplies() does the real jurisdiction
+//  filtering inside receiveEvent().
+void EventManager::onEvent( const char * /*topic*/, const char *data, void *ctx ) {
+    static_cast<EventManager *>( ctx )->receiveEvent( data );
 }
 
 
@@ -129,28 +202,35 @@ void EventManager::resetSubscriptions() {
 void EventManager::loop() {
     if ( !_configured ) return;
 
-    // Software timer replacement: check if our interval has elapsed
-    if ( _msUntilNext > 0 ) {
-        unsigned long elapsed = millis() - _timerStartMs;
-        if ( elapsed >= _msUntilNext ) {
-            _attentionFlag = true;
-        }
-    }
-
     if ( _attentionFlag ) {
         checkForChange();
     }
 }
 
+//  onCheckDue()  –  deadline callback for the timer armed by updEventTimer()
+void EventManager::onCheckDue( void *ctx ) {
+    static_cast<EventManager *>( ctx )->_attentionFlag = true;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  checkForChange()
 //  Compare _orderedSta to what the halyard is currently doing.  If a movement
-//  is due, call _setStationCB.  Then reprocess so timer resets.
+//  is due, call _setStationCB.  Re-runs the schedule so the timer resets;
+//  resolved GMTbegin/GMTend do not depend on the current time, so no slot is
+//  re-resolved here – except at a DST boundary, where the transition table is
+//  brought up to date and only local-time marks are re-resolved.
 //  (Gen2 had this stubbed – implemented here per design intent.)
 // ─────────────────────────────────────────────────────────────────────────────
 void EventManager::checkForChange() {
     _attentionFlag = false;
-    reprocessEvents();          // recalculates _orderedSta, _nextChange, _nextSta
+    if ( _nextDst != 0 && Time.now() >= _nextDst ) {
+        _dstBoundaries++;
+        refreshTz();
+        markDirty( EVD_DST );
+        processDirty();         // re-runs setNextEvent()
+    } else {
+        setNextEvent();         // marks are already resolved – only "now" moved
+    }
     if ( _setStationCB ) {
         _setStationCB( _orderedSta );
     }
@@ -159,11 +239,75 @@ void EventManager::checkForChange() {
 // ─────────────────────────────────────────────────────────────────────────────
 //  receiveEvent()  –  Particle subscription callback target
 // ─────────────────────────────────────────────────────────────────────────────
-int EventManager::receiveEvent( String JSONFlagEvent ) {
+int EventManager::receiveEvent( const char *JSONFlagEvent ) {
+
+    bool changed = false;
+    int  rc = applyEvent( jsonParse( JSONFlagEvent ), changed );
+    if ( rc != (int)EMrc::SUCCESS || !changed ) return rc;
+
+    processDirty();
+    saveToEEPROM();
+    checkAndReportStatus(true, "EVT");   // confirm receipt and publish updated schedule
+    SFDBG::pub("EM", "new event processed");
+    return (int)EMrc::SUCCESS;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  receiveEvents()  –  batch form of receiveEvent() for catch-up pushes
+//
+//  Takes a JSON array of event objects.  Every entry is applied to _EVL first;
+//  then the table is reprocessed, persisted and reported once for the whole
+//  batch.  Per-entry EMrc codes go to @p rcOut (up to @p rcMax entries) and to
+//  the s_BatchRC variable.  Returns SUCCESS if every entry succeeded, GENFAIL
+//  if any did not, PARSE_ERROR if the payload is not an array.
+// ─────────────────────────────────────────────────────────────────────────────
+int EventManager::receiveEvents( const String &JSONFlagEvents, int *rcOut, int rcMax ) {
+
+    const JTok *outer = jsonParse( JSONFlagEvents.c_str() );
+    if ( outer == nullptr || outer->type != JsonParserGeneratorRK::JSMN_ARRAY ) {
+        SFDBG::pub("EM", "EVB not an array", true);
+        return (int)EMrc::PARSE_ERROR;
+    }
+
+    bool anyChanged = false;
+    int  nFail      = 0;
+    _batchN = 0;
+
+    const JTok *item = outer + 1;
+    for ( int i = 0; i < outer->size; i++, item = jsonNext( item ) ) {
+        bool changed = false;
+        int  rc = applyEvent( item, changed );
+        anyChanged |= changed;
+        if ( rc != (int)EMrc::SUCCESS ) nFail++;
+
+        if ( rcOut && _batchN < rcMax ) rcOut[_batchN]   = rc;
+        if ( _batchN < BATCH_MAX )      _batchRc[_batchN] = (int8_t)rc;
+        _batchN++;
+    }
+
+    if ( anyChanged ) {
+        processDirty();
+        saveToEEPROM();
+        checkAndReportStatus(true, "EVT");
+    }
+    SFDBG::pub("EM", String::format("batch of %d processed, %d failed", _batchN, nFail));
+    return nFail ? (int)EMrc::GENFAIL : (int)EMrc::SUCCESS;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  applyEvent()  –  parse one event object and update its _EVL slot
+//
+//  Leaves the slot tagged EVD_EVENT (or cleared, for DEL) without reprocessing
+//  or persisting; @p changed tells the caller whether a commit is needed.
+//  Superseded versions and deletes of unknown IDs succeed with no change.
+// ─────────────────────────────────────────────────────────────────────────────
+int EventManager::applyEvent( const JTok *obj, bool &changed ) {
+    changed = false;
 
-    FlagEventEx nEVL = parseEvent( JSONFlagEvent );
+    FlagEventEx nEVL = parseEvent( obj );
+    if ( nEVL.jurCode == STR_NONE ) return (int)EMrc::EVL_OVERFLOW;   // no room for its JUR / FLG
     if ( nEVL.eventID <= 0 || !nEVL.valid ) {
-        SFDBG::pub("EM", "EVT parse fail", true);
+        SFDBG::note( SFDBG::TAG_EM, SFDBG::PARSE_FAIL, nEVL.eventID );
         return (int)EMrc::PARSE_ERROR;
     }
 
@@ -176,8 +320,9 @@ int EventManager::receiveEvent( String JSONFlagEvent ) {
         if ( nEVL.isDelete ) {
             clearEvent( _EVL[idx] );
         } else {
-            _EVL[idx] = nEVL;
-            _EVL[idx].applies = eventApplies( _EVL[idx] );
+            if ( !fitsRecordArea( idx, nEVL ) ) return (int)EMrc::EVL_OVERFLOW;
+            setEvent( idx, nEVL );
+            _dirty[idx] |= EVD_EVENT;
         }
     } else {
         // ── New event ─────────────────────────────────────────────────────────
@@ -185,59 +330,199 @@ int EventManager::receiveEvent( String JSONFlagEvent ) {
 
         purgeEvents();                           // make room if possible
         idx = matchEVID( 0 );                    // find an empty slot (eventID == 0)
-        if ( idx < 0 ) return (int)EMrc::EVL_OVERFLOW;
+        if ( idx < 0 || !fitsRecordArea( idx, nEVL ) ) return (int)EMrc::EVL_OVERFLOW;
 
-        _EVL[idx] = nEVL;
-        _EVL[idx].applies = eventApplies( _EVL[idx] );
+        setEvent( idx, nEVL );
+        _dirty[idx] |= EVD_EVENT;
     }
 
-    reprocessEvents();
-    checkAndReportStatus(true, "EVT");   // confirm receipt and publish updated schedule
-    SFDBG::pub("EM", "new event processed");
+    changed = true;
     return (int)EMrc::SUCCESS;
 }
 
+//  showBatchResult()  –  {"N":n,"RC":[rc,...]} for the last receiveEvents() call
+String EventManager::showBatchResult() {
+    char buf[JSON_BUF];
+    memset( buf, 0, sizeof(buf) );
+    JSONBufferWriter writer( buf, sizeof(buf) - 1 );
+
+    writer.beginObject();
+        writer.name("N").value( _batchN );
+        writer.name("RC").beginArray();
+        for ( int i = 0; i < _batchN && i < BATCH_MAX; i++ ) writer.value( (int)_batchRc[i] );
+        writer.endArray();
+    writer.endObject();
+
+    return String(buf);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Event-set digest and have-list  –  let the backend send only what is missing
+//
+//  After a reconnect the backend reads s_EvDigest ("n:xxxxxxxx").  If it equals
+//  the digest of the events it expects this unit to hold, there is nothing to
+//  send.  Otherwise it reads every s_EvHave page (selected with s_EvHavePg) and
+//  pushes, as s_InjectEv batches, the events whose id is absent or whose
+//  version is newer (and DEL entries for ids it has withdrawn).
+//
+//  pairDigest() is murmur3's fmix32 over id * golden-ratio + ver; XOR-folding
+//  the terms makes the digest independent of slot order and lets setEvent() /
+//  clearEvent() update it in O(1).
+// ─────────────────────────────────────────────────────────────────────────────
+uint32_t EventManager::pairDigest( int32_t id, int32_t ver ) {
+    uint32_t h = (uint32_t)id * 0x9E3779B1u + (uint32_t)ver;
+    h ^= h >> 16;  h *= 0x85EBCA6Bu;
+    h ^= h >> 13;  h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+String EventManager::showDigest() {
+    int n = 0;
+    for ( int i = 0; i < N_EVENTS; i++ ) if ( _EVL[i].eventID > 0 ) n++;
+    return String::format( "%d:%08lx", n, (unsigned long)_evDigest );
+}
+
+static_assert( EventManager::N_EVENTS <= 256, "showHaveList() orders slot indices as uint8_t" );
+
+int EventManager::setHavePage( int page ) {
+    _hvPage = max( page, 0 );
+    return _hvPage;
+}
+
+String EventManager::showHaveList() {
+    // Insertion sort of occupied slot indices by eventID (N_EVENTS is small)
+    uint8_t order[N_EVENTS];
+    int     n = 0;
+    for ( int i = 0; i < N_EVENTS; i++ ) {
+        if ( _EVL[i].eventID <= 0 ) continue;
+        int j = n++;
+        while ( j > 0 && _EVL[order[j - 1]].eventID > _EVL[i].eventID ) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = (uint8_t)i;
+    }
+
+    const int pages = ( n + HAVE_PAGE - 1 ) / HAVE_PAGE;
+    const int first = _hvPage * HAVE_PAGE;
+    const int last  = min( first + HAVE_PAGE, n );
+
+    // Whole "id.ver" entries only; HAVE_PAGE of the longest always fit
+    char list[HAVE_PAGE * 24];
+    int  len = 0;
+    list[0] = '\0';
+    for ( int k = first; k < last; k++ ) {
+        const FlagEventEx &ev = _EVL[order[k]];
+        char item[24];
+        int  w = snprintf( item, sizeof(item), "%s%ld.%ld",
+                           k > first ? "," : "", (long)ev.eventID, (long)ev.eventVer );
+        if ( len + w >= (int)sizeof(list) ) break;
+        memcpy( list + len, item, w + 1 );
+        len += w;
+    }
+
+    char buf[JSON_BUF];
+    memset( buf, 0, sizeof(buf) );
+    JSONBufferWriter writer( buf, sizeof(buf) - 1 );
+
+    writer.beginObject();
+        writer.name("N").value( n );
+        writer.name("P").value( _hvPage );
+        writer.name("NP").value( pages );
+        writer.name("H").value( list );
+    writer.endObject();
+
+    return String(buf);
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  configScheduler()  –  Particle cloud function target
 //  Accepts the same JSON field names as Gen2 (LAT, LNG, STD, DST, ZIP, FED,
 //  STA, FPR, FLG).  Fields already live in ConfigData – this method updates
 //  EEPROMManager and refreshes the local cache.
 // ─────────────────────────────────────────────────────────────────────────────
-int EventManager::configScheduler( String JSONconfig ) {
+int EventManager::configScheduler( const String &JSONconfig ) {
 
-    JSONValue outerObj = JSONValue::parseCopy( JSONconfig.c_str() );
-    JSONObjectIterator iter( outerObj );
+    const JTok *obj = jsonParse( JSONconfig.c_str() );
+    if ( obj == nullptr || obj->type != JsonParserGeneratorRK::JSMN_OBJECT ) {
+        SFDBG::pub("EM", "CFG parse fail", true);
+        return (int)EMrc::PARSE_ERROR;
+    }
 
-    // Track whether jurisdiction fields change so we know if resetSubscriptions
+    // Track whether jurisdiction fields change so we know if updateSubscriptions
     // is needed.  Other config changes (LAT, LNG, TZ, etc.) do not affect
     // subscription topics.
     String prevFed = _jurFederal;
     String prevSta = _jurState;
-
-    while ( iter.next() ) {
-        String field = String( iter.name() ).toUpperCase();
-
-        if      ( field == "LAT" ) { _lat            = iter.value().toDouble();              }
-        else if ( field == "LNG" ) { _lng             = iter.value().toDouble();              }
-        else if ( field == "STD" ) { _tzOffset        = (float)iter.value().toDouble();       }
-        else if ( field == "DST" ) { _doDST           = iter.value().toBool();                }
-        else if ( field == "ZIP" ) { _postalCode       = String(iter.value().toString());      }
-        else if ( field == "FED" ) { _jurFederal       = String(iter.value().toString());      }
-        else if ( field == "STA" ) { _jurState         = String(iter.value().toString());      }
-        else if ( field == "FPR" ) { _upperFlagPrio    = iter.value().toInt();                 }
-        else if ( field == "FLG" ) { _upperFlag        = String(iter.value().toString());      }
-        else if ( field == "SJR" ) {
+    String prevSub[SUB_MAX];
+    for ( int i = 0; i < SUB_MAX; i++ ) prevSub[i] = _jurExtra[i];
+    bool   subSeen = false;
+    String prevFlg = _upperFlag;
+    double prevLat = _lat;
+    double prevLng = _lng;
+    float  prevStd = _tzOffset;
+    bool   prevDst = _doDST;
+    bool   sjrSeen = false;
+    bool   tzrSeen = false;
+    bool   tzrDefault = false;
+    TzRule prevTzr = _tzRule;
+
+    // String fields are held to their ConfigData widths so RAM matches EEPROM
+    char str[sizeof(ConfigData::FED)];
+
+    const JTok *key = obj + 1;
+    for ( int i = 0; i < obj->size; i++, key = jsonNext( key + 1 ) ) {
+        const JTok *val = key + 1;
+
+        if      ( jsonKeyIs( key, "LAT" ) ) { _lat           = jsonNum( val );          }
+        else if ( jsonKeyIs( key, "LNG" ) ) { _lng           = jsonNum( val );          }
+        else if ( jsonKeyIs( key, "STD" ) ) { _tzOffset      = (float)jsonNum( val );   }
+        else if ( jsonKeyIs( key, "DST" ) ) { _doDST         = jsonBool( val );         }
+        else if ( jsonKeyIs( key, "TZR" ) ) {
+            // "Mm.w.d[/h],Mm.w.d[/h]" sets the DST rule; "" restores North American rules
+            char tzr[TzRules::MAX_LEN + 1];
+            jsonStr( val, tzr, sizeof(tzr) );
+            if ( tzr[0] == '\0' ) {
+                _tzRule    = TzRules::northAmerica();
+                tzrSeen    = true;
+                tzrDefault = true;
+            } else if ( TzRules::parse( tzr, _tzRule ) ) {
+                tzrSeen = true;
+            } else {
+                SFDBG::pub("EM", "TZR rejected: " + String(tzr), true);
+            }
+        }
+        else if ( jsonKeyIs( key, "ZIP" ) ) { jsonStr( val, str, sizeof(ConfigData::ZIP) ); _postalCode = str; }
+        else if ( jsonKeyIs( key, "FED" ) ) { jsonStr( val, str, sizeof(ConfigData::FED) ); _jurFederal = str; }
+        else if ( jsonKeyIs( key, "STA" ) ) { jsonStr( val, str, sizeof(ConfigData::STA) ); _jurState   = str; }
+        else if ( jsonKeyIs( key, "SUB" ) ) {
+            // Extra jurisdiction topics: "SUB":["FE-UT-X","CUSTOM"], "SUB":"FE-X" or [] to clear
+            subSeen = true;
+            for ( int j = 0; j < SUB_MAX; j++ ) _jurExtra[j] = "";
+            if ( val->type == JsonParserGeneratorRK::JSMN_ARRAY ) {
+                const JTok *el = val + 1;
+                for ( int j = 0; j < val->size && j < SUB_MAX; j++, el = jsonNext( el ) ) {
+                    jsonStr( el, str, sizeof(ConfigExt::subTopics[0]) ); _jurExtra[j] = str;
+                }
+            } else {
+                jsonStr( val, str, sizeof(ConfigExt::subTopics[0]) ); _jurExtra[0] = str;
+            }
+        }
+        else if ( jsonKeyIs( key, "FPR" ) ) { _upperFlagPrio = jsonInt( val );          }
+        else if ( jsonKeyIs( key, "FLG" ) ) { jsonStr( val, str, sizeof(ConfigData::FLG) ); _upperFlag  = str; }
+        else if ( jsonKeyIs( key, "SJR" ) ) {
             // Accept array form "SJR":[12,34] or scalar form "SJR":12
+            sjrSeen   = true;
             _sjrCount = 0;
             memset( _sjrList, 0, sizeof(_sjrList) );
-            JSONValue sjrVal = iter.value();
-            if ( sjrVal.isArray() ) {
-                JSONArrayIterator aIter( sjrVal );
-                while ( aIter.next() && _sjrCount < 5 ) {
-                    _sjrList[ _sjrCount++ ] = (uint16_t)aIter.value().toInt();
+            if ( val->type == JsonParserGeneratorRK::JSMN_ARRAY ) {
+                const JTok *el = val + 1;
+                for ( int j = 0; j < val->size && _sjrCount < 5; j++, el = jsonNext( el ) ) {
+                    _sjrList[ _sjrCount++ ] = (uint16_t)jsonInt( el );
                 }
             } else {
-                int v = sjrVal.toInt();
+                int v = jsonInt( val );
                 if ( v != 0 ) { _sjrList[0] = (uint16_t)v; _sjrCount = 1; }
             }
         }
@@ -247,9 +532,16 @@ int EventManager::configScheduler( String JSONconfig ) {
 
     _configured = true;
 
-    // Re-subscribe if either jurisdiction string changed
-    if ( _jurFederal != prevFed || _jurState != prevSta ) {
-        resetSubscriptions();
+    if ( _lat != prevLat || _lng != prevLng ) {
+        invalidateSunCache();
+        refreshSunTable();
+    }
+
+    // Re-declare topics if any jurisdiction string changed
+    bool subChanged = false;
+    for ( int i = 0; i < SUB_MAX; i++ ) subChanged |= ( _jurExtra[i] != prevSub[i] );
+    if ( _jurFederal != prevFed || _jurState != prevSta || subChanged ) {
+        updateSubscriptions();
     }
 
     // Persist the fields this function owns — read-modify-write to preserve
@@ -269,7 +561,7 @@ int EventManager::configScheduler( String JSONconfig ) {
         writeConfig( cfg );
     }
 
-    // Persist SJR list to ConfigExt (read-modify-write)
+    // Persist SJR list, DST rule and extra topics to ConfigExt (read-modify-write)
     {
         ConfigExt x;
         readConfigExt( x );
@@ -280,10 +572,31 @@ int EventManager::configScheduler( String JSONconfig ) {
         x.sjrCount = (uint8_t)_sjrCount;
         for ( int i = 0; i < 5; i++ )
             x.sjrList[i] = ( i < _sjrCount ) ? _sjrList[i] : 0;
+        if ( tzrSeen ) {
+            x.tzRule = tzrDefault ? TzRule{} : _tzRule;
+            if ( tzrDefault ) x.flags &= ~CFGX_FLAG_TZRULE;
+            else              x.flags |=  CFGX_FLAG_TZRULE;
+        }
+        if ( subSeen ) {
+            memset( x.subTopics, 0, sizeof(x.subTopics) );
+            for ( int i = 0; i < SUB_MAX; i++ )
+                strncpy( x.subTopics[i], _jurExtra[i].c_str(), sizeof(x.subTopics[i]) - 1 );
+            if ( _jurExtra[0].length() || _jurExtra[1].length() ) x.flags |=  CFGX_FLAG_SUB;
+            else                                                 x.flags &= ~CFGX_FLAG_SUB;
+        }
         writeConfigExt( x );
     }
 
-    reprocessEvents();
+    // Recompute only what the changed fields invalidate
+    uint8_t reasons = EVD_NONE;
+    if ( _jurFederal != prevFed || _jurState != prevSta || subChanged ||
+         _upperFlag  != prevFlg || sjrSeen )                       reasons |= EVD_CONFIG;
+    if ( _lat != prevLat || _lng != prevLng || _tzOffset != prevStd ) reasons |= EVD_TIME;
+    if ( _doDST != prevDst ||
+         memcmp( &_tzRule, &prevTzr, sizeof(TzRule) ) != 0 )        reasons |= EVD_DST;
+    if ( reasons & ( EVD_TIME | EVD_DST ) ) refreshTz();
+    markDirty( reasons );
+    processDirty();
     saveToEEPROM();
 
     SFDBG::pub("EM", "configScheduler complete");
@@ -302,15 +615,16 @@ int EventManager::purgeEvents() {
             bool expired  = ( _EVL[i].GMTend != 0 && _EVL[i].GMTend < now );
             bool noBegin  = ( _EVL[i].GMTbegin == 0 );
             if ( !_EVL[i].valid || noBegin || expired ) {
-                SFDBG::pub("EM", "EVT " + String(_EVL[i].eventID) + " purged: "
-                               + (expired ? "expired" : noBegin ? "no-begin" : "invalid"), true);
+                SFDBG::note( SFDBG::TAG_EM, expired ? SFDBG::PURGE_EXPIRED
+                                          : noBegin ? SFDBG::PURGE_NO_BEGIN : SFDBG::PURGE_INVALID,
+                             _EVL[i].eventID );
                 clearEvent( _EVL[i] );
                 nPurged++;
             }
         }
     }
 
-    saveToEEPROM();
+    if ( nPurged > 0 ) saveToEEPROM();
     return nPurged;
 }
 
@@ -318,7 +632,16 @@ int EventManager::purgeEvents() {
 //  clearEvent()
 // ─────────────────────────────────────────────────────────────────────────────
 void EventManager::clearEvent( FlagEventEx &ev ) {
+    if ( ev.eventID > 0 ) _evDigest ^= pairDigest( ev.eventID, ev.eventVer );
     ev = FlagEventEx();  // reset to default-constructed state
+    _dirty[ &ev - _EVL ] = EVD_NONE;
+}
+
+//  setEvent()  –  overwrite slot @p idx, keeping _evDigest in step
+void EventManager::setEvent( int idx, const FlagEventEx &ev ) {
+    if ( _EVL[idx].eventID > 0 ) _evDigest ^= pairDigest( _EVL[idx].eventID, _EVL[idx].eventVer );
+    _EVL[idx] = ev;
+    if ( ev.eventID > 0 )        _evDigest ^= pairDigest( ev.eventID, ev.eventVer );
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -332,10 +655,74 @@ int EventManager::matchEVID( int id ) {
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  jurMatch()  –  prefix match, case-insensitive (verbatim from Gen2)
+//  fitsRecordArea()  –  would the stored table still fit EVENT_RECS_BYTES
+//  with slot @p idx holding @p ev?  Every accepted event is then saved.
+// ─────────────────────────────────────────────────────────────────────────────
+bool EventManager::fitsRecordArea( int idx, const FlagEventEx &ev ) const {
+    int bytes = PACKED_EVENT_BASE + 2 * ev.sjrCount;
+    for ( int i = 0; i < N_EVENTS; i++ ) {
+        if ( i == idx || !_EVL[i].valid || _EVL[i].eventID <= 0 ) continue;
+        bytes += PACKED_EVENT_BASE + 2 * _EVL[i].sjrCount;
+    }
+    return bytes <= EVENT_RECS_BYTES;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  String intern table  –  JUR / FLG text shared by all slots
+//
+//  Code 0 is the empty string.  Codes are never refcounted: when the table is
+//  full, sweepStrings() frees every entry no live slot (or the in-flight
+//  record @p pin being parsed) still references, and the lookup is retried.
+// ─────────────────────────────────────────────────────────────────────────────
+uint8_t EventManager::intern( const char *str, const FlagEventEx *pin ) {
+    if ( str == nullptr || str[0] == '\0' ) return 0;
+
+    for ( int pass = 0; pass < 2; pass++ ) {
+        int freeSlot = -1;
+        for ( int i = 1; i < STR_TAB_SIZE; i++ ) {
+            if ( _strTab[i][0] == '\0' ) {
+                if ( freeSlot < 0 ) freeSlot = i;
+            } else if ( strncmp( _strTab[i], str, STR_MAX - 1 ) == 0 ) {
+                return (uint8_t)i;
+            }
+        }
+        if ( freeSlot > 0 ) {
+            strncpy( _strTab[freeSlot], str, STR_MAX - 1 );
+            _strTab[freeSlot][STR_MAX - 1] = '\0';
+            return (uint8_t)freeSlot;
+        }
+        sweepStrings( pin );
+    }
+    return STR_NONE;
+}
+
+const char *EventManager::codeStr( uint8_t code ) const {
+    return ( code < STR_TAB_SIZE ) ? _strTab[code] : "";
+}
+
+void EventManager::sweepStrings( const FlagEventEx *pin ) {
+    bool used[STR_TAB_SIZE] = { false };
+    for ( int i = 0; i < N_EVENTS; i++ ) {
+        if ( _EVL[i].eventID <= 0 ) continue;
+        used[ _EVL[i].jurCode  % STR_TAB_SIZE ] = true;
+        used[ _EVL[i].flagCode % STR_TAB_SIZE ] = true;
+    }
+    if ( pin ) {
+        used[ pin->jurCode  % STR_TAB_SIZE ] = true;
+        used[ pin->flagCode % STR_TAB_SIZE ] = true;
+    }
+    for ( int i = 1; i < STR_TAB_SIZE; i++ ) {
+        if ( !used[i] ) _strTab[i][0] = '\0';
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  jurMatch()  –  prefix match, case-insensitive (Gen2 semantics: @p subJur
+//  must be a prefix of @p pubJur; an empty @p subJur matches anything)
 // ─────────────────────────────────────────────────────────────────────────────
-bool EventManager::jurMatch( const String &pubJur, const String &subJur ) {
-    return subJur.equalsIgnoreCase( pubJur.substring( 0, subJur.length() ) );
+bool EventManager::jurMatch( const char *pubJur, const String &subJur ) {
+    size_t n = subJur.length();
+    return strlen( pubJur ) >= n && strncasecmp( pubJur, subJur.c_str(), n ) == 0;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -343,20 +730,23 @@ bool EventManager::jurMatch( const String &pubJur, const String &subJur ) {
 // ─────────────────────────────────────────────────────────────────────────────
 bool EventManager::eventApplies( const FlagEventEx &ev ) {
     // ── 1) Jurisdiction match (same as Gen2) ─────────────────────────────────
-    bool jurOK = ( jurMatch(ev.eventJur, _jurFederal) ||
-                   jurMatch(ev.eventJur, _jurState)     );
+    const char *jur = codeStr( ev.jurCode );
+    const char *flg = codeStr( ev.flagCode );
+    bool jurOK = ( jurMatch(jur, _jurFederal) ||
+                   jurMatch(jur, _jurState)     );
+    for ( int i = 0; i < SUB_MAX && !jurOK; i++ ) {
+        jurOK = _jurExtra[i].length() > 0 && jurMatch( jur, _jurExtra[i] );
+    }
     if ( !jurOK ) {
-        SFDBG::pub("EM", "EVT " + String(ev.eventID) + " jur-fail: pub=" + ev.eventJur
-                        + " sub=" + _jurFederal + "/" + _jurState, true);
+        SFDBG::note( SFDBG::TAG_EM, SFDBG::JUR_FAIL, ev.eventID, ev.jurCode );
         return false;
     }
 
     // ── 2) Flag match (same as Gen2) ─────────────────────────────────────────
-    bool flgOK = ( ev.eventFlag == String(FED_FLAG) ||
-                   ev.eventFlag == _upperFlag         );
+    bool flgOK = ( strcmp( flg, FED_FLAG ) == 0 ||
+                   _upperFlag == flg                 );
     if ( !flgOK ) {
-        SFDBG::pub("EM", "EVT " + String(ev.eventID) + " flg-fail: " + ev.eventFlag
-                        + " want=" + String(FED_FLAG) + "/" + _upperFlag, true);
+        SFDBG::note( SFDBG::TAG_EM, SFDBG::FLG_FAIL, ev.eventID, ev.flagCode );
         return false;
     }
 
@@ -369,11 +759,11 @@ bool EventManager::eventApplies( const FlagEventEx &ev ) {
         bool sjrOK = false;
         for ( int i = 0; i < _sjrCount && !sjrOK; i++ ) {
             for ( int j = 0; j < ev.sjrCount && !sjrOK; j++ ) {
-                if ( _sjrList[i] == (uint16_t)ev.sjrList[j] ) sjrOK = true;
+                if ( _sjrList[i] == ev.sjrList[j] ) sjrOK = true;
             }
         }
         if ( !sjrOK ) {
-            SFDBG::pub("EM", "EVT " + String(ev.eventID) + " sjr-fail: unitSJR=" + String(_sjrCount), true);
+            SFDBG::note( SFDBG::TAG_EM, SFDBG::SJR_FAIL, ev.eventID, _sjrCount );
             return false;
         }
     }
@@ -382,90 +772,111 @@ bool EventManager::eventApplies( const FlagEventEx &ev ) {
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  reprocessEvents()  –  re-evaluate all stored events (call after time-sync,
-//                         DST change, or config change)
+//  reprocessEvents()  –  re-evaluate all stored events (call after time-sync
+//                         or DST change)
+//
+//  A clock correction moves every time mark but no event's applicability, so
+//  the default reasons leave the cached applies bit alone; eventApplies() runs
+//  only for slots that arrive (EVD_EVENT) or on FED/STA/FLG/SJR change
+//  (EVD_CONFIG, via configScheduler()).
 // ─────────────────────────────────────────────────────────────────────────────
-void EventManager::reprocessEvents() {
+void EventManager::reprocessEvents( uint8_t reasons ) {
     if ( !_configured ) return;
 
+    for ( int idx = 0; idx < N_EVENTS; idx++ ) _dirty[idx] |= reasons;
+    processDirty();
+    saveToEEPROM();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  markDirty()  –  tag the slots a config change invalidates.
+//
+//  Date-only and SR/SS marks depend on LAT/LNG, "…L" marks on STD and DST,
+//  "…Z" / bare HH:MM on nothing (TimeMarks::usesSun / usesLocal).  Slots whose
+//  marks cannot be affected are left clean.
+// ─────────────────────────────────────────────────────────────────────────────
+
+void EventManager::markDirty( uint8_t reasons ) {
     for ( int idx = 0; idx < N_EVENTS; idx++ ) {
+        if ( _EVL[idx].eventID <= 0 ) continue;
+        const FlagEventEx &ev = _EVL[idx];
+        bool sun   = TimeMarks::usesSun  ( ev.BMK ) || TimeMarks::usesSun  ( ev.EMK );
+        bool local = TimeMarks::usesLocal( ev.BMK ) || TimeMarks::usesLocal( ev.EMK );
+
+        uint8_t d = reasons & ( EVD_EVENT | EVD_CONFIG );
+        if ( ( reasons & EVD_TIME ) && ( sun || local ) ) d |= EVD_TIME;
+        if ( ( reasons & EVD_DST  ) && local )            d |= EVD_DST;
+        _dirty[idx] |= d;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  processDirty()  –  recompute dirty slots, then re-run the schedule
+// ─────────────────────────────────────────────────────────────────────────────
+void EventManager::processDirty() {
+    if ( !_configured ) return;
+
+    for ( int idx = 0; idx < N_EVENTS; idx++ ) {
+        uint8_t d = _dirty[idx];
+        if ( d == EVD_NONE ) continue;
+        _dirty[idx] = EVD_NONE;
+
         if ( !_EVL[idx].valid ) {
             clearEvent( _EVL[idx] );
-        } else if (
-            parseTimeMark( _EVL[idx].GMTbegin, _EVL[idx].BMK, "H" ) != 0 ||
-            parseTimeMark( _EVL[idx].GMTend,   _EVL[idx].EMK, "F" ) != 0   ) {
-            SFDBG::pub("EM", "EVT " + String(_EVL[idx].eventID)
-                            + " tmk-fail BMK=" + _EVL[idx].BMK, true);
-            clearEvent( _EVL[idx] );   // time mark resolution failed – discard
-        } else {
+            continue;
+        }
+        if ( d & ( EVD_EVENT | EVD_TIME | EVD_DST ) ) {
+            _markResolutions++;
+            bool bOK = parseTimeMark( _EVL[idx].GMTbegin, _EVL[idx].BMK, 'H' ) == 0;
+            if ( !bOK || parseTimeMark( _EVL[idx].GMTend, _EVL[idx].EMK, 'F' ) != 0 ) {
+                SFDBG::note( SFDBG::TAG_EM, bOK ? SFDBG::EMK_FAIL : SFDBG::BMK_FAIL,
+                             _EVL[idx].eventID );
+                clearEvent( _EVL[idx] );   // time mark resolution failed – discard
+                continue;
+            }
+        }
+        if ( d & ( EVD_EVENT | EVD_CONFIG ) ) {
+            _applyChecks++;
             _EVL[idx].applies = eventApplies( _EVL[idx] );
         }
     }
 
     setNextEvent();
-    saveToEEPROM();
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  setNextEvent()  –  compute _orderedSta / _nextChange / _nextSta
-//                     (verbatim logic from Gen2, enums adapted)
+//
+//  Collects the applicable events' [GMTbegin, GMTend) windows into _spans,
+//  merges overlapping / touching windows in one sorted pass, then looks up
+//  "now" with a binary search (EventIndex.h).  Produces the same result as the
+//  Gen2 fixed-point loop it replaces, without the O(N²) worst case.
 // ─────────────────────────────────────────────────────────────────────────────
 void EventManager::setNextEvent() {
     purgeEvents();   // removes stale events before computing schedule
 
-    time_t now       = Time.now();
-    time_t nullT     = now + 30L * 24 * 60 * 60;   // open-ended = now + 30 days
-    time_t mxEnd     = now;
-    time_t nxBeg     = nullT;
-    bool   inProgress = false;
-    bool   waiting    = false;
-
-    time_t begs[N_EVENTS] = {0};
-    time_t ends[N_EVENTS] = {0};
+    time_t now   = Time.now();
+    time_t nullT = now + 30L * 24 * 60 * 60;   // open-ended = now + 30 days
 
+    _nSpans      = 0;
+    _spanOpenEnd = nullT;
     for ( int idx = 0; idx < N_EVENTS; idx++ ) {
         if ( !_EVL[idx].applies ) continue;
 
-        begs[idx] = _EVL[idx].GMTbegin;
-        ends[idx] = ( _EVL[idx].GMTend == 0 ) ? nullT : _EVL[idx].GMTend;
+        time_t beg = _EVL[idx].GMTbegin;
+        time_t end = ( _EVL[idx].GMTend == 0 ) ? nullT : _EVL[idx].GMTend;
 
-        if ( begs[idx] > now ) {
-            waiting = true;
-            nxBeg = min( nxBeg, begs[idx] );
-        } else if ( begs[idx] > 0 && ends[idx] > now ) {
-            inProgress = true;
-            mxEnd = max( mxEnd, ends[idx] );
+        if ( beg > now || ( beg > 0 && end > now ) ) {
+            _spans[_nSpans].begin = beg;
+            _spans[_nSpans].end   = end;
+            _nSpans++;
         } else {
-            clearEvent( _EVL[idx] );
-        }
-    }
-
-    // Extend mxEnd to cover any event whose window overlaps the current mxEnd
-    bool changed = true;
-    while ( changed ) {
-        changed = false;
-        for ( int idx = 0; idx < N_EVENTS; idx++ ) {
-            if ( !_EVL[idx].applies ) continue;
-            if ( begs[idx] > now && begs[idx] <= mxEnd && ends[idx] > mxEnd ) {
-                mxEnd   = ends[idx];
-                changed = true;
-            }
+            clearEvent( _EVL[idx] );   // already over – nothing left to schedule
         }
     }
+    _nSpans = EventIndex::merge( _spans, _nSpans );
 
-    if ( inProgress ) {
-        _orderedSta  = FLAG_HALF;
-        _nextChange  = mxEnd;
-        _nextSta     = FLAG_FULL;
-    } else if ( waiting ) {
-        _orderedSta  = FLAG_FULL;
-        _nextChange  = nxBeg;
-        _nextSta     = FLAG_HALF;
-    } else {
-        _orderedSta  = FLAG_FULL;
-        _nextChange  = 0;
-        _nextSta     = FLAG_UNKNOWN;
-    }
+    _orderedSta = EventIndex::query( _spans, _nSpans, now, _nextChange, _nextSta );
 
     if ( _setStationCB ) {
         _setStationCB( _orderedSta );
@@ -475,20 +886,17 @@ void EventManager::setNextEvent() {
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  updEventTimer()  –  schedule next attention check
-//  Uses millis()-based software timer (no hardware Timer object in Gen3 design).
+//  Arms the _dlCheck deadline (no hardware Timer object in Gen3 design).
 //  Fires at the sooner of:
 //    a) 30 min before next sunrise
 //    b) _nextChange
+//    c) the next DST boundary (_nextDst)
 // ─────────────────────────────────────────────────────────────────────────────
 void EventManager::updEventTimer() {
     _attentionFlag = false;
 
-    time_t nowTime = Time.now();
-    struct tm sunDay;
-    sunDay = *gmtime( &nowTime );
-    sunDay.tm_hour = 0;
-    sunDay.tm_min  = 0;
-    sunDay.tm_sec  = 0;
+    time_t  nowTime = Time.now();
+    int32_t sunDay  = (int32_t)( nowTime / 86400 );   // today, UTC
 
     time_t nextCheck;
     int sunErr = getSunrise( nextCheck, sunDay );
@@ -496,12 +904,7 @@ void EventManager::updEventTimer() {
 
     if ( sunErr || nextCheck < nowTime ) {
         // Already past sunrise – try tomorrow
-        sunDay.tm_mday++;
-        sunDay.tm_hour = 0;
-        sunDay.tm_min  = 0;
-        sunDay.tm_sec  = 0;
-        mktime( &sunDay );   // normalize date (handles month rollover) and refresh tm_yday
-        sunErr = getSunrise( nextCheck, sunDay );
+        sunErr = getSunrise( nextCheck, sunDay + 1 );
         nextCheck -= 30 * 60;
     }
     if ( sunErr || nextCheck < nowTime ) {
@@ -511,71 +914,85 @@ void EventManager::updEventTimer() {
     // Use the earlier of sunrise-check and scheduled event change
     nextCheck = ( _nextChange == 0 ) ? nextCheck : min( nextCheck, _nextChange );
 
-    _msUntilNext  = (unsigned long)( (nextCheck - nowTime) * 1000UL );
-    _timerStartMs = millis();
+    // ...and the next DST boundary, where local-time marks are re-resolved
+    _nextDst = _tz.nextChange( nowTime );
+    if ( _nextDst == 0 && _doDST ) {
+        refreshTz();                          // table is behind the clock
+        _nextDst = _tz.nextChange( nowTime );
+    }
+    if ( _nextDst != 0 ) nextCheck = min( nextCheck, _nextDst );
+
+    // At least a second out, so a change landing on "now" is looked at again
+    // once the clock has moved rather than on every poll
+    time_t wait = max( nextCheck - nowTime, (time_t)1 );
+    deadlines.arm( _dlCheck, (uint32_t)min( wait, (time_t)( 0x7FFFFFFF / 1000 ) ) * 1000UL );
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  parseEvent()  –  decode incoming JSON event string into a FlagEventEx
+//  parseEvent()  –  decode one JSON event object into a FlagEventEx
 // ─────────────────────────────────────────────────────────────────────────────
-FlagEventEx EventManager::parseEvent( const String &json ) {
+FlagEventEx EventManager::parseEvent( const JTok *obj ) {
     FlagEventEx tEVL;
     tEVL.valid = true;
     tEVL.toSta = FLAG_HALF;   // default target station
 
-    JSONValue outerObj = JSONValue::parseCopy( json.c_str() );
-    JSONObjectIterator iter( outerObj );
+    if ( obj == nullptr || obj->type != JsonParserGeneratorRK::JSMN_OBJECT ) tEVL.valid = false;
 
-    while ( iter.next() ) {
-        String field = String( iter.name() ).toUpperCase();
+    char str[24];             // one field at a time: IDV, JUR / FLG, BMK / EMK
+    const JTok *key = obj ? obj + 1 : nullptr;
+    for ( int i = 0; tEVL.valid && i < obj->size; i++, key = jsonNext( key + 1 ) ) {
+        const JTok *val = key + 1;
 
-        if ( field == "IDV" ) {
-            String IDV  = String( iter.value().toString() );
-            int    pLoc = IDV.indexOf('.');
-            if ( pLoc < 0 ) { tEVL.valid = false; break; }
-            tEVL.eventID  = IDV.substring(0, pLoc).toInt();
+        if ( jsonKeyIs( key, "IDV" ) ) {
+            jsonStr( val, str, sizeof(str) );
+            const char *dot = strchr( str, '.' );
+            if ( dot == nullptr ) { tEVL.valid = false; break; }
+            tEVL.eventID  = atoi( str );          // stops at the '.'
             if ( tEVL.eventID <= 0 ) { tEVL.valid = false; break; }
-            tEVL.eventVer = IDV.substring(pLoc + 1).toInt();
-
-        } else if ( field == "JUR" ) {
-            tEVL.eventJur = String( iter.value().toString() );
-
-        } else if ( field == "FLG" ) {
-            tEVL.eventFlag = String( iter.value().toString() );
-
-        } else if ( field == "BMK" ) {
-            tEVL.BMK = String( iter.value().toString() );
-            if ( parseTimeMark( tEVL.GMTbegin, tEVL.BMK, "H" ) != 0 ) {
-                SFDBG::pub("EM", "EVT " + String(tEVL.eventID)
-                                + " tmk-fail BMK=" + tEVL.BMK, true);
+            tEVL.eventVer = atoi( dot + 1 );
+
+        } else if ( jsonKeyIs( key, "JUR" ) || jsonKeyIs( key, "FLG" ) ) {
+            jsonStr( val, str, sizeof(str) );
+            uint8_t code = intern( str, &tEVL );
+            if ( code == STR_NONE ) {
+                SFDBG::note( SFDBG::TAG_EM, SFDBG::INTERN_FULL, tEVL.eventID );
+                tEVL.jurCode = STR_NONE;          // tells applyEvent() the table is full
+                tEVL.valid = false; break;
+            }
+            if ( jsonKeyIs( key, "JUR" ) ) tEVL.jurCode  = code;
+            else                           tEVL.flagCode = code;
+
+        } else if ( jsonKeyIs( key, "BMK" ) ) {
+            jsonStr( val, str, sizeof(str) );
+            tEVL.BMK = TimeMarks::compile( str );
+            if ( parseTimeMark( tEVL.GMTbegin, tEVL.BMK, 'H' ) != 0 ) {
+                SFDBG::note( SFDBG::TAG_EM, SFDBG::BMK_FAIL, tEVL.eventID );
                 tEVL.valid = false; break;
             }
 
-        } else if ( field == "EMK" ) {
-            tEVL.EMK = String( iter.value().toString() );
-            if ( parseTimeMark( tEVL.GMTend, tEVL.EMK, "F" ) != 0 ) {
-                SFDBG::pub("EM", "EVT " + String(tEVL.eventID)
-                                + " tmk-fail EMK=" + tEVL.EMK, true);
+        } else if ( jsonKeyIs( key, "EMK" ) ) {
+            jsonStr( val, str, sizeof(str) );
+            tEVL.EMK = TimeMarks::compile( str );
+            if ( parseTimeMark( tEVL.GMTend, tEVL.EMK, 'F' ) != 0 ) {
+                SFDBG::note( SFDBG::TAG_EM, SFDBG::EMK_FAIL, tEVL.eventID );
                 tEVL.valid = false; break;
             }
 
-        } else if ( field == "DEL" ) {
-            tEVL.isDelete = iter.value().toBool();
+        } else if ( jsonKeyIs( key, "DEL" ) ) {
+            tEVL.isDelete = jsonBool( val );
 
-        } else if ( field == "SJR" ) {
+        } else if ( jsonKeyIs( key, "SJR" ) ) {
             // ── Gen3 sub-jurisdiction list ────────────────────────────────────
             // Expected JSON format:  "SJR": [12, 34, 56]
-            // JSONValue::isArray() check guards against scalar form.
-            JSONValue sjrVal = iter.value();
-            if ( sjrVal.isArray() ) {
-                JSONArrayIterator aIter( sjrVal );
-                while ( aIter.next() && tEVL.sjrCount < FlagEventEx::MAX_SJR ) {
-                    tEVL.sjrList[ tEVL.sjrCount++ ] = aIter.value().toInt();
+            if ( val->type == JsonParserGeneratorRK::JSMN_ARRAY ) {
+                const JTok *el = val + 1;
+                for ( int j = 0; j < val->size && tEVL.sjrCount < FlagEventEx::MAX_SJR; j++, el = jsonNext( el ) ) {
+                    tEVL.sjrList[ tEVL.sjrCount++ ] = (uint16_t)jsonInt( el );
                 }
             } else {
                 // Single value form: "SJR": 12
                 if ( tEVL.sjrCount < FlagEventEx::MAX_SJR ) {
-                    tEVL.sjrList[ tEVL.sjrCount++ ] = sjrVal.toInt();
+                    tEVL.sjrList[ tEVL.sjrCount++ ] = (uint16_t)jsonInt( val );
                 }
             }
         }
@@ -586,116 +1003,182 @@ FlagEventEx EventManager::parseEvent( const String &json ) {
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  Sun-time calculations (verbatim from Gen2)
+//  Sun-time calculations
+//
+//  UTCSunEvent() runs the kernel chosen by SF_FAST_SUN (SunCalc.h): the Gen2
+//  series verbatim, or the polynomial kernel, whose latitude terms are kept in
+//  _sunSite and recomputed only when the site changes.
 // ─────────────────────────────────────────────────────────────────────────────
 
 int EventManager::UTCSunEvent( float latitude, float longitude, int doy, int rs ) {
-    float rd     = 57.295779513082322f;
-    float lat    = latitude  / rd;
-    float lon    = -longitude / rd;
-    float zenith = 1.579522973054868f;
-
-    unsigned char a = rs ? 6 : 18;
-    float y    = 0.01721420632104f * (doy + a / 24.0f);
-    float eqt  = 229.18f * ( 0.000075f + 0.001868f*cosf(y)  - 0.032077f*sinf(y)
-                            - 0.014615f*cosf(y*2) - 0.040849f*sinf(y*2) );
-    float decl = 0.006918f - 0.399912f*cosf(y) + 0.070257f*sinf(y)
-               - 0.006758f*cosf(y*2) + 0.000907f*sinf(y*2)
-               - 0.002697f*cosf(y*3) + 0.00148f*sinf(y*3);
-    float ha   = cosf(zenith) / (cosf(lat)*cosf(decl)) - tanf(lat)*tanf(decl);
-
-    if ( fabsf(ha) <= 1.0f ) {
-        if ( rs ) {
-            return (int)( 60.0f * (720.0f + 4.0f*(lon - acosf(ha))*rd - eqt) );
-        } else {
-            return (int)( 60.0f * (720.0f + 4.0f*(lon + acosf(ha))*rd - eqt) );
+#if SF_FAST_SUN
+    if ( _sunSite.lat != latitude || _sunSite.lng != longitude ) {
+        _sunSite = SunCalc::site( latitude, longitude );
+    }
+    return SunCalc::fast( _sunSite, doy, rs );
+#else
+    return SunCalc::exact( latitude, longitude, doy, rs );
+#endif
+}
+
+//  sunEventCached()  –  UTCSunEvent() for the configured site, memoised by
+//  day-of-year.  Many stored events share a day, and every reprocess resolves
+//  each date-only / SR / SS mark again, so most lookups are repeats.
+int EventManager::sunEventCached( int doy, int rs ) {
+    rs = rs ? 1 : 0;
+    if ( _sunTabValid && doy >= 0 && doy < SUNTAB_DAYS ) {
+        _sunTableHits++;
+        uint16_t v = _sunTab.sec[rs][doy];
+        return ( v == SUNTAB_NONE ) ? SunCalc::NONE : (int)( _sunTab.base[rs] + v );
+    }
+
+    SunCacheEntry &e = _sunCache[ (unsigned)doy % SUN_CACHE_SIZE ];
+    if ( e.doy == doy && ( e.have & (1 << rs) ) ) {
+        _sunCacheHits++;
+        return e.sec[rs];
+    }
+
+    _sunCacheMisses++;
+    if ( e.doy != doy ) {
+        e.doy  = (int16_t)doy;
+        e.have = 0;
+    }
+    e.sec[rs] = UTCSunEvent( (float)_lat, (float)_lng, doy, rs );
+    e.have   |= (uint8_t)(1 << rs);
+    return e.sec[rs];
+}
+
+void EventManager::invalidateSunCache() {
+    for ( int i = 0; i < SUN_CACHE_SIZE; i++ ) {
+        _sunCache[i].doy  = -1;
+        _sunCache[i].have = 0;
+    }
+}
+
+//  buildSunTable()  –  fill _sunTab with UTCSunEvent() for all 366 days.
+//
+//  Sunrise falls within 12 h before local solar noon and sunset within 12 h
+//  after it (plus the equation of time, under 17 min), so one base per kind
+//  keeps every entry inside 16 bits at one-second resolution.  Returns false
+//  if a value still falls outside (table left invalid; the cache takes over).
+bool EventManager::buildSunTable() {
+    _sunTabValid = false;
+
+    int32_t noon = (int32_t)( 60.0f * ( 720.0f - 4.0f * (float)_lng ) );  // solar noon, s UTC
+    _sunTab.magic   = SUNTAB_MAGIC;
+    _sunTab.version = SUNTAB_VERSION;
+    _sunTab.flags   = 0;
+    _sunTab.LAT     = (float)_lat;
+    _sunTab.LNG     = (float)_lng;
+    _sunTab.base[0] = noon - 20 * 60;              // sunset
+    _sunTab.base[1] = noon - 12 * 3600 - 20 * 60;  // sunrise
+
+    for ( int rs = 0; rs < 2; rs++ ) {
+        for ( int doy = 0; doy < SUNTAB_DAYS; doy++ ) {
+            int t = UTCSunEvent( _sunTab.LAT, _sunTab.LNG, doy, rs );
+            if ( t == SunCalc::NONE ) { _sunTab.sec[rs][doy] = SUNTAB_NONE; continue; }
+            int32_t d = t - _sunTab.base[rs];
+            if ( d < 0 || d >= SUNTAB_NONE ) return false;
+            _sunTab.sec[rs][doy] = (uint16_t)d;
         }
     }
-    return 86401;   // polar condition – no sunrise/sunset (sentinel > 86400 s/day)
+    return true;
+}
+
+//  refreshSunTable()  –  make _sunTab match the current _lat/_lng, reusing the
+//  persisted copy when it was built for the same site.
+void EventManager::refreshSunTable() {
+    _sunTabValid = false;
+    if ( !_sunTabEnabled ) return;
+
+    readSunTable( _sunTab );
+    if ( _sunTab.magic == SUNTAB_MAGIC && _sunTab.version == SUNTAB_VERSION &&
+         _sunTab.LAT == (float)_lat && _sunTab.LNG == (float)_lng ) {
+        _sunTabValid = true;
+        return;
+    }
+
+    if ( buildSunTable() ) {
+        writeSunTable( _sunTab );
+        _sunTabValid = true;
+        SFDBG::pub("EM", "sun table rebuilt");
+    }
+}
+
+void EventManager::setSunTableEnabled( bool on ) {
+    _sunTabEnabled = on;
+    refreshSunTable();
 }
 
-int EventManager::getSunTime( time_t &tVal, struct tm &sTime, int srss ) {
-    int t = UTCSunEvent( (float)_lat, (float)_lng, sTime.tm_yday, srss );
+int EventManager::getSunTime( time_t &tVal, int32_t day, int srss ) {
+    int t = sunEventCached( CivilDate::yearDay( day ), srss );
     tVal = 0;
     if ( t < 0 || t > 86400 ) return (int)EMrc::BAD_SUNEVENT;   // polar or negative (wrong-sign longitude)
-    sTime.tm_sec  = t;        // t is seconds past midnight UTC
-    tVal = mktime( &sTime );
+    tVal = (time_t)day * 86400 + t;   // t is seconds past midnight UTC
     return (int)EMrc::SUCCESS;
 }
 
-int EventManager::getSunrise( time_t &tVal, struct tm &date ) {
-    return getSunTime( tVal, date, 1 );
+int EventManager::getSunrise( time_t &tVal, int32_t day ) {
+    return getSunTime( tVal, day, 1 );
 }
 
-int EventManager::getSunset( time_t &tVal, struct tm &date ) {
-    return getSunTime( tVal, date, 0 );
+int EventManager::getSunset( time_t &tVal, int32_t day ) {
+    return getSunTime( tVal, day, 0 );
 }
 
-int EventManager::getZTime( time_t &tVal, struct tm &sTime, const String &hhmm ) {
-    sTime.tm_hour = atoi( hhmm.substring(0, 2).c_str() );
-    sTime.tm_min  = atoi( hhmm.substring(3, 5).c_str() );
-    tVal = mktime( &sTime );
+int EventManager::getZTime( time_t &tVal, int32_t day, int minutes ) {
+    tVal = (time_t)day * 86400 + (time_t)minutes * 60;
     return (int)EMrc::SUCCESS;
 }
 
-int EventManager::getLTime( time_t &tVal, struct tm &sTime, const String &hhmm ) {
-    int rc = getZTime( tVal, sTime, hhmm );
+int EventManager::getLTime( time_t &tVal, int32_t day, int minutes ) {
+    time_t wall;
+    int rc = getZTime( wall, day, minutes );
     if ( rc == (int)EMrc::SUCCESS ) {
-        // TZOffset is negative for west longitudes; subtracting a negative offset adds
-        time_t secOffset = -(time_t)( _tzOffset * 3600.0f );
-        if ( _doDST && isDST(sTime.tm_mday, sTime.tm_mon + 1, sTime.tm_wday) ) {
-            secOffset -= 3600;
-        }
-        tVal += secOffset;
+        // _tz is built with the STD offset and, when DST is off, an empty rule
+        tVal = _tz.toUTC( wall );
     }
     return rc;
 }
 
-int EventManager::parseTimeMark( time_t &tVal, const String &mTime, const String &mDest ) {
-    if ( mTime == "TBD" ) { tVal = 0; return (int)EMrc::SUCCESS; }
-    if ( mTime.length() < 10 ) return (int)EMrc::PARSE_ERROR;
+//  refreshTz()  –  rebuild the DST transition table for the current year
+void EventManager::refreshTz() {
+    TzRule rule = _tzRule;
+    if ( !_doDST ) rule.saveMin = 0;
 
-    struct tm myTime;
-    memset( &myTime, 0, sizeof(myTime) );
-    myTime.tm_year = atoi( mTime.substring(0, 4).c_str() ) - 1900;
-    myTime.tm_mon  = atoi( mTime.substring(5, 7).c_str() ) - 1;
-    myTime.tm_mday = atoi( mTime.substring(8, 10).c_str() );
-    mktime( &myTime );   // fills tm_yday, needed for sun calculations
-
-    switch ( mTime.length() ) {
-        case 10:   // date only – sunrise or sunset by mDest
-            switch ( mDest.charAt(0) ) {
-                case 'H': return getSunrise( tVal, myTime );
-                case 'F': return getSunset ( tVal, myTime );
-                default:  return (int)EMrc::NOT_HF;
-            }
+    int year = CivilDate::civilFromDays( (int32_t)( Time.now() / 86400 ) ).year;
+    _tz.build( rule, (int)lroundf( _tzOffset * 60.0f ), year );
+}
 
-        case 13:   // date + SR or SS
-            if ( mTime.substring(11,13) == "SR" ) return getSunrise( tVal, myTime );
-            if ( mTime.substring(11,13) == "SS" ) return getSunset ( tVal, myTime );
-            return (int)EMrc::NOT_SRSS;
+//  parseTimeMark()  –  resolve a compiled mark to a GMT epoch.  @p dest is 'H'
+//  for a begin mark and 'F' for an end mark (date-only → sunrise / sunset).
+//  Pure arithmetic on the compiled fields; no string or struct tm work.
+int EventManager::parseTimeMark( time_t &tVal, const TimeMark &mark, char dest ) {
+    switch ( mark.kind ) {
+        case TMK_TBD:   tVal = 0; return (int)EMrc::SUCCESS;
+        case TMK_BAD:   return mark.err;
+        case TMK_OTHER: return (int)EMrc::SUCCESS;   // Gen2: unrecognised length leaves tVal as is
+        default:        break;
+    }
 
-        case 16:   // date + HH:MM (GMT default)
-            return getZTime( tVal, myTime, mTime.substring(11,16) );
+    int32_t day = TimeMarks::epochDay( mark );
 
-        case 17: { // date + HH:MM + Z or L
-            char ref = mTime.charAt(16);
-            if ( ref == 'Z' ) return getZTime( tVal, myTime, mTime.substring(11,16) );
-            if ( ref == 'L' ) return getLTime( tVal, myTime, mTime.substring(11,16) );
-            return (int)EMrc::NOT_ZL;
-        }
+    switch ( mark.kind ) {
+        case TMK_DATE:
+            switch ( dest ) {
+                case 'H': return getSunrise( tVal, day );
+                case 'F': return getSunset ( tVal, day );
+                default:  return (int)EMrc::NOT_HF;
+            }
+        case TMK_SR: return getSunrise( tVal, day );
+        case TMK_SS: return getSunset ( tVal, day );
+        case TMK_HM:
+        case TMK_Z:  return getZTime( tVal, day, mark.minutes );
+        case TMK_L:  return getLTime( tVal, day, mark.minutes );
     }
     return (int)EMrc::SUCCESS;
 }
 
-bool EventManager::isDST( int dayOfMonth, int month, int dayOfWeek ) {
-    if ( month < 3 || month > 11 ) return false;
-    if ( month > 3 && month < 11 ) return true;
-    int previousSunday = dayOfMonth - dayOfWeek;
-    if ( month == 3 ) return previousSunday >= 8;
-    return previousSunday <= 0;
-}
-
 // ─────────────────────────────────────────────────────────────────────────────
 //  Display helpers
 // ─────────────────────────────────────────────────────────────────────────────
@@ -719,9 +1202,15 @@ String EventManager::showConfig() {
         writer.name("LNG").value( _lng,    6 );
         writer.name("STD").value( _tzOffset, 1 );
         writer.name("DST").value( _doDST      );
+        char tzr[TzRules::MAX_LEN + 1];
+        TzRules::format( _tzRule, tzr, sizeof(tzr) );
+        writer.name("TZR").value( tzr         );
         writer.name("ZIP").value( _postalCode  );
         writer.name("FED").value( _jurFederal  );
         writer.name("STA").value( _jurState    );
+        writer.name("SUB").beginArray();
+        for ( int i = 0; i < SUB_MAX; i++ ) if ( _jurExtra[i].length() ) writer.value( _jurExtra[i] );
+        writer.endArray();
         writer.name("FPR").value( _upperFlagPrio );
         writer.name("FLG").value( _upperFlag   );
         writer.name("SJR").beginArray();
@@ -744,15 +1233,15 @@ String EventManager::showEvent( const FlagEventEx &ev ) {
         if ( ev.eventID > 0 ) {
             if ( ev.GMTbegin > 0 ) writer.name("BMK").value( Time.format(ev.GMTbegin) );
             else                   writer.name("BMK").nullValue();
-            writer.name("JUR").value( ev.eventJur  );
-            writer.name("FLG").value( ev.eventFlag );
+            writer.name("JUR").value( codeStr(ev.jurCode)  );
+            writer.name("FLG").value( codeStr(ev.flagCode) );
             if ( ev.GMTend > 0 )   writer.name("EMK").value( Time.format(ev.GMTend) );
             else                   writer.name("EMK").nullValue();
             writer.name("STA").value( staToLetter(ev.toSta) );
             // SJR list
             if ( ev.sjrCount > 0 ) {
                 writer.name("SJR").beginArray();
-                for ( int i = 0; i < ev.sjrCount; i++ ) writer.value( ev.sjrList[i] );
+                for ( int i = 0; i < ev.sjrCount; i++ ) writer.value( (int)ev.sjrList[i] );
                 writer.endArray();
             }
         }
@@ -761,14 +1250,26 @@ String EventManager::showEvent( const FlagEventEx &ev ) {
     return String(buf);
 }
 
+//  setEventListPage() / showEventList()  –  paged slot list (s_EventLIST)
+int EventManager::setEventListPage( int page ) {
+    _elPage = max( page, 0 );
+    return _elPage;
+}
+
 String EventManager::showEventList() {
+    const int pages = ( N_EVENTS + EL_PAGE - 1 ) / EL_PAGE;
+    const int first = _elPage * EL_PAGE;
+    const int last  = min( first + EL_PAGE, (int)N_EVENTS );
+
     char buf[JSON_BUF];
     memset( buf, 0, sizeof(buf) );
     JSONBufferWriter writer( buf, sizeof(buf) - 1 );
 
     writer.beginObject();
+        writer.name("P").value( _elPage );
+        writer.name("NP").value( pages );
         writer.name("EVL").beginArray();
-        for ( int idx = 0; idx < N_EVENTS; idx++ ) {
+        for ( int idx = first; idx < last; idx++ ) {
             if ( _EVL[idx].eventID > 0 && _EVL[idx].valid ) {
                 writer.value( String::format("%d.%d", _EVL[idx].eventID, _EVL[idx].eventVer) );
             } else {
@@ -785,6 +1286,50 @@ String EventManager::showEventList() {
 //  Ring-buffer event inspector
 // ─────────────────────────────────────────────────────────────────────────────
 
+//  setTimelinePage() / showTimeline()  –  paged forward schedule (s_Timeline)
+int EventManager::setTimelinePage( int page, int days ) {
+    if ( days > 0 ) _tlDays = min( days, (int)TL_DAYS_MAX );
+    _tlPage = max( page, 0 );
+    return _tlPage;
+}
+
+String EventManager::showTimeline() {
+    time_t now = Time.now();
+    time_t to  = now + (time_t)_tlDays * 24 * 60 * 60;
+
+    time_t      nextChange;
+    FlagStation nextSta;
+    FlagStation nowSta = EventIndex::query( _spans, _nSpans, now, nextChange, nextSta );
+
+    EventTransition tr[TL_PAGE];
+    int total = EventIndex::transitions( _spans, _nSpans, now, to, _spanOpenEnd,
+                                         tr, _tlPage * TL_PAGE, TL_PAGE );
+    int pages = ( total + TL_PAGE - 1 ) / TL_PAGE;
+    int shown = min( max( total - _tlPage * TL_PAGE, 0 ), (int)TL_PAGE );
+
+    char buf[JSON_BUF];
+    memset( buf, 0, sizeof(buf) );
+    JSONBufferWriter writer( buf, sizeof(buf) - 1 );
+
+    writer.beginObject();
+        writer.name("T").value( (unsigned int)now );
+        writer.name("D").value( _tlDays );
+        writer.name("S").value( staToLetter(nowSta) );
+        writer.name("P").value( _tlPage );
+        writer.name("NP").value( pages );
+        writer.name("TR").beginArray();
+        for ( int i = 0; i < shown; i++ ) {
+            writer.beginArray();
+                writer.value( (unsigned int)tr[i].at );
+                writer.value( staToLetter(tr[i].sta) );
+            writer.endArray();
+        }
+        writer.endArray();
+    writer.endObject();
+
+    return String(buf);
+}
+
 int EventManager::setShowIdx( int idx ) {
     if ( idx < 0 )        idx = 0;
     if ( idx >= N_EVENTS ) idx = N_EVENTS - 1;
@@ -843,8 +1388,10 @@ int EventManager::firstActiveEvent() {
 //  loadConfig()  –  pull configuration from EEPROMManager into local cache
 //  Called at setup() and can be re-called after an external config change.
 void EventManager::loadConfig() {
-    ConfigData cfg;
-    readConfig( cfg );
+    const ConfigData &cfg = configData();
+    if ( (double)cfg.LAT != _lat || (double)cfg.LNG != _lng ) {
+        invalidateSunCache();
+    }
     _upperFlag     = String( cfg.FLG );
     _upperFlagPrio = cfg.FPR;
     _lat           = cfg.LAT;
@@ -854,57 +1401,87 @@ void EventManager::loadConfig() {
     _postalCode    = String( cfg.ZIP );
     _tzOffset      = cfg.STD;
     _doDST         = cfg.DST;
+    refreshSunTable();
 
-    // Load unit SJR list from ConfigExt
-    ConfigExt x;
-    readConfigExt( x );
+    // Load unit SJR list and DST rule from ConfigExt
+    const ConfigExt &x = configExt();
     _sjrCount = 0;
     memset( _sjrList, 0, sizeof(_sjrList) );
+    _tzRule = TzRules::northAmerica();
+    for ( int i = 0; i < SUB_MAX; i++ ) _jurExtra[i] = "";
     if ( x.magic == CFGX_MAGIC && x.version == CFGX_VERSION ) {
         int n = min( (int)x.sjrCount, 5 );
         for ( int i = 0; i < n; i++ ) _sjrList[i] = x.sjrList[i];
         _sjrCount = n;
+        if ( x.flags & CFGX_FLAG_TZRULE ) _tzRule = x.tzRule;
+        for ( int i = 0; i < SUB_MAX && ( x.flags & CFGX_FLAG_SUB ); i++ ) {
+            char t[sizeof(x.subTopics[i]) + 1] = {0};
+            memcpy( t, x.subTopics[i], sizeof(x.subTopics[i]) );
+            _jurExtra[i] = t;
+        }
     }
+    refreshTz();
 }
 
 //  loadFromEEPROM()  –  restore saved event list
 //
-//  FlagEvent persists: idv, flg, bmk, emk, jur, sjrCount, sjrList[].
-//  All fields required by eventApplies() survive reboots intact.
+//  Each PackedEvent carries the ID, version, compiled marks, JUR / FLG as
+//  EventStrings indices and its SJR list, so every field eventApplies() needs
+//  survives reboots and loading does no parsing.  Records are restored into
+//  slots 0..n-1 in stored order.
+//
+//  A record whose crc8 does not match is skipped; its length byte is trusted
+//  only while plausible, and readEventTable() stops at the first one that is
+//  not (nothing after it can be located).
 int EventManager::loadFromEEPROM() {
-    EventHeader hdr;
-    readEventHeader( hdr );
-
-    if ( hdr.eventCount == 0 || hdr.eventCount > (uint8_t)N_EVENTS ) return 0;
-
-    for ( int i = 0; i < N_EVENTS; i++ ) {
-        _EVL[i] = FlagEventEx();   // clear first
-
-        FlagEvent stored;
-        if ( !readEvent( i, stored ) ) continue;
-        if ( stored.idv[0] == '\0'  ) continue;   // empty slot
-
-        String idvStr = String( stored.idv );
-        int pLoc = idvStr.indexOf('.');
-        if ( pLoc < 0 ) continue;
+    EventHeader  hdr;
+    EventStrings tab;
+    PackedEvent *recs  = s_evIO.recs;
+    int          nRecs = readEventTable( hdr, tab, recs, N_EVENTS );
+    if ( hdr.eventCount == 0 ) return 0;
+
+    uint8_t codes[EVS_STR_N];
+    memset( codes, STR_NONE, sizeof(codes) );
+
+    _evDigest = 0;
+    for ( int i = 0; i < N_EVENTS; i++ ) _EVL[i] = FlagEventEx();
+
+    int slot = 0;
+    for ( int n = 0; n < nRecs; n++ ) {
+        const PackedEvent &rec = recs[n];
+        if ( rec.crc8 != packedCRC( rec ) ) {
+            _evCorruptSlots++;
+            SFDBG::note( SFDBG::TAG_EM, SFDBG::SLOT_CRC_FAIL, n );
+            continue;
+        }
 
-        int evID = idvStr.substring(0, pLoc).toInt();
-        if ( evID <= 0 ) continue;
+        int32_t evID = (int32_t)( (uint32_t)rec.idHi << 16 | rec.idLo );
+        if ( evID <= 0 || rec.jur >= EVS_STR_N || rec.flg >= EVS_STR_N ) continue;
 
-        _EVL[i].valid      = true;
-        _EVL[i].eventID    = evID;
-        _EVL[i].eventVer   = idvStr.substring(pLoc + 1).toInt();
-        _EVL[i].eventFlag  = String( stored.flg );
-        _EVL[i].BMK        = String( stored.bmk );
-        _EVL[i].EMK        = String( stored.emk );
-        _EVL[i].eventJur   = String( stored.jur );
+        for ( uint8_t k : { rec.jur, rec.flg } ) {
+            if ( codes[k] != STR_NONE ) continue;
+            char str[EVS_STR_LEN + 1] = {0};
+            memcpy( str, tab.s[k], EVS_STR_LEN );
+            codes[k] = intern( str );
+        }
+        if ( codes[rec.jur] == STR_NONE || codes[rec.flg] == STR_NONE ) continue;
+
+        FlagEventEx &ev = _EVL[slot++];
+        ev.valid    = true;
+        ev.toSta    = FLAG_HALF;   // not persisted; every event targets half-staff
+        ev.eventID  = evID;
+        ev.eventVer = rec.ver;
+        ev.flagCode = codes[rec.flg];
+        ev.jurCode  = codes[rec.jur];
+        ev.BMK      = unpackMark( rec.bmk );
+        ev.EMK      = unpackMark( rec.emk );
 
         // Restore sub-jurisdiction list
-        int nSjr = min( (int)stored.sjrCount, FlagEventEx::MAX_SJR );
-        _EVL[i].sjrCount = nSjr;
-        for ( int j = 0; j < nSjr; j++ ) {
-            _EVL[i].sjrList[j] = (int)stored.sjrList[j];
+        ev.sjrCount = (uint8_t)min( ( rec.len - PACKED_EVENT_BASE ) / 2, FlagEventEx::MAX_SJR );
+        for ( int j = 0; j < ev.sjrCount; j++ ) {
+            ev.sjrList[j] = rec.sjrList[j];
         }
+        _evDigest ^= pairDigest( evID, ev.eventVer );
     }
 
     return 0;
@@ -912,42 +1489,66 @@ int EventManager::loadFromEEPROM() {
 
 //  saveToEEPROM()  –  persist current event list
 //
-//  Stores all FlagEvent fields: idv, flg, bmk, emk, jur, sjrCount, sjrList[].
-//  Up to 7 SJR entries are stored (uint16_t each); entries beyond 7 are dropped
-//  (no real-world event is expected to carry more than 7 sub-jurisdictions).
+//  JUR / FLG text goes to the EventStrings table, keeping the index of any
+//  string already there, and each valid slot becomes one PackedEvent; the
+//  table goes out in one writeEventTable() call.  Only bytes that differ are
+//  written and the header only when the count changes, so calls with nothing
+//  new cost reads only.  Deleting an event moves every later record down,
+//  which rewrites them.
+//
+//  The string table holds every string intern() accepted and applyEvent()
+//  keeps the records within the record area, so every event is stored; one
+//  with no packed form is kept in RAM only (SFDBG::NOT_STORED).
+//
+//  Entries the records on EEPROM still reference are pinned (eventStringRefs())
+//  and not reused in the same flush.  If that leaves no entry for a new string,
+//  the table is first saved without the events needing one; once those
+//  records are on EEPROM the pins are released and the second pass stores all.
 int EventManager::saveToEEPROM() {
-    int count = 0;
+    _evSaveCalls++;
 
+    const char **strs = s_evIO.strs;
+    int         *idx  = s_evIO.idx;
     for ( int i = 0; i < N_EVENTS; i++ ) {
-        FlagEvent stored;
-        memset( &stored, 0, sizeof(stored) );
-
-        if ( _EVL[i].valid && _EVL[i].eventID > 0 ) {
-            snprintf( stored.idv, sizeof(stored.idv), "%d.%d",
-                      _EVL[i].eventID, _EVL[i].eventVer );
-            strncpy( stored.flg, _EVL[i].eventFlag.c_str(), sizeof(stored.flg) - 1 );
-            strncpy( stored.bmk, _EVL[i].BMK.c_str(),       sizeof(stored.bmk) - 1 );
-            strncpy( stored.emk, _EVL[i].EMK.c_str(),       sizeof(stored.emk) - 1 );
-            strncpy( stored.jur, _EVL[i].eventJur.c_str(),  sizeof(stored.jur) - 1 );
-
-            // Persist sub-jurisdiction list (clamped to 7 entries)
-            int nSjr = min( _EVL[i].sjrCount, 7 );
-            stored.sjrCount = (uint8_t)nSjr;
-            for ( int j = 0; j < nSjr; j++ ) {
-                stored.sjrList[j] = (uint16_t)_EVL[i].sjrList[j];
+        strs[2 * i]     = codeStr( _EVL[i].jurCode );
+        strs[2 * i + 1] = codeStr( _EVL[i].flagCode );
+        if ( !_EVL[i].valid || _EVL[i].eventID <= 0 ) strs[2 * i] = strs[2 * i + 1] = "";
+    }
+    PackedEvent *recs = s_evIO.recs;
+    int32_t     *ids  = s_evIO.ids;
+    for ( int pass = 0; pass < 2; pass++ ) {
+        EventStrings tab;
+        uint32_t pinned = eventStringRefs();
+        readEventStrings( tab );
+        layoutEventStrings( tab, strs, 2 * N_EVENTS, idx, pinned );
+
+        bool deferred = false;              // an event waits for a pinned entry
+        for ( int k = 0; k < 2 * N_EVENTS; k++ ) deferred |= ( idx[k] < 0 );
+        deferred &= ( pass == 0 );
+
+        int n = 0;
+        for ( int i = 0; i < N_EVENTS; i++ ) {
+            const FlagEventEx &ev = _EVL[i];
+            if ( !ev.valid || ev.eventID <= 0 ) continue;
+            if ( deferred && ( idx[2 * i] < 0 || idx[2 * i + 1] < 0 ) ) continue;
+
+            if ( idx[2 * i] < 0 || idx[2 * i + 1] < 0 ||
+                 !packEvent( recs[n], ev.eventID, ev.eventVer, ev.BMK, ev.EMK,
+                             (uint8_t)idx[2 * i], (uint8_t)idx[2 * i + 1], ev.sjrList, ev.sjrCount ) ) {
+                if ( !deferred ) SFDBG::note( SFDBG::TAG_EM, SFDBG::NOT_STORED, ev.eventID );
+                continue;
             }
-
-            stored.deleted = 0;
-            count++;
+            ids[n++] = ev.eventID;
         }
 
-        writeEvent( i, stored );
+        EventTableWrite w = writeEventTable( tab, recs, n );
+        for ( int i = w.stored; i < n && !deferred; i++ ) {
+            SFDBG::note( SFDBG::TAG_EM, SFDBG::NOT_STORED, ids[i] );   // record area full
+        }
+        _evSlotWrites   += (uint32_t)w.recsWritten;
+        _evBytesWritten += (uint32_t)w.bytesWritten;
+        if ( !deferred ) break;
     }
 
-    EventHeader hdr;
-    memset( &hdr, 0, sizeof(hdr) );
-    hdr.eventCount = (uint8_t)count;
-    writeEventHeader( hdr );
-
     return 0;
 }
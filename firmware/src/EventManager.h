@@ -10,24 +10,25 @@
  *  - SFSta::FULL / SFSta::HALF  →  FLAG_FULL / FLAG_HALF  (FlagStation, HalyardManager.h)
  *  - myDirector.setOrderedSta() →  halMgr1.setOrderedStation()  (via _setStationCB)
  *  - EEPROM I/O                 →  EEPROMManager helpers  (EEPROM_ADDR_EVENT_HDR / _LIST)
- *  - myLink.resetSubscriptions()→  evMgr.resetSubscriptions()
- *  - s_EEevent                  →  FlagEvent struct in EEPROMManager.h
+ *  - myLink.resetSubscriptions()→  evMgr.updateSubscriptions()
+ *  - s_EEevent                  →  PackedEvent record in EEPROMManager.h
  *  - Sub-jurisdiction filtering →  NEW — SJR[] in event JSON; sjrID in ConfigExt
  *
  * **Subscription design:**
- * Each unit subscribes to exactly two Particle topics whose full names are
- * stored directly in config (e.g. @c "FE-US", @c "FE-UT").  No prefix is
- * added by the firmware, allowing alternative prefixes or extensions in the
- * future.  Both topics route through the file-scope @c sfEventHandler()
- * forwarder to @c EventManager::receiveEvent().
+ * Each unit follows its federal and state topics plus up to two extra
+ * jurisdiction topics (@c SUB), whose full names are stored directly in
+ * config (e.g. @c "FE-US", @c "FE-UT").  No prefix is added by the firmware,
+ * allowing alternative prefixes or extensions in the future.
+ * @c updateSubscriptions() hands that set to the subscription registry
+ * (Subscriptions.h), which routes every topic to @c EventManager::onEvent()
+ * and only touches Particle subscriptions for topics that are actually new.
  *
  * @c eventApplies() performs the second-level filter using a prefix match on
- * the event JSON @c JUR field against @c jurFederal / @c jurState: a more
+ * the event JSON @c JUR field against the configured topics: a more
  * specific published jurisdiction (e.g. @c "FE-UT-X") matches a less specific
  * subscription (@c "FE-UT"), but a less specific publish never matches a more
- * specific subscription.  Whenever @c jurFederal or @c jurState changes,
- * @c resetSubscriptions() drops all subscriptions and re-registers the two
- * correct topics.
+ * specific subscription.  Whenever @c FED, @c STA or @c SUB changes,
+ * @c updateSubscriptions() declares the new set.
  */
 
 #pragma once
@@ -36,7 +37,27 @@
 #include "math.h"
 
 #include "HalyardManager.h"   // FlagStation enum
-#include "EEPROMManager.h"    // FlagEvent struct, EEPROM addresses
+#include "EEPROMManager.h"    // PackedEvent record, EEPROM addresses
+#include "EventIndex.h"       // EventSpan, merged schedule lookup
+#include "TimeMark.h"         // compiled BMK / EMK
+#include "TzRule.h"           // DST rule + transition table for local-time marks
+#include "Deadlines.h"        // attention-check deadline
+#include "Subscriptions.h"    // topic routing
+#include "SunCalc.h"          // sunrise/sunset kernels
+#include "JsonParserGeneratorRK.h"   // jsmn tokens for inbound JSON
+#include <type_traits>
+
+// Build the per-site annual sunrise/sunset table (SunTable, persisted above the
+// 2 KB working image).  0 = resolve sun marks through the day-of-year cache only.
+#ifndef SF_SUN_TABLE
+#define SF_SUN_TABLE 1
+#endif
+
+// Sunrise/sunset kernel behind UTCSunEvent(): 0 = Gen2 libm series
+// (SunCalc::exact), 1 = polynomial kernel within SunCalc::FAST_MAX_ERR_S.
+#ifndef SF_FAST_SUN
+#define SF_FAST_SUN 0
+#endif
 
 // ─────────────────────────────────────────────────────────────────────────────
 /**
@@ -58,43 +79,72 @@ enum class EMrc : int {
     EVL_OVERFLOW  = 7
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+/**
+ * @enum  EvDirty
+ * @brief Why an @c _EVL slot needs recomputing (bit flags, OR-able per slot).
+ *
+ * @c processDirty() does only the work each reason invalidates:
+ *  - @c EVD_EVENT  – slot written by receiveEvent(): resolve marks + applicability
+ *  - @c EVD_CONFIG – FED / STA / FLG / SJR changed: applicability only
+ *  - @c EVD_TIME   – LAT/LNG or STD changed: re-resolve sun or local-time marks
+ *  - @c EVD_DST    – DST observance or rule changed, or a DST boundary
+ *                    passed: re-resolve local-time marks
+ * A clock jump (time_changed) marks every slot EVD_TIME | EVD_DST: the marks
+ * move, the cached @c applies bit does not.
+ */
+enum EvDirty : uint8_t {
+    EVD_NONE   = 0x00,
+    EVD_EVENT  = 0x01,
+    EVD_CONFIG = 0x02,
+    EVD_TIME   = 0x04,
+    EVD_DST    = 0x08,
+    EVD_ALL    = 0x0F
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 /**
  * @class  FlagEventEx
  * @brief  In-RAM representation of a single flag-raising event.
  *
  * @details
- * Extends the on-disk @c FlagEvent POD (EEPROMManager.h) with derived and
+ * Extends the on-disk @c PackedEvent record (EEPROMManager.h) with derived and
  * runtime-only fields that are not persisted: @c valid, @c applies, @c isDelete,
  * and the resolved @c GMTbegin / @c GMTend epoch timestamps.
  *
- * Raw time-mark strings (@c BMK, @c EMK) are retained so that events whose
- * marks reference sunrise/sunset can be re-resolved by @c reprocessEvents()
- * whenever the clock is corrected or DST transitions.
- *
- * The @c sjrList / @c sjrCount fields are Gen3-only, carrying the optional list
- * of sub-jurisdiction IDs from the event JSON @c SJR field.
+ * The record is fixed-size and trivially copyable, so filling, copying and
+ * clearing a slot never touches the heap:
+ *  - @c BMK / @c EMK are compiled @c TimeMark structs (TimeMark.h), kept so
+ *    that sun and local-time marks can be re-resolved by @c reprocessEvents()
+ *    whenever the clock, site or DST settings change.
+ *  - @c jurCode / @c flagCode are indices into EventManager's string intern
+ *    table; @c EventManager::codeStr() returns the text.
+ *  - @c sjrList holds the optional Gen3 sub-jurisdiction IDs as uint16_t,
+ *    capped at the 7 entries PackedEvent can persist.
  */
 class FlagEventEx {
 public:
-    bool         valid      = false;        // true after successful parse
-    bool         applies    = false;        // true if event applies to this unit
-    bool         isDelete   = false;        // true if JSON DEL field is true
-    int          eventID    = 0;            // IDV – main event ID
-    int          eventVer   = 0;            // idV – version number
     time_t       GMTbegin   = 0;            // resolved GMT begin epoch
     time_t       GMTend     = 0;            // resolved GMT end epoch (0 = open-ended)
-    String       eventJur   = "";           // JUR – published jurisdiction
-    String       eventFlag  = "";           // FLG – published flag abbr. (e.g. "US", "TN")
-    FlagStation  toSta      = FLAG_UNKNOWN; // target station; HALF assumed for standard events
-    String       BMK        = "";           // raw begin time-mark string
-    String       EMK        = "";           // raw end time-mark string
+    int32_t      eventID    = 0;            // IDV – main event ID
+    int32_t      eventVer   = 0;            // idV – version number
+    TimeMark     BMK        = {};           // compiled begin time mark
+    TimeMark     EMK        = {};           // compiled end time mark
 
     // Sub-jurisdiction list (NEW – Gen3 only)
-    static const int MAX_SJR = 10;
-    int          sjrList[MAX_SJR] = {0};    // SJR[] – sub-jurisdiction IDs from event JSON
-    int          sjrCount   = 0;            // number of valid entries in sjrList
+    static const int MAX_SJR = 7;
+    uint16_t     sjrList[MAX_SJR] = {0};    // SJR[] – sub-jurisdiction IDs from event JSON
+    uint8_t      sjrCount   = 0;            // number of valid entries in sjrList
+
+    uint8_t      jurCode    = 0;            // JUR – interned published jurisdiction
+    uint8_t      flagCode   = 0;            // FLG – interned flag abbr. (e.g. "US", "TN")
+    FlagStation  toSta      = FLAG_UNKNOWN; // target station; HALF assumed for standard events
+    bool         valid      = false;        // true after successful parse
+    bool         applies    = false;        // true if event applies to this unit (cached, see EvDirty)
+    bool         isDelete   = false;        // true if JSON DEL field is true
 };
+static_assert( std::is_trivially_copyable<FlagEventEx>::value,
+               "FlagEventEx must stay heap-free and trivially copyable" );
 
 // ─────────────────────────────────────────────────────────────────────────────
 /**
@@ -107,11 +157,16 @@ public:
  *
  *  1. @c setup() — called once from @c main.ino setup(); loads config and events
  *     from EEPROM, registers Particle cloud variables, and subscribes to topics.
- *  2. @c loop()  — called every @c loop(); fires the software timer and calls
- *     @c checkForChange() when the next scheduled transition is due.
+ *  2. @c loop()  — called every @c loop(); calls @c checkForChange() once the
+ *     check deadline armed by @c updEventTimer() (see Deadlines.h) has fired.
  *  3. @c reprocessEvents() — called from the @c time_changed system event hook
  *     to re-resolve sunrise/sunset marks after a clock correction.
  *
+ * Everything else is incremental: receiveEvent() and configScheduler() tag the
+ * affected slots in @c _dirty[] with an @c EvDirty reason and @c processDirty()
+ * recomputes only those; a timer-driven checkForChange() only re-runs the
+ * schedule over the already-resolved windows.
+ *
  * The station-change callback passed to @c setup() decouples EventManager from
  * HalyardManager: the callback is typically a lambda that calls
  * @c halMgr1.setOrderedStation(sta).
@@ -120,7 +175,12 @@ class EventManager {
 
 public:
     // ── Constants ────────────────────────────────────────────────────────────
-    static const int  N_EVENTS     = 20;     // maximum stored events
+    static const int  N_EVENTS     = 4 * EVENT_V3_MAX;   // maximum stored events (80)
+    static const int  EL_PAGE      = 20;     // s_EventLIST slots per page
+    static const int  HAVE_PAGE    = 24;     // s_EvHave entries per page
+    static const int  TL_PAGE      = 24;     // s_Timeline changes per page
+    static const int  TL_DAYS      = 7;      // default s_Timeline horizon
+    static const int  TL_DAYS_MAX  = 30;     // open-ended events are capped at now + 30 days
     static const char FED_FLAG[3]; // "US"  – federal flag abbreviation
 
     // ── Constructor / destructor ─────────────────────────────────────────────
@@ -135,30 +195,41 @@ public:
     ///         Particle.connect() (subscribes to configured topics immediately).
     void setup( void (*setStationCB)(FlagStation) );
 
-    /// @brief  Call every loop().  Checks the software timer and fires
-    ///         checkForChange() → reprocessEvents() when a transition is due.
+    /// @brief  Call every loop(), after deadlines.poll().  Runs checkForChange()
+    ///         when the check deadline has fired; otherwise returns at once.
     void loop();
 
     // ── Public API (Particle cloud functions / subscriptions) ─────────────────
 
-    /// @brief  Internal target for Particle subscription callbacks.
-    ///         NOT registered with Particle directly — the file-scope
-    ///         @c sfEventHandler() forwarder in EventManager.cpp calls this,
-    ///         working around the capturing-lambda limitation of the subscribe API.
+    /// @brief  Target for jurisdiction-topic events.  Not registered with
+    ///         Particle directly — the subscription registry routes each topic
+    ///         through @c onEvent(), which calls this.
     /// @return 0 (@c EMrc::SUCCESS) or a non-zero @c EMrc cast to int on error.
-    int    receiveEvent       ( String JSONFlagEvent );
+    int    receiveEvent       ( const char *JSONFlagEvent );
+    int    receiveEvent       ( const String &JSONFlagEvent ) { return receiveEvent( JSONFlagEvent.c_str() ); }
+
+    /// @brief  Batch form of receiveEvent() for catch-up after an offline period.
+    ///         Applies every object in the JSON array @p JSONFlagEvents, then
+    ///         reprocesses, persists and publishes one "EVT" status for the batch.
+    ///         Reached through s_InjectEv when its argument is an array.
+    /// @param  rcOut  optional per-entry EMrc codes (first @p rcMax entries);
+    ///                the last batch's codes are also readable as s_BatchRC.
+    /// @return 0 if every entry succeeded, GENFAIL if any failed, PARSE_ERROR
+    ///         if the payload is not an array.
+    int    receiveEvents      ( const String &JSONFlagEvents, int *rcOut = nullptr, int rcMax = 0 );
 
     /// @brief  Particle.function() target registered as @c "s_Config" in main.ino.
     ///         Updates config fields from JSON (LAT, LNG, STD, DST, ZIP, FED, STA,
-    ///         FPR, FLG, SJR) and calls resetSubscriptions() if jurisdictions change.
-    /// @return 0 (@c EMrc::SUCCESS).
-    int    configScheduler    ( String JSONconfig    );
+    ///         SUB, FPR, FLG, SJR) and calls updateSubscriptions() if jurisdictions change.
+    /// @return 0 (@c EMrc::SUCCESS), or PARSE_ERROR if @p JSONconfig is not a
+    ///         JSON object (nothing is changed).
+    int    configScheduler    ( const String &JSONconfig );
 
-    /// @brief  Drops all Particle subscriptions (unsubscribe is all-or-nothing)
-    ///         and re-registers for the configured federal and state topic strings.
-    ///         Called internally by setup() and configScheduler(); main.ino does
-    ///         not need to call this directly.
-    void   resetSubscriptions ();
+    /// @brief  Declares the configured FED, STA and SUB topics to the
+    ///         subscription registry, which subscribes only to topics it does
+    ///         not already hold.  Called internally by setup() and
+    ///         configScheduler(); main.ino does not need to call this directly.
+    void   updateSubscriptions();
 
     // ── Query helpers ─────────────────────────────────────────────────────────
     /// @brief  Count of currently valid, applicable events in @c _EVL[].
@@ -174,13 +245,73 @@ public:
     /// @brief  Station the flag should be at RIGHT NOW according to the schedule.
     FlagStation orderedStation   () const { return _orderedSta; }
 
+    // ── Profiling counters ────────────────────────────────────────────────────
+    /// @brief  Sunrise/sunset lookups answered from the day-of-year cache.
+    uint32_t    sunCacheHits     () const { return _sunCacheHits;   }
+    /// @brief  Sunrise/sunset lookups that ran the full UTCSunEvent() series.
+    uint32_t    sunCacheMisses   () const { return _sunCacheMisses; }
+    /// @brief  Sunrise/sunset lookups answered from the annual sun table.
+    uint32_t    sunTableHits     () const { return _sunTableHits;   }
+    /// @brief  Time-mark pairs resolved (parseTimeMark() on BMK + EMK).
+    uint32_t    markResolutions  () const { return _markResolutions; }
+    /// @brief  eventApplies() evaluations.
+    uint32_t    applyChecks      () const { return _applyChecks;     }
+    /// @brief  saveToEEPROM() calls.
+    uint32_t    eventSaveCalls   () const { return _evSaveCalls;     }
+    /// @brief  PackedEvent records physically rewritten by saveToEEPROM().
+    uint32_t    eventSlotWrites  () const { return _evSlotWrites;    }
+    /// @brief  Bytes written to EEPROM for the event table (strings, records, header).
+    ///         Divide by eventSaveCalls() for write amplification per save.
+    uint32_t    eventBytesWritten() const { return _evBytesWritten;  }
+    /// @brief  DST boundaries the timer stopped at to re-resolve local-time marks.
+    uint32_t    dstBoundaries    () const { return _dstBoundaries;  }
+    /// @brief  Next DST transition the timer will stop at (0 if DST is off).
+    time_t      nextDstChange    () const { return _nextDst;        }
+    /// @brief  Records skipped by loadFromEEPROM() because their CRC did not match.
+    uint32_t    corruptSlotsSkipped() const { return _evCorruptSlots; }
+    /// @brief  True while the annual sun table matches the configured LAT/LNG.
+    bool        sunTableActive   () const { return _sunTabValid;    }
+    /// @brief  Enable / disable the annual sun table at runtime (default SF_SUN_TABLE).
+    ///         Enabling loads the persisted table or rebuilds it for the current site.
+    void        setSunTableEnabled( bool on );
+
     // ── Display / diagnostics ─────────────────────────────────────────────────
     /// @brief  JSON string of current scheduler config (Particle variable payload).
     String showConfig   ();
     /// @brief  JSON string of full detail for one event (used by ring-buffer inspector).
     String showEvent    ( const FlagEventEx &ev );
-    /// @brief  JSON array of valid event "ID.VER" strings (Particle variable payload).
+    /// @brief  Select the s_EventLIST page.  Call via Particle.function("s_EvLPage").
+    ///         Returns the page actually set.
+    int    setEventListPage( int page );
+    /// @brief  One page of event slots: {"P":page,"NP":pages,"EVL":["ID.VER",null,...]}
+    ///         with null for an empty slot, so entry k is slot P * EL_PAGE + k.
+    ///         EL_PAGE slots keep it within the 622-byte publish limit even with
+    ///         the longest IDV.  Registered as s_EventLIST.
     String showEventList();
+    /// @brief  {"N":n,"RC":[...]} per-entry codes of the last receiveEvents() batch.
+    String showBatchResult();
+
+    // ── Event-set digest / have-list (delta sync) ─────────────────────────────
+    /// @brief  Order-independent digest of every held (eventID, eventVer) pair:
+    ///         the XOR of pairDigest() over occupied slots, kept up to date as
+    ///         slots are written and cleared.  0 for an empty table.
+    uint32_t    eventDigest      () const { return _evDigest; }
+    /// @brief  Per-pair term of eventDigest().  The backend folds the same terms
+    ///         over what it believes the unit holds and compares.
+    static uint32_t pairDigest   ( int32_t id, int32_t ver );
+    /// @brief  "n:xxxxxxxx" – held event count and eventDigest() in hex.
+    ///         Registered as s_EvDigest; a match means nothing needs sending.
+    String showDigest   ();
+    /// @brief  Select the s_EvHave page.  Call via Particle.function("s_EvHavePg").
+    ///         Returns the page actually set.
+    int    setHavePage  ( int page );
+    /// @brief  One page of held events, ascending by id:
+    ///         {"N":held,"P":page,"NP":pages,"H":"id.ver,id.ver,..."}
+    ///         HAVE_PAGE whole entries per page keep it within the 622-byte
+    ///         publish limit.  Registered as s_EvHave; the backend reads every
+    ///         page, diffs the pairs against its catalogue and pushes only
+    ///         missing or newer events through s_InjectEv.
+    String showHaveList ();
 
     // ── Ring-buffer event inspector ───────────────────────────────────────────
     /// @brief  Set cursor to @p idx (clamped to 0..N_EVENTS-1).
@@ -191,11 +322,24 @@ public:
     ///         Registered as Particle.variable("s_Event") in setup().
     String showEventAtCursor();
 
+    // ── Forward timeline (s_Timeline) ─────────────────────────────────────────
+    /// @brief  Select the s_Timeline page and, if @p days > 0, the horizon
+    ///         (clamped to 1..TL_DAYS_MAX).  Call via Particle.function("s_TlPage")
+    ///         with "page" or "page,days".  Returns the page actually set.
+    int    setTimelinePage( int page, int days = 0 );
+    /// @brief  One page of every station change from now to now + horizon, built
+    ///         from the same merged spans as setNextEvent().  Compact JSON:
+    ///         {"T":now,"D":days,"S":"F","P":page,"NP":pages,"TR":[[epoch,"H"],...]}
+    ///         with S the station ordered now.  Stays within the 622-byte publish
+    ///         limit (TL_PAGE changes per page).  Registered as s_Timeline.
+    String showTimeline   ();
+
     // ── Called after time-sync or DST change ──────────────────────────────────
-    /// @brief  Re-evaluates all stored events against the current clock and config.
-    ///         Must be called from the @c time_changed system event hook in main.ino
-    ///         and after any config change that affects time resolution (TZ, DST, lat/lng).
-    void reprocessEvents();
+    /// @brief  Re-resolves the time marks of all stored events against the current clock.
+    ///         Must be called from the @c time_changed system event hook in main.ino.
+    ///         Applicability is cached per slot and only re-checked when @p reasons
+    ///         include EVD_EVENT or EVD_CONFIG (setup() passes EVD_ALL once at boot).
+    void reprocessEvents( uint8_t reasons = EVD_TIME | EVD_DST );
 
     // ── Particle.variable lambda helpers (bind to these in main.ino) ──────────
     //    Particle.variable("s_EventLIST", [](){ return evMgr.showEventList(); });
@@ -212,9 +356,13 @@ private:
     double  _lng;              // LNG  – flagpole longitude
     String  _jurFederal;       // FED  – federal jurisdiction
     String  _jurState;         // STA  – state/regional jurisdiction
+    static const int SUB_MAX = 2;
+    String  _jurExtra[SUB_MAX]; // SUB  – extra jurisdiction topics (ConfigExt.subTopics)
     String  _postalCode;       // ZIP  – postal code
     float   _tzOffset;         // STD  – hours offset from UTC (standard time)
-    bool    _doDST;            // DST  – observe DST (North American rules)
+    bool    _doDST;            // DST  – observe DST
+    TzRule  _tzRule;           // TZR  – DST rule (ConfigExt.tzRule, default North American)
+    TzTable _tz;               //        _tzRule transitions for this year and next
     uint16_t _sjrList[5];      // SJR  – this unit's configured sub-jurisdiction IDs
     int      _sjrCount;        //        number of valid entries in _sjrList (0 = unassigned)
                                //        stored in ConfigExt.sjrCount / sjrList
@@ -227,42 +375,114 @@ private:
     time_t      _nextChange  = 0;             // GMT epoch of next flag movement
     FlagStation _nextSta     = FLAG_UNKNOWN;  // station for next movement
 
-    unsigned long _msUntilNext = 0;           // ms until next timer fires
-    unsigned long _timerStartMs = 0;          // millis() when timer was last set
+    time_t        _nextDst = 0;               // next DST boundary the timer stops at (0 = none)
+    uint32_t      _dstBoundaries = 0;
+
+    int           _dlCheck = -1;              // deadlines id of the next attention check
 
     // ── In-RAM event list ─────────────────────────────────────────────────────
     FlagEventEx _EVL[N_EVENTS];
+    uint8_t     _dirty[N_EVENTS] = {0};       // EvDirty bits pending per slot
+    uint32_t    _markResolutions = 0;
+    uint32_t    _applyChecks     = 0;
+    uint32_t    _evSaveCalls     = 0;
+    uint32_t    _evSlotWrites    = 0;
+    uint32_t    _evBytesWritten  = 0;
+    uint32_t    _evCorruptSlots  = 0;
+    uint32_t    _evDigest        = 0;         // XOR of pairDigest() over occupied slots
+
+    // ── Merged schedule (rebuilt by setNextEvent()) ───────────────────────────
+    EventSpan   _spans[N_EVENTS];             // merged [begin, end) windows, sorted
+    int         _nSpans = 0;
+    time_t      _spanOpenEnd = 0;             // end given to open-ended events at the last build
+
+    // ── Sunrise/sunset cache ──────────────────────────────────────────────────
+    //    Direct-mapped on day-of-year; valid only for the current _lat/_lng and
+    //    cleared by invalidateSunCache() whenever either changes.
+    struct SunCacheEntry {
+        int16_t doy;          // tm_yday this entry holds, -1 = empty
+        uint8_t have;         // bit rs set once sec[rs] is filled
+        int32_t sec[2];       // UTCSunEvent() result: [0] = sunset, [1] = sunrise
+    };
+    static const int SUN_CACHE_SIZE = 32;
+    SunCacheEntry _sunCache[SUN_CACHE_SIZE];
+    SunCalc::Site _sunSite = SunCalc::site( 0.0f, 0.0f );   // SF_FAST_SUN latitude terms
+    uint32_t      _sunCacheHits   = 0;
+    uint32_t      _sunCacheMisses = 0;
+
+    // ── Annual sun table ──────────────────────────────────────────────────────
+    //    Every day's UTCSunEvent() for the configured site, built once when LAT/LNG
+    //    change and persisted at EEPROM_ADDR_SUNTAB.  When valid it answers all
+    //    sun lookups and the cache above is bypassed.
+    SunTable      _sunTab;
+    bool          _sunTabEnabled  = ( SF_SUN_TABLE != 0 );
+    bool          _sunTabValid    = false;
+    uint32_t      _sunTableHits   = 0;
+
+    // ── String intern table ───────────────────────────────────────────────────
+    //    Text behind FlagEventEx::jurCode / flagCode.  Entry 0 is "" and an
+    //    empty entry is free; see intern() / sweepStrings().  Sized as the
+    //    EEPROM EventStrings table, so every string accepted here is saved.
+    static const int     STR_TAB_SIZE = EVS_STR_N;
+    static const int     STR_MAX      = EVS_STR_LEN;   // bytes per entry, incl. terminator
+    static const uint8_t STR_NONE     = 0xFF;   // intern() failure: table full
+    char          _strTab[STR_TAB_SIZE][STR_MAX];
+
+    // ── Last receiveEvents() batch ────────────────────────────────────────────
+    static const int BATCH_MAX = 32;
+    int8_t      _batchRc[BATCH_MAX] = {0};
+    int         _batchN = 0;                  // entries in the last batch (may exceed BATCH_MAX)
 
     // ── Station callback (set in setup()) ────────────────────────────────────
     void (*_setStationCB)(FlagStation) = nullptr;
 
     // ── Ring-buffer cursor ────────────────────────────────────────────────────
     int  _showIdx = 0;   // index for s_Event / s_EvIdx inspector
+    int  _elPage  = 0;   // s_EventLIST page (s_EvLPage)
+    int  _hvPage  = 0;   // s_EvHave page (s_EvHavePg)
+    int  _tlPage  = 0;   // s_Timeline page (s_TlPage)
+    int  _tlDays  = TL_DAYS;
 
     // ── Private helpers ───────────────────────────────────────────────────────
     void        setNextEvent   ();
+    void        markDirty      ( uint8_t reasons );
+    void        processDirty   ();
     void        updEventTimer  ();
     void        checkForChange ();
+    static void onCheckDue     ( void *ctx );
 
     int         purgeEvents    ();
     void        clearEvent     ( FlagEventEx &ev );
+    void        setEvent       ( int idx, const FlagEventEx &ev );
     int         matchEVID      ( int id );
+    bool        fitsRecordArea ( int idx, const FlagEventEx &ev ) const;
 
-    bool        jurMatch       ( const String &pubJur, const String &subJur );
+    static void onEvent        ( const char *topic, const char *data, void *ctx );
+    bool        jurMatch       ( const char *pubJur, const String &subJur );
     bool        eventApplies   ( const FlagEventEx &ev );
 
-    FlagEventEx parseEvent     ( const String &json );
+    FlagEventEx parseEvent     ( const JsonParserGeneratorRK::jsmntok_t *obj );
+    int         applyEvent     ( const JsonParserGeneratorRK::jsmntok_t *obj, bool &changed );
+
+    uint8_t     intern         ( const char *str, const FlagEventEx *pin = nullptr );
+    const char *codeStr        ( uint8_t code ) const;
+    void        sweepStrings   ( const FlagEventEx *pin );
 
     // Sun-time helpers (ported verbatim from Gen2)
     int         UTCSunEvent    ( float latitude, float longitude, int doy, int rs );
-    int         parseTimeMark  ( time_t &tVal, const String &mTime, const String &mDest );
-    int         getSunTime     ( time_t &tVal, struct tm &sTime, int srss );
-    int         getSunrise     ( time_t &tVal, struct tm &date );
-    int         getSunset      ( time_t &tVal, struct tm &date );
-    int         getZTime       ( time_t &tVal, struct tm &date, const String &hhmm );
-    int         getLTime       ( time_t &tVal, struct tm &date, const String &hhmm );
-
-    bool        isDST          ( int dayOfMonth, int month, int dayOfWeek );
+    int         sunEventCached ( int doy, int rs );
+    void        invalidateSunCache();
+    bool        buildSunTable  ();
+    void        refreshSunTable();
+    int         parseTimeMark  ( time_t &tVal, const TimeMark &mark, char dest );
+    // @p day is days since 1970-01-01 (TimeMarks::epochDay())
+    int         getSunTime     ( time_t &tVal, int32_t day, int srss );
+    int         getSunrise     ( time_t &tVal, int32_t day );
+    int         getSunset      ( time_t &tVal, int32_t day );
+    int         getZTime       ( time_t &tVal, int32_t day, int minutes );
+    int         getLTime       ( time_t &tVal, int32_t day, int minutes );
+
+    void        refreshTz      ();
 
     // EEPROM helpers
     int         loadFromEEPROM ();
@@ -273,6 +493,11 @@ private:
     String      staToLetter    ( FlagStation sta );
 };
 
+// A full table of SJR-less events fits the EEPROM record area; events with
+// SJR entries are held to it at ingest by fitsRecordArea().
+static_assert( EventManager::N_EVENTS * PACKED_EVENT_BASE <= EVENT_RECS_BYTES,
+               "N_EVENTS records must fit the EEPROM record area" );
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  Global instance declaration (defined in EventManager.cpp)
 // ─────────────────────────────────────────────────────────────────────────────
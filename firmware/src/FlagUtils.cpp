@@ -3,6 +3,7 @@
 #include "SmartFlagFSM.h"
 #include "EEPROMManager.h"
 #include "EventManager.h"
+#include "Deadlines.h"
 
 extern HalyardManager halMgr1;
 extern FSMController fsm;
@@ -13,6 +14,7 @@ extern FSMController fsm;
 
 static uint32_t s_lastPeriodicPublishSec = 0;  // tracks ONLY periodic heartbeats — never reset by forced publishes
 static uint32_t s_statusSeq = 0;
+static int      s_dlHeartbeat = -1;            // deadlines id of the periodic heartbeat
 
 // Last move context — populated by reportMoveStart(), read by getStatus()
 static FlagStation    s_moveFromStation = FLAG_UNKNOWN;
@@ -152,6 +154,19 @@ void reportMoveEnd(FlagMoveStatus moveResult, FlagStation actualStation) {
 // Core publish gate
 // ---------------------------------------------------------------------------
 
+static void onHeartbeatDue(void *) {
+    checkAndReportStatus(false, "RPT");
+}
+
+void beginStatusReports() {
+    s_dlHeartbeat = deadlines.add(onHeartbeatDue);
+    scheduleStatusReport();
+}
+
+void scheduleStatusReport() {
+    deadlines.arm(s_dlHeartbeat, 0);
+}
+
 void checkAndReportStatus(bool forceReport, const char* reason) {
 
     if (forceReport) {
@@ -159,21 +174,29 @@ void checkAndReportStatus(bool forceReport, const char* reason) {
         if (!burstAllowed()) return;
 
     } else {
-        // Periodic heartbeat: independent timer, never reset by forced publishes
-        // status_period_sec == 0 means periodic reports are disabled
-        ConfigData cfg;
-        readConfig(cfg);
+        // Periodic heartbeat: independent timer, never reset by forced publishes.
+        // Every path re-arms the heartbeat deadline for when it is next due.
+        // status_period_sec == 0 means periodic reports are disabled until
+        // scheduleStatusReport() is called again
+        const ConfigData &cfg = configData();
 
         if (cfg.status_period_sec == 0) return;
 
         uint32_t nowSec = Time.isValid() ? (uint32_t)Time.now() : (millis() / 1000);
         uint32_t gap    = nowSec - s_lastPeriodicPublishSec;
 
-        if (s_lastPeriodicPublishSec != 0 && gap < cfg.status_period_sec) return;
+        if (s_lastPeriodicPublishSec != 0 && gap < cfg.status_period_sec) {
+            deadlines.arm(s_dlHeartbeat, min(cfg.status_period_sec - gap, (uint32_t)86400) * 1000UL);
+            return;
+        }
 
-        if (!burstAllowed()) return;
+        if (!burstAllowed()) {
+            deadlines.arm(s_dlHeartbeat, 1000);
+            return;
+        }
 
         s_lastPeriodicPublishSec = nowSec;   // ONLY periodic timer updates this
+        deadlines.arm(s_dlHeartbeat, min(cfg.status_period_sec, (uint32_t)86400) * 1000UL);
     }
 
     s_statusSeq++;
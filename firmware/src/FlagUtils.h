@@ -11,9 +11,17 @@ String stateToString(FSMStateID state);
 
 // Primary status publish entry point.
 // forceReport=true  → event-driven (move start/stop, faults, lid events)
-// forceReport=false → periodic heartbeat (called every loop())
+// forceReport=false → periodic heartbeat (run by the heartbeat deadline)
 void checkAndReportStatus(bool forceReport, const char* reason);
 
+// Register the periodic heartbeat deadline (once, from setup()); the first
+// heartbeat is evaluated on the next deadlines.poll().
+void beginStatusReports();
+
+// Re-evaluate the heartbeat on the next deadlines.poll() — call after
+// status_period_sec changes.
+void scheduleStatusReport();
+
 // Called by HalyardManager when a move starts.
 // Captures ASTA at moment of departure and OSTA (destination).
 void reportMoveStart(FlagStation fromStation, FlagStation toStation);
@@ -3,6 +3,7 @@
 #include "Sensor.h"
 #include "EEPROMManager.h"
 #include "FlagUtils.h"
+#include "Deadlines.h"
 
 #define CURRENT_SENSOR_SCALE 2.0
 
@@ -26,6 +27,9 @@ void HalyardManager::begin() {
     _isRunning = false;
     _stall     = false;
     _forced    = FLAG_UNKNOWN;
+
+    _dlForced = deadlines.add(onForcedExpired, this);
+    _dlStop   = deadlines.add(onMoveTimeout,   this);
 }
 
 void HalyardManager::runMotor(Direction dir, unsigned long durationMs,
@@ -55,7 +59,8 @@ void HalyardManager::runMotor(Direction dir, unsigned long durationMs,
     analogWrite (_pwmPin,    _currentSpeed);
     digitalWrite(_enablePin, HIGH);
 
-    _stopTime  = (durationMs == 0) ? 0 : millis() + durationMs;
+    if (durationMs == 0) deadlines.disarm(_dlStop);
+    else                 deadlines.arm(_dlStop, durationMs);
     _isRunning = true;
     _stall     = false;
 
@@ -64,11 +69,9 @@ void HalyardManager::runMotor(Direction dir, unsigned long durationMs,
 }
 
 void HalyardManager::applyConfigExtToRuntime() {
-    ConfigExt x;
-    readConfigExt(x);
+    const ConfigExt &x = configExt();       // follows initConfigExt() below
     if (x.magic != CFGX_MAGIC || x.version != CFGX_VERSION) {
         initConfigExt();
-        readConfigExt(x);
     }
     setStallLimitMa(x.stall_limit_ma);
     setMoveTimeoutSec(x.move_timeout_sec);
@@ -77,20 +80,25 @@ void HalyardManager::applyConfigExtToRuntime() {
 }
 
 void HalyardManager::setForcedStation(FlagStation s, unsigned long expiration) {
-    _forced          = s;
-    _forcedBeginning = millis();
-    _forcedDuration  = expiration;
+    // validateDuration() rejects bad input with -1, which the old wrap-around
+    // expiry compare treated as already expired
+    if (expiration == (unsigned long)-1) expiration = 0;
+    _forced = s;
+    deadlines.arm(_dlForced, (uint32_t)expiration);
 }
 
-void HalyardManager::update() {
+void HalyardManager::onForcedExpired(void *ctx) {
+    static_cast<HalyardManager *>(ctx)->_forced = FLAG_UNKNOWN;
+}
 
-    // Expire forced station override
-    if (_forced != FLAG_UNKNOWN &&
-        millis() >= _forcedBeginning + _forcedDuration) {
-        _forced          = FLAG_UNKNOWN;
-        _forcedBeginning = 0;
-        _forcedDuration  = 0;
-    }
+void HalyardManager::onMoveTimeout(void *ctx) {
+    HalyardManager *h = static_cast<HalyardManager *>(ctx);
+    if (!h->_isRunning) return;
+    h->stopMotor(FLAG_MOVE_TIMEOUT);
+    buzzer.playEventWait(BUZZ_STOP);
+}
+
+void HalyardManager::update() {
 
     if (_isRunning) {
 
@@ -115,13 +123,7 @@ void HalyardManager::update() {
             analogWrite(_pwmPin, _currentSpeed);
         }
 
-        // 3. Time-based stop
-        if (_stopTime > 0 && millis() >= _stopTime) {
-            stopMotor(FLAG_MOVE_TIMEOUT);
-            buzzer.playEventWait(BUZZ_STOP);
-        }
-
-        // 4. Marker arrival check
+        // 3. Marker arrival check (the time-based stop is the _dlStop deadline)
         if (lowering()) {
             if (halfSensor.isPresent()) {
                 setActualStation(FLAG_HALF);
@@ -148,6 +150,7 @@ void HalyardManager::stopMotor(FlagMoveStatus status) {
     _isRunning  = false;
     _moveStatus = status;
     _rampActive = false;
+    deadlines.disarm(_dlStop);
 
     // Notify FlagUtils: move has ended
     reportMoveEnd(status, getActualStation());
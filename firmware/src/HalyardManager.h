@@ -64,7 +64,6 @@ class HalyardManager {
     // Ramp control
     const unsigned long _minRampStartTime = 50;
     const unsigned long _defRunTime       = 10000;
-    unsigned long _stopTime      = 0;
     unsigned long _rampStartTime = 0;
     unsigned long _rampDuration  = 0;
     uint8_t _targetSpeed  = 255;
@@ -79,8 +78,12 @@ class HalyardManager {
     FlagStation _ordered = FLAG_FULL;
     FlagStation _actual  = FLAG_UNKNOWN;
     FlagStation _forced  = FLAG_UNKNOWN;
-    unsigned long _forcedDuration  = 0;
-    unsigned long _forcedBeginning = 0;
+
+    // Deadlines (registered in begin()): forced-station expiry, move timeout
+    int _dlForced = -1;
+    int _dlStop   = -1;
+    static void onForcedExpired(void *ctx);
+    static void onMoveTimeout  (void *ctx);
 
     // Station captured at move-start, for reporting
     FlagStation _departureStation = FLAG_UNKNOWN;
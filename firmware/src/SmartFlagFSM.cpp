@@ -2,6 +2,7 @@
 #include "FaultManager.h"
 #include "Sensor.h"
 #include "FlagUtils.h"
+#include "Deadlines.h"
 
 extern HalyardManager halMgr1;
 extern BuzzerManager  buzzer;
@@ -14,7 +15,8 @@ extern Sensor fullSensor;
 // Move-start and move-end reports are triggered directly by
 // HalyardManager::runMotor() and HalyardManager::stopMotor().
 // Periodic heartbeat reports are driven by checkAndReportStatus(false,...)
-// called in loop(). FSM states no longer call checkAndReportStatus().
+// from the heartbeat deadline (beginStatusReports()). FSM states no longer
+// call checkAndReportStatus() for the heartbeat.
 // -----------------------------------------------------------------------
 
 void defineStartupState(FSMController& fsm) {
@@ -150,15 +152,29 @@ void defineMovingToStationState(FSMController& fsm) {
 }
 
 void defineLidOpenState(FSMController& fsm) {
-    static FSMStateID    fsmNextState   = STATE_NONE;
-    static unsigned long lidClosedStart = 0;
-    static unsigned long lidClosedBeep  = 0;
+    static FSMStateID fsmNextState = STATE_NONE;
+    static int        lidClosedSec = -1;    // seconds since the lid closed; -1 = open
+
+    // Once-a-second countdown while the lid stays closed
+    static int lidTick = -1;
+    lidTick = deadlines.add([](void *) {
+        lidClosedSec++;
+        if (lidClosedSec >= 10) {
+            lidClosedSec = -1;
+            fsmNextState = STATE_CALIBRATION;
+            return;
+        }
+        if      (lidClosedSec == 9) buzzer.playEvent(BUZZ_LID_END);
+        else if (lidClosedSec <  7) buzzer.playEvent(BUZZ_HIGHTICK);
+        else                        buzzer.playEvent(BUZZ_HIGHTICK2);
+        deadlines.rearm(lidTick, 1000);
+    });
 
     FSMState state;
     state.onEnter = []() {
-        fsmNextState   = STATE_NONE;
-        lidClosedStart = 0;
-        lidClosedBeep  = 0;
+        fsmNextState = STATE_NONE;
+        lidClosedSec = -1;
+        deadlines.disarm(lidTick);
 
         if (halMgr1.isRunning()) halMgr1.stopMotor(FLAG_MOVE_CANCELLED);
         halMgr1.invalidateStation();
@@ -169,51 +185,41 @@ void defineLidOpenState(FSMController& fsm) {
 
     state.onUpdate = []() {
         if (lidSensor.isPresent()) {
-            if (lidClosedStart == 0) {
-                lidClosedStart = millis();
-                lidClosedBeep  = millis();
+            if (lidClosedSec < 0 && fsmNextState == STATE_NONE) {
+                lidClosedSec = 0;
                 buzzer.playEvent(BUZZ_LID_START);
-            } else if ((millis() - lidClosedStart) >= 10000) {
-                lidClosedStart = 0;
-                fsmNextState   = STATE_CALIBRATION;
-            } else if ((millis() - lidClosedStart) >= 9000) {
-                buzzer.playEvent(BUZZ_LID_END);
-            } else if ((millis() - lidClosedBeep) >= 1000) {
-                lidClosedBeep += 1000;
-                if ((millis() - lidClosedStart) < 7000) {
-                    buzzer.playEvent(BUZZ_HIGHTICK);
-                } else {
-                    buzzer.playEvent(BUZZ_HIGHTICK2);
-                }
+                deadlines.arm(lidTick, 1000);
             }
-        } else {
-            lidClosedStart = 0;
-            lidClosedBeep  = 0;
+        } else if (lidClosedSec >= 0) {
+            lidClosedSec = -1;                 // reopened: restart the countdown
+            deadlines.disarm(lidTick);
         }
     };
 
-    state.onExit        = []() { checkAndReportStatus(true, "LCL"); };   // lid closed / LID state cleared
+    state.onExit        = []() {
+        deadlines.disarm(lidTick);
+        checkAndReportStatus(true, "LCL");     // lid closed / LID state cleared
+    };
     state.shouldAdvance = []() -> FSMStateID { return fsmNextState; };
     fsm.addState(STATE_LID_OPEN, state);
 }
 
 void defineFaultRecoveryState(FSMController& fsm) {
-    static FSMStateID    fsmNextState   = STATE_NONE;
-    static unsigned long fixMeStartTime = 0;
+    static FSMStateID fsmNextState = STATE_NONE;
+
+    // 15-minute timeout back to calibration
+    static int fixMeTimeout = -1;
+    fixMeTimeout = deadlines.add([](void *) { fsmNextState = STATE_CALIBRATION; });
 
     FSMState state;
     state.onEnter = []() {
-        fsmNextState   = STATE_NONE;
-        fixMeStartTime = millis();
+        fsmNextState = STATE_NONE;
+        deadlines.arm(fixMeTimeout, 900000UL);
         buzzer.playEvent(BUZZ_FAULT_RECOVERY);
         // Move-end report already fired from stopMotor() — no extra publish needed.
     };
-    state.onUpdate = []() {
-        if ((millis() - fixMeStartTime) > 900000UL) {  // 15-minute timeout
-            fsmNextState = STATE_CALIBRATION;
-        }
-    };
-    state.onExit        = []() {};
+    state.onUpdate      = []() {};
+    state.onExit        = []() { deadlines.disarm(fixMeTimeout); };
     state.shouldAdvance = []() -> FSMStateID { return fsmNextState; };
     fsm.addState(STATE_FAULT_RECOVERY, state);
 }
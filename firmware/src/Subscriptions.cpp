@@ -0,0 +1,119 @@
+#include "Subscriptions.h"
+#include "Particle.h"
+#include "Dbg.h"
+
+#include <string.h>
+
+SubscriptionRegistry subscriptions;
+
+//  Particle prefix semantics: @p prefix covers @p topic if topic starts with it
+static bool isPrefix( const char *prefix, const char *topic ) {
+    return strncmp( topic, prefix, strlen( prefix ) ) == 0;
+}
+
+bool SubscriptionRegistry::setTopics( Handler fn, void *ctx, const char *const *topics, int n ) {
+    // Drop this owner's routes, keeping the others in order
+    int w = 0;
+    for ( int r = 0; r < _nRoutes; r++ ) {
+        if ( _routes[r].fn == fn && _routes[r].ctx == ctx ) continue;
+        _routes[w++] = _routes[r];
+    }
+    _nRoutes = w;
+
+    bool ok = true;
+    for ( int i = 0; i < n; i++ ) {
+        const char *t = topics[i];
+        if ( t == nullptr || t[0] == '\0' ) continue;
+        if ( strlen( t ) >= (size_t)TOPIC_MAX || _nRoutes >= MAX_ROUTES ) {
+            SFDBG::pub("SUB", String("route rejected: ") + t, true);
+            ok = false;
+            continue;
+        }
+        bool dup = false;
+        for ( int r = 0; r < _nRoutes && !dup; r++ ) {
+            dup = _routes[r].fn == fn && _routes[r].ctx == ctx && strcmp( _routes[r].topic, t ) == 0;
+        }
+        if ( dup ) continue;
+        Route &rt = _routes[_nRoutes++];
+        strcpy( rt.topic, t );
+        rt.fn  = fn;
+        rt.ctx = ctx;
+    }
+    sync();
+    return ok;
+}
+
+bool SubscriptionRegistry::covered( const char *topic ) const {
+    for ( int a = 0; a < _nActive; a++ ) {
+        if ( isPrefix( _active[a], topic ) ) return true;
+    }
+    return false;
+}
+
+void SubscriptionRegistry::subscribe( const char *topic ) {
+    if ( _nActive >= MAX_ACTIVE ) {
+        SFDBG::pub("SUB", String("no room for ") + topic, true);
+        return;
+    }
+    strcpy( _active[_nActive++], topic );
+    Particle.subscribe( topic, dispatch );
+    _subscribes++;
+    SFDBG::pub("SUB", String("subscribed to ") + topic, true);
+}
+
+void SubscriptionRegistry::sync() {
+    // Wanted topics, minus any another wanted topic already covers
+    const char *want[MAX_ROUTES];
+    int nWant = 0;
+    for ( int r = 0; r < _nRoutes; r++ ) {
+        const char *t = _routes[r].topic;
+        bool redundant = false;
+        for ( int q = 0; q < _nRoutes && !redundant; q++ ) {
+            const char *o = _routes[q].topic;
+            if ( q == r || !isPrefix( o, t ) ) continue;
+            redundant = strcmp( o, t ) != 0 || q < r;   // shorter prefix, or the first copy
+        }
+        if ( !redundant ) want[nWant++] = t;
+    }
+
+    int  nMissing = 0;
+    bool overlap  = false;   // a new topic would also match an active one
+    for ( int i = 0; i < nWant; i++ ) {
+        if ( covered( want[i] ) ) continue;
+        nMissing++;
+        for ( int a = 0; a < _nActive; a++ ) overlap |= isPrefix( want[i], _active[a] );
+    }
+    if ( nMissing == 0 ) return;
+
+    if ( overlap || _nActive + nMissing > MAX_ACTIVE ) {
+        Particle.unsubscribe();   // all-or-nothing; re-register the wanted set
+        _nActive = 0;
+        _resets++;
+        for ( int i = 0; i < nWant; i++ ) subscribe( want[i] );
+    } else {
+        for ( int i = 0; i < nWant; i++ ) {
+            if ( !covered( want[i] ) ) subscribe( want[i] );
+        }
+    }
+}
+
+void SubscriptionRegistry::dispatch( const char *topic, const char *data ) {
+    const SubscriptionRegistry &s = subscriptions;
+    for ( int r = 0; r < s._nRoutes; r++ ) {
+        const Route &rt = s._routes[r];
+        if ( !isPrefix( rt.topic, topic ) ) continue;
+        bool called = false;                     // once per owner per event
+        for ( int q = 0; q < r && !called; q++ ) {
+            called = s._routes[q].fn == rt.fn && s._routes[q].ctx == rt.ctx &&
+                     isPrefix( s._routes[q].topic, topic );
+        }
+        if ( !called ) rt.fn( topic, data, rt.ctx );
+    }
+}
+
+void SubscriptionRegistry::clear() {
+    _nRoutes    = 0;
+    _nActive    = 0;
+    _subscribes = 0;
+    _resets     = 0;
+}
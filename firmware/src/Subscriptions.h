@@ -0,0 +1,74 @@
+/**
+ * @file    Subscriptions.h
+ * @brief   Topic → handler routing table over Particle.subscribe().
+ *
+ * @details
+ * Device OS subscriptions are prefix matches with no per-topic unsubscribe:
+ * Particle.unsubscribe() drops every handler, and anything published until
+ * they are registered again is lost.  Modules therefore do not subscribe
+ * directly.  Each owner (handler + context) declares the topics it wants with
+ * @c setTopics(); the registry keeps the routes and @c sync() reconciles them
+ * with what is actually subscribed:
+ *
+ *  - topics already covered by an active subscription cost nothing;
+ *  - new topics are added with Particle.subscribe(), without a gap, while
+ *    there is room (@c MAX_ACTIVE);
+ *  - only when the table would overflow, or a new topic is a prefix of an
+ *    active one (Device OS would then deliver twice), is everything dropped
+ *    and re-subscribed (@c resets()).
+ *
+ * A topic nobody wants any more stays subscribed until the next reset; the
+ * single @c dispatch() callback finds no route for it and drops the event.
+ * An owner matched by several of its routes is called once per event.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class SubscriptionRegistry {
+public:
+    typedef void (*Handler)( const char *topic, const char *data, void *ctx );
+
+    static const int MAX_ROUTES = 8;     // (topic, owner) pairs
+    static const int MAX_ACTIVE = 4;     // Particle subscriptions held at once
+    static const int TOPIC_MAX  = 16;    // bytes per topic, incl. terminator
+
+    /// Replace every route owned by (@p fn, @p ctx) with @p topics[0..n-1]
+    /// (empty strings are skipped), then sync().  Returns false if a topic
+    /// was too long or the route table is full (the rest are still routed).
+    bool setTopics  ( Handler fn, void *ctx, const char *const *topics, int n );
+    /// Reconcile the routes with the active Particle subscriptions.
+    void sync       ();
+
+    int      routeCount () const { return _nRoutes; }
+    int      activeCount() const { return _nActive; }
+    /// Particle.subscribe() calls made.
+    uint32_t subscribes () const { return _subscribes; }
+    /// Unsubscribe-all + re-subscribe cycles.
+    uint32_t resets     () const { return _resets; }
+
+    /// Forget routes and active topics, as after a reset.
+    void clear      ();
+
+private:
+    struct Route {
+        char    topic[TOPIC_MAX];
+        Handler fn;
+        void   *ctx;
+    };
+
+    static void dispatch( const char *topic, const char *data );
+    bool covered   ( const char *topic ) const;
+    void subscribe ( const char *topic );
+
+    Route    _routes[MAX_ROUTES];
+    int      _nRoutes = 0;
+    char     _active[MAX_ACTIVE][TOPIC_MAX];
+    int      _nActive = 0;
+
+    uint32_t _subscribes = 0;
+    uint32_t _resets     = 0;
+};
+
+extern SubscriptionRegistry subscriptions;
@@ -0,0 +1,104 @@
+#include "SunCalc.h"
+#include <math.h>
+
+namespace SunCalc {
+
+static const float RD     = 57.295779513082322f;   // degrees per radian
+static const float ZENITH = 1.579522973054868f;    // 90.5°: horizon plus refraction allowance
+static const float PI_F   = 3.14159265358979f;
+
+// ── Gen2 kernel (verbatim from EventManager::UTCSunEvent) ────────────────────
+
+int exact( float latitude, float longitude, int doy, int rs ) {
+    float rd     = RD;
+    float lat    = latitude  / rd;
+    float lon    = -longitude / rd;
+    float zenith = ZENITH;
+
+    unsigned char a = rs ? 6 : 18;
+    float y    = 0.01721420632104f * (doy + a / 24.0f);
+    float eqt  = 229.18f * ( 0.000075f + 0.001868f*cosf(y)  - 0.032077f*sinf(y)
+                            - 0.014615f*cosf(y*2) - 0.040849f*sinf(y*2) );
+    float decl = 0.006918f - 0.399912f*cosf(y) + 0.070257f*sinf(y)
+               - 0.006758f*cosf(y*2) + 0.000907f*sinf(y*2)
+               - 0.002697f*cosf(y*3) + 0.00148f*sinf(y*3);
+    float ha   = cosf(zenith) / (cosf(lat)*cosf(decl)) - tanf(lat)*tanf(decl);
+
+    if ( fabsf(ha) <= 1.0f ) {
+        if ( rs ) {
+            return (int)( 60.0f * (720.0f + 4.0f*(lon - acosf(ha))*rd - eqt) );
+        } else {
+            return (int)( 60.0f * (720.0f + 4.0f*(lon + acosf(ha))*rd - eqt) );
+        }
+    }
+    return NONE;
+}
+
+// ── Polynomial kernel ────────────────────────────────────────────────────────
+
+Site site( float latitude, float longitude ) {
+    float lat = latitude / RD;
+    return { latitude, longitude, -longitude / RD,
+             cosf( ZENITH ) / cosf( lat ), tanf( lat ) };
+}
+
+//  sin and cos of @p t in [-π, π]: quadrant reduction to |r| <= π/4, then
+//  Taylor terms to r⁷ / r⁸ (truncation below 3e-7).
+static void sinCos( float t, float &s, float &c ) {
+    int   q = (int)floorf( t * ( 2.0f / PI_F ) + 0.5f );
+    float r = t - (float)q * ( PI_F / 2.0f );
+    float r2 = r * r;
+    float sr = r * ( 1.0f - r2 / 6.0f * ( 1.0f - r2 / 20.0f * ( 1.0f - r2 / 42.0f ) ) );
+    float cr = 1.0f - r2 / 2.0f * ( 1.0f - r2 / 12.0f * ( 1.0f - r2 / 30.0f * ( 1.0f - r2 / 56.0f ) ) );
+    switch ( q & 3 ) {
+        case 0:  s =  sr; c =  cr; break;
+        case 1:  s =  cr; c = -sr; break;
+        case 2:  s = -sr; c = -cr; break;
+        default: s = -cr; c =  sr; break;
+    }
+}
+
+//  acos on [-1, 1]: Abramowitz & Stegun 4.4.46, |error| <= 2e-8 rad.
+static float acosPoly( float x ) {
+    float ax = fabsf( x );
+    float p  = -0.0012624911f;
+    p = p * ax + 0.0066700901f;
+    p = p * ax - 0.0170881256f;
+    p = p * ax + 0.0308918810f;
+    p = p * ax - 0.0501743046f;
+    p = p * ax + 0.0889789874f;
+    p = p * ax - 0.2145988016f;
+    p = p * ax + 1.5707963050f;
+    float r = sqrtf( 1.0f - ax ) * p;
+    return ( x < 0.0f ) ? PI_F - r : r;
+}
+
+int fast( const Site &st, int doy, int rs ) {
+    float y = 0.01721420632104f * ( doy + ( rs ? 6 : 18 ) / 24.0f );
+    if ( y > PI_F ) y -= 2.0f * PI_F;
+
+    float s1, c1;
+    sinCos( y, s1, c1 );
+    float c2 = 2.0f * c1 * c1 - 1.0f,  s2 = 2.0f * s1 * c1;
+    float c3 = c1 * ( 2.0f * c2 - 1.0f ), s3 = s1 * ( 2.0f * c2 + 1.0f );
+
+    float eqt  = 229.18f * ( 0.000075f + 0.001868f*c1 - 0.032077f*s1
+                            - 0.014615f*c2 - 0.040849f*s2 );
+    float decl = 0.006918f - 0.399912f*c1 + 0.070257f*s1
+               - 0.006758f*c2 + 0.000907f*s2
+               - 0.002697f*c3 + 0.00148f*s3;
+
+    // |decl| < 0.41: sec and tan to d⁸ / d⁹ (truncation below 2e-6)
+    float d2   = decl * decl;
+    float secD = 1.0f + d2 * ( 0.5f + d2 * ( 5.0f / 24.0f + d2 * ( 61.0f / 720.0f + d2 * ( 277.0f / 8064.0f ) ) ) );
+    float tanD = decl * ( 1.0f + d2 * ( 1.0f / 3.0f + d2 * ( 2.0f / 15.0f + d2 * ( 17.0f / 315.0f + d2 * ( 62.0f / 2835.0f ) ) ) ) );
+    float ha   = st.cosZbyCosLat * secD - st.tanLat * tanD;
+
+    if ( fabsf(ha) <= 1.0f ) {
+        float h = acosPoly( ha );
+        return (int)( 60.0f * ( 720.0f + 4.0f * ( rs ? st.lon - h : st.lon + h ) * RD - eqt ) );
+    }
+    return NONE;
+}
+
+} // namespace SunCalc
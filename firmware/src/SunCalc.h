@@ -0,0 +1,57 @@
+/**
+ * @file    SunCalc.h
+ * @brief   Sunrise / sunset in UTC seconds of day: the Gen2 libm kernel and a
+ *          reduced-cost polynomial kernel with a bounded error.
+ *
+ * @details
+ * @c exact() is the Gen2 UTCSunEvent() series unchanged: the NOAA fractional-
+ * year equation of time and declination, then the hour angle at the 90.5°
+ * zenith.  It costs about a dozen cosf / sinf / tanf / acosf calls per event.
+ *
+ * @c fast() evaluates the same series without libm:
+ *  - one polynomial sin/cos of the fractional-year angle, with the 2y and 3y
+ *    harmonics from the double- and triple-angle identities;
+ *  - sec and tan of the declination (|decl| < 0.41 rad) as short Taylor
+ *    polynomials;
+ *  - acos of the hour-angle cosine as the Abramowitz & Stegun 4.4.46
+ *    sqrt(1 - x) · P7(x) minimax;
+ *  - the latitude terms precomputed once per site (@c Site).
+ *
+ * The only libm call left is sqrtf(), a single VSQRT on the Cortex-M FPU.
+ *
+ * Maximum error against @c exact(), every day of the year (doy 0..365), both
+ * events, every 0.25° of latitude in ±66° (test_sun_calc): @c FAST_MAX_ERR_S
+ * second – the series agree to well under that, so what remains is the final
+ * (int) truncation landing on the other side of a second.  Both kernels
+ * report @c NONE on exactly the same days.  Pick the kernel per build with
+ * SF_FAST_SUN (EventManager.h); bench_sun_calc reports the cost of each.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace SunCalc {
+
+static const int NONE           = 86401;    // polar: no sunrise/sunset that day
+static const int FAST_MAX_ERR_S = 1;        // |fast() - exact()|, seconds, |lat| <= 66°
+
+/// Gen2 UTCSunEvent(): seconds after 00:00 UTC of sunset (@p rs = 0) or
+/// sunrise (@p rs = 1) on day-of-year @p doy (0-based), or NONE.
+int exact( float latitude, float longitude, int doy, int rs );
+
+/// Site terms reused by every fast() call for one LAT/LNG.
+struct Site {
+    float lat;          // degrees, as configured – identifies the site
+    float lng;
+    float lon;          // -lng in radians
+    float cosZbyCosLat; // cos(zenith) / cos(lat)
+    float tanLat;
+};
+
+Site site( float latitude, float longitude );
+
+/// exact() to within FAST_MAX_ERR_S seconds, with no transcendental libm calls.
+int fast( const Site &s, int doy, int rs );
+
+} // namespace SunCalc
@@ -0,0 +1,68 @@
+#include "TimeMark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace TimeMarks {
+
+// atoi() over s[from, to) – the fixed-offset substring().toInt() Gen2 used
+static int field( const char *s, int from, int to ) {
+    char tmp[8];
+    int  n = to - from;
+    memcpy( tmp, s + from, n );
+    tmp[n] = '\0';
+    return atoi( tmp );
+}
+
+TimeMark compile( const char *s ) {
+    TimeMark m;
+    memset( &m, 0, sizeof(m) );
+    size_t len = strlen( s );
+
+    if ( strcmp( s, "TBD" ) == 0 ) { m.kind = TMK_TBD; return m; }
+    if ( len < 10 ) { m.kind = TMK_BAD; m.err = 6; return m; }           // EMrc::PARSE_ERROR
+
+    m.year  = (uint16_t)field( s, 0, 4 );
+    m.month = (uint8_t) field( s, 5, 7 );
+    m.day   = (uint8_t) field( s, 8, 10 );
+
+    switch ( len ) {
+        case 10:
+            m.kind = TMK_DATE;
+            break;
+        case 13:
+            if      ( s[11] == 'S' && s[12] == 'R' ) m.kind = TMK_SR;
+            else if ( s[11] == 'S' && s[12] == 'S' ) m.kind = TMK_SS;
+            else { m.kind = TMK_BAD; m.err = 4; }                        // EMrc::NOT_SRSS
+            break;
+        case 16:
+        case 17:
+            m.minutes = (int16_t)( field( s, 11, 13 ) * 60 + field( s, 14, 16 ) );
+            if      ( len == 16 )    m.kind = TMK_HM;
+            else if ( s[16] == 'Z' ) m.kind = TMK_Z;
+            else if ( s[16] == 'L' ) m.kind = TMK_L;
+            else { m.kind = TMK_BAD; m.err = 5; }                        // EMrc::NOT_ZL
+            break;
+        default:
+            m.kind = TMK_OTHER;
+            break;
+    }
+    return m;
+}
+
+void format( const TimeMark &m, char *buf, size_t len ) {
+    int hh = m.minutes / 60, mm = m.minutes % 60;
+    switch ( m.kind ) {
+        case TMK_TBD:  snprintf( buf, len, "TBD" );                                              return;
+        case TMK_DATE: snprintf( buf, len, "%04u-%02u-%02u",    m.year, m.month, m.day );        return;
+        case TMK_SR:   snprintf( buf, len, "%04u-%02u-%02uTSR", m.year, m.month, m.day );        return;
+        case TMK_SS:   snprintf( buf, len, "%04u-%02u-%02uTSS", m.year, m.month, m.day );        return;
+        case TMK_HM:   snprintf( buf, len, "%04u-%02u-%02uT%02d:%02d",  m.year, m.month, m.day, hh, mm ); return;
+        case TMK_Z:    snprintf( buf, len, "%04u-%02u-%02uT%02d:%02dZ", m.year, m.month, m.day, hh, mm ); return;
+        case TMK_L:    snprintf( buf, len, "%04u-%02u-%02uT%02d:%02dL", m.year, m.month, m.day, hh, mm ); return;
+        default:       if ( len ) buf[0] = '\0';                                                 return;
+    }
+}
+
+} // namespace TimeMarks
@@ -0,0 +1,77 @@
+/**
+ * @file    TimeMark.h
+ * @brief   Compiled form of an event begin/end time-mark string (BMK / EMK).
+ *
+ * @details
+ * Marks arrive as short strings and used to be kept as Arduino Strings and
+ * re-parsed with substring()/atoi() on every reprocess.  @c TimeMarks::compile()
+ * parses a mark once into an 8-byte POD; @c TimeMarks::format() turns it back
+ * into the canonical string for persistence and display.
+ *
+ * Accepted forms (by length, exactly as Gen2 parseTimeMark() dispatched them):
+ *  - "TBD"                  – to be determined (resolves to 0)
+ *  - "YYYY-MM-DD"           – date only: sunrise for a begin, sunset for an end
+ *  - "YYYY-MM-DDTSR" / "SS" – explicit sunrise / sunset
+ *  - "YYYY-MM-DDTHH:MM"     – GMT clock time
+ *  - "YYYY-MM-DDTHH:MMZ"    – GMT clock time
+ *  - "YYYY-MM-DDTHH:MML"    – local clock time (STD offset + DST)
+ * Field values are taken with atoi() at fixed offsets, as before, so malformed
+ * digits compile to the same numbers Gen2 would have used.
+ *
+ * Resolution works in whole days since 1970-01-01 (@c epochDay(), see
+ * CivilDate.h) so that a reprocess is integer arithmetic on the compiled
+ * fields rather than a mktime() per mark.  Out-of-range months and days carry into the next
+ * month / year exactly as mktime() normalises them.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "CivilDate.h"
+
+enum TimeMarkKind : uint8_t {
+    TMK_TBD   = 0,
+    TMK_DATE  = 1,   // date only – sunrise / sunset by destination
+    TMK_SR    = 2,
+    TMK_SS    = 3,
+    TMK_HM    = 4,   // HH:MM, no suffix (GMT)
+    TMK_Z     = 5,   // HH:MM Z
+    TMK_L     = 6,   // HH:MM L
+    TMK_OTHER = 7,   // length >= 10 but none of the above: resolves to "unchanged"
+    TMK_BAD   = 8    // rejected at compile time; @c err holds the EMrc code
+};
+
+/// One compiled time mark.  Trivially copyable; no heap.
+struct TimeMark {
+    uint16_t year;      // calendar year (e.g. 2025)
+    uint8_t  month;     // 1..12
+    uint8_t  day;       // 1..31
+    uint8_t  kind;      // TimeMarkKind
+    uint8_t  err;       // EMrc code when kind == TMK_BAD, else 0
+    int16_t  minutes;   // HH*60 + MM for TMK_HM / TMK_Z / TMK_L
+};
+static_assert( sizeof(TimeMark) == 8, "TimeMark must stay 8 bytes" );
+
+namespace TimeMarks {
+
+/// Longest canonical mark string, excluding the terminator.
+static const size_t MAX_LEN = 17;
+
+/// Parse @p s into a TimeMark.  Never fails; bad marks compile to TMK_BAD.
+TimeMark compile( const char *s );
+
+/// Write the canonical string for @p m into @p buf (at least MAX_LEN + 1 bytes).
+/// TMK_OTHER / TMK_BAD marks format as "".
+void     format ( const TimeMark &m, char *buf, size_t len );
+
+/// Days since 1970-01-01 (UTC) of the mark's date (CivilDate::fromFields()).
+inline int32_t epochDay( const TimeMark &m ) { return CivilDate::fromFields( m.year, m.month, m.day ); }
+
+/// Resolution depends on the site (sunrise / sunset).
+inline bool usesSun  ( const TimeMark &m ) { return m.kind == TMK_DATE || m.kind == TMK_SR || m.kind == TMK_SS; }
+/// Resolution depends on the time-zone offset and DST observance.
+inline bool usesLocal( const TimeMark &m ) { return m.kind == TMK_L; }
+
+} // namespace TimeMarks
@@ -0,0 +1,138 @@
+#include "TzRule.h"
+#include "CivilDate.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace TzRules {
+
+TzRule northAmerica() {
+    TzRule r = {};
+    r.saveMin = 60;
+    r.start   = { 3,  2, 0, 0, 120 };
+    r.end     = { 11, 1, 0, 0, 120 };
+    return r;
+}
+
+// "Mm.w.d[/h[:mm]]" at *p; advances *p past it
+static bool parseOne( const char *&p, DstRule &d ) {
+    char *e;
+    if ( *p++ != 'M' ) return false;
+    long m = strtol( p, &e, 10 ); if ( e == p || *e != '.' ) return false; p = e + 1;
+    long w = strtol( p, &e, 10 ); if ( e == p || *e != '.' ) return false; p = e + 1;
+    long a = strtol( p, &e, 10 ); if ( e == p ) return false;              p = e;
+    long minute = 120;
+    if ( *p == '/' ) {
+        p++;
+        long h = strtol( p, &e, 10 ); if ( e == p ) return false; p = e;
+        long mm = 0;
+        if ( *p == ':' ) {
+            p++;
+            mm = strtol( p, &e, 10 ); if ( e == p ) return false; p = e;
+        }
+        minute = h * 60 + mm;
+    }
+    if ( m < 1 || m > 12 || w < 1 || w > 5 || a < 0 || a > 6 || minute < 0 || minute > 24 * 60 ) return false;
+    d = { (uint8_t)m, (uint8_t)w, (uint8_t)a, 0, (int16_t)minute };
+    return true;
+}
+
+bool parse( const char *s, TzRule &r ) {
+    TzRule t = {};
+    const char *p = s;
+    if ( !parseOne( p, t.start ) || *p++ != ',' || !parseOne( p, t.end ) || *p != '\0' ) return false;
+    t.saveMin = 60;
+    r = t;
+    return true;
+}
+
+static int formatOne( const DstRule &d, char *buf, size_t len ) {
+    if ( d.minute % 60 )
+        return snprintf( buf, len, "M%u.%u.%u/%d:%02d", d.month, d.week, d.wday, d.minute / 60, d.minute % 60 );
+    return snprintf( buf, len, "M%u.%u.%u/%d", d.month, d.week, d.wday, d.minute / 60 );
+}
+
+void format( const TzRule &r, char *buf, size_t len ) {
+    int n = formatOne( r.start, buf, len );
+    if ( n < 0 || (size_t)n + 1 >= len ) return;
+    buf[n++] = ',';
+    formatOne( r.end, buf + n, len - n );
+}
+
+int32_t ruleDay( const DstRule &d, int year ) {
+    int32_t day1 = CivilDate::daysFromCivil( year, d.month, 1 );
+    int32_t day  = day1 + ( d.wday - CivilDate::weekDay( day1 ) + 7 ) % 7 + ( d.week - 1 ) * 7;
+
+    if ( d.week == 5 ) {                       // "last": step back into the month
+        int32_t next1 = CivilDate::fromFields( year, d.month + 1, 1 );   // month 13 carries
+        while ( day >= next1 ) day -= 7;
+    }
+    return day;
+}
+
+} // namespace TzRules
+
+void TzTable::yearChanges( const TzRule &r, int stdMin, int year, Change out[2] ) {
+    time_t std  = (time_t)stdMin * 60;
+    time_t save = (time_t)r.saveMin * 60;
+
+    Change on, off;
+    on.wall  = (time_t)TzRules::ruleDay( r.start, year ) * 86400 + r.start.minute * 60;
+    on.utc   = on.wall - std;
+    on.dst   = true;
+    off.wall = (time_t)TzRules::ruleDay( r.end, year ) * 86400 + r.end.minute * 60;
+    off.utc  = off.wall - std - save;
+    off.dst  = false;
+
+    // Northern rules start first in the year; southern ones end first
+    out[0] = ( on.utc <= off.utc ) ? on  : off;
+    out[1] = ( on.utc <= off.utc ) ? off : on;
+}
+
+void TzTable::build( const TzRule &rule, int stdMin, int year ) {
+    _rule   = rule;
+    _stdMin = stdMin;
+    _year   = year;
+    _n      = 0;
+    if ( rule.saveMin == 0 ) return;
+
+    yearChanges( rule, stdMin, year,     &_ch[0] );
+    yearChanges( rule, stdMin, year + 1, &_ch[2] );
+    _n = 4;
+}
+
+// DST in force at @p wall: the state after the last change at or before it,
+// else the opposite of the first change
+bool TzTable::dstAt( const Change *c, int n, time_t wall ) {
+    int lo = 0, hi = n;                        // first change with wall > t lies in [lo, hi]
+    while ( lo < hi ) {
+        int mid = lo + ( hi - lo ) / 2;
+        if ( c[mid].wall <= wall ) lo = mid + 1;
+        else                       hi = mid;
+    }
+    return ( lo > 0 ) ? c[lo - 1].dst : !c[0].dst;
+}
+
+time_t TzTable::toUTC( time_t wall ) const {
+    time_t std = (time_t)_stdMin * 60;
+    if ( _rule.saveMin == 0 ) return wall - std;
+
+    bool dst;
+    int  y = CivilDate::civilFromDays( (int32_t)( wall / 86400 ) ).year;
+    if ( _n == 4 && ( y == _year || y == _year + 1 ) ) {
+        dst = dstAt( _ch, _n, wall );
+    } else {
+        Change c[2];
+        yearChanges( _rule, _stdMin, y, c );
+        dst = dstAt( c, 2, wall );
+    }
+    return wall - std - ( dst ? (time_t)_rule.saveMin * 60 : 0 );
+}
+
+time_t TzTable::nextChange( time_t utc ) const {
+    for ( int i = 0; i < _n; i++ ) {
+        if ( _ch[i].utc > utc ) return _ch[i].utc;
+    }
+    return 0;
+}
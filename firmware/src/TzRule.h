@@ -0,0 +1,100 @@
+/**
+ * @file    TzRule.h
+ * @brief   Compact daylight-saving rule and a two-year table of its transitions.
+ *
+ * @details
+ * Replaces the hard-coded North American @c isDST() check that getLTime() ran
+ * for every local-time mark.  A @c TzRule holds the DST shift and the start /
+ * end rules in POSIX "Mm.w.d/time" form; it is persisted in ConfigExt and set
+ * through s_Config "TZR" (e.g. "M3.2.0/2,M11.1.0/2" for the US,
+ * "M3.5.0/2,M10.5.0/3" for the EU).  The standard offset is not part of the
+ * rule: it stays in ConfigData.STD and is passed in when the table is built.
+ *
+ * @c TzTable precomputes the four transitions of the current and next year, so
+ * a local wall-clock time converts to UTC with one binary search and the
+ * scheduler can ask for the next DST boundary.  Times outside those two years
+ * are computed directly from the rule.
+ *
+ * As in POSIX TZ strings, the start time is standard wall time and the end
+ * time is daylight wall time.  A wall time in the repeated hour after the end
+ * resolves to its first (daylight) occurrence; one in the skipped hour after
+ * the start resolves as daylight time.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+/// One DST change: the @c week'th @c wday of @c month at @c minute (wall time).
+struct DstRule {
+    uint8_t month;     // 1..12
+    uint8_t week;      // 1..4, 5 = last
+    uint8_t wday;      // 0 = Sunday
+    uint8_t pad;
+    int16_t minute;    // minutes past local midnight
+};
+static_assert( sizeof(DstRule) == 6, "DstRule layout changed" );
+
+/// DST shift plus the start / end rules.  @c saveMin == 0 means no DST.
+struct TzRule {
+    int16_t saveMin;   // minutes added during DST (normally 60)
+    DstRule start;     // change to DST, in standard wall time
+    DstRule end;       // change back, in daylight wall time
+};
+static_assert( sizeof(TzRule) == 14, "TzRule layout changed" );
+
+namespace TzRules {
+
+/// Longest string format() produces, excluding the terminator.
+static const size_t MAX_LEN = 24;
+
+/// US / Canada since 2007: second Sunday of March to first Sunday of November, 02:00.
+TzRule northAmerica();
+
+/// Parse "Mm.w.d[/h[:mm]],Mm.w.d[/h[:mm]]" (time defaults to 02:00; shift is
+/// 60 minutes).  Returns false and leaves @p r untouched on a syntax error.
+bool   parse ( const char *s, TzRule &r );
+/// Inverse of parse().
+void   format( const TzRule &r, char *buf, size_t len );
+
+/// Epoch day (days since 1970-01-01) on which @p d falls in @p year.
+int32_t ruleDay( const DstRule &d, int year );
+
+} // namespace TzRules
+
+/// Transitions of one rule for two consecutive years, for fast local → UTC.
+class TzTable {
+public:
+    /// Precompute @p year and @p year + 1 for @p rule at standard offset
+    /// @p stdMin (minutes, west negative).
+    void   build( const TzRule &rule, int stdMin, int year );
+
+    /// First year covered (0 before build()).
+    int    year() const { return _year; }
+
+    /// UTC epoch of local wall-clock time @p wall (wall-clock fields encoded
+    /// as if they were UTC).
+    time_t toUTC( time_t wall ) const;
+
+    /// First transition strictly after @p utc within the table, or 0.
+    time_t nextChange( time_t utc ) const;
+
+private:
+    struct Change {
+        time_t wall;   // wall time of the change, on the clock in force before it
+        time_t utc;
+        bool   dst;    // DST in force after the change
+    };
+
+    // One year's two changes, sorted by time
+    static void yearChanges( const TzRule &r, int stdMin, int year, Change out[2] );
+    static bool dstAt( const Change *c, int n, time_t wall );
+
+    TzRule _rule   = {};
+    int    _stdMin = 0;
+    int    _year   = 0;
+    int    _n      = 0;
+    Change _ch[4];
+};
@@ -14,8 +14,10 @@
 #include "BuzzerManager.h"
 #include "SmartFlagFSM.h"
 #include "EEPROMManager.h"
+#include "EEPROMShadow.h"
 #include "FlagUtils.h"
 #include "EventManager.h"
+#include "Deadlines.h"
 
 PRODUCT_VERSION(7)          // firmware version, for OTA update tracking
 
@@ -107,11 +109,14 @@ void setup() {
     Particle.function("PlayID",     playIDTones);
     Particle.function("clearFault", remoteClearFault);
     Particle.function("dbg",        dbgToggle);
+    SFDBG::setup();                         // s_DbgLog / s_DbgPage diagnostic ring
     Particle.function("s_Config",   static_cast<int(*)(String)>([](String s) -> int {
         return evMgr.configScheduler(s);    // event scheduler configuration
     }));
     Particle.function("s_InjectEv", static_cast<int(*)(String)>([](String s) -> int {
-        return evMgr.receiveEvent(s);       // direct event injection (catch-up for offline units)
+        s.trim();                           // direct event injection (catch-up for offline units):
+        return s.startsWith("[") ? evMgr.receiveEvents(s)   // array → one batch, one report
+                                 : evMgr.receiveEvent(s);
     }));
 
     // ── Cloud variables ───────────────────────────────────────────────────────
@@ -132,6 +137,8 @@ void setup() {
 
     // ── EEPROM ────────────────────────────────────────────────────────────────
     //  Must come after cloud connection (validateOrMigrateEEPROM may publish).
+    //  EEPROMManager reads and writes the RAM shadow; loop() flushes it.
+    eepromShadow.begin();
     if (!validateOrMigrateEEPROM()) {
         Log.error("EEPROM validation failed — running with defaults.");
         initEEPROM();
@@ -139,6 +146,7 @@ void setup() {
     validateOrInitConfigExt();
     halMgr1.applyConfigExtToRuntime();
     bumpRebootCount();
+    eepromShadow.commit();      // a migrated image lands before anything else runs
 
     // ── EventManager ─────────────────────────────────────────────────────────
     //  Must come after EEPROM is valid (reads ConfigData / ConfigExt) and
@@ -148,9 +156,10 @@ void setup() {
     //    - copies config fields from EEPROM (lat/lng, jurisdiction, TZ, etc.)
     //    - restores stored event list from EEPROM
     //    - reprocesses all events against current time and config
-    //    - registers Particle variables: s_EventLIST, s_ShowConfig, s_Event
-    //    - registers Particle function: s_EvIdx
-    //    - calls resetSubscriptions() → subscribes to configured FED/STA topics
+    //    - registers Particle variables: s_EventLIST, s_ShowConfig, s_Event,
+    //      s_BatchRC, s_Timeline
+    //    - registers Particle functions: s_EvIdx, s_EvLPage, s_EvHavePg, s_TlPage
+    //    - calls updateSubscriptions() → routes configured FED/STA/SUB topics
     //
     //  The lambda routes EventManager's ordered-station output to halMgr1.
     //  Note: this will set the ordered station based on any active/pending
@@ -176,12 +185,20 @@ void setup() {
     // ── FSM ───────────────────────────────────────────────────────────────────
     setupFSM(fsm);
     fsm.begin(STATE_STARTUP);
+
+    // ── Periodic status heartbeat (first report on the first loop) ───────────
+    beginStatusReports();
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  loop()
 // ─────────────────────────────────────────────────────────────────────────────
 void loop() {
+    // Time-driven work (event checks, forced-station expiry, move timeout,
+    // status heartbeat, lid countdown, fault timeout) runs from here when due;
+    // deadlines.msUntilNext() is how long the unit could sleep.
+    deadlines.poll();
+
     buzzer.update();
 
     if (!lidSensor.isPresent() && fsm.currentState() != STATE_LID_OPEN) {
@@ -190,9 +207,10 @@ void loop() {
 
     halMgr1.update();
     fsm.update();
-    checkAndReportStatus(false, "RPT");
     serviceRemoteRequests();
-    evMgr.loop();       // software-timer event checking → checkForChange()
+    evMgr.loop();       // checkForChange() once its deadline has fired
+
+    eepromShadow.commit();  // this pass's EEPROM writes, as coalesced spans
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
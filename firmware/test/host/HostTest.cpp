@@ -0,0 +1,65 @@
+#include "HostTest.h"
+
+#include <chrono>
+
+#include "Sensor.h"
+#include "EventManager.h"
+#include "Deadlines.h"
+#include "EEPROMShadow.h"
+#include "Subscriptions.h"
+
+// Pin numbers from main.ino (not exported by any header)
+static const pin_t HOST_HALF_SENSOR_PIN = D10;
+static const pin_t HOST_FULL_SENSOR_PIN = D11;
+static const pin_t HOST_LID_SENSOR_PIN  = D12;
+
+void setup();
+void loop();
+
+namespace HostTest {
+
+void bootFirmware( time_t epoch, bool keepEEPROM ) {
+    if ( keepEEPROM ) eepromShadow.commit();             // the reset follows a finished loop() pass
+    HostSim::reset( !keepEEPROM );
+    reloadConfigCache();                                 // RAM config / status copies do not survive a reset
+    reloadStatusLog();
+    HostSim::setDigital( HOST_LID_SENSOR_PIN,  LOW  );   // lid closed
+    HostSim::setDigital( HOST_FULL_SENSOR_PIN, LOW  );   // flag at FULL marker
+    HostSim::setDigital( HOST_HALF_SENSOR_PIN, HIGH );
+    HostSim::setTime( epoch, false );
+    evMgr = EventManager();                              // fresh RAM state, as after reset
+    deadlines.clear();
+    subscriptions.clear();
+    setup();
+}
+
+void runLoop( unsigned long totalMs, unsigned long stepMs ) {
+    unsigned long end = HostSim::nowMs() + totalMs;
+    while ( HostSim::nowMs() < end ) {
+        loop();
+        HostSim::advanceMs( stepMs );
+    }
+}
+
+void configureUnit( const char *json ) {
+    if ( json == nullptr ) {
+        json = "{\"LAT\":40.0,\"LNG\":-83.0,\"STD\":-5,\"DST\":true,"
+               "\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\",\"FPR\":2}";
+    }
+    int rc = -1;
+    HT_CHECK( HostSim::callFunction( "s_Config", json, rc ) );
+    HT_CHECK_EQ( rc, 0 );
+}
+
+String eventJSON( int id, int ver, const char *jur, const char *bmk, const char *emk ) {
+    return String::format(
+        "{\"IDV\":\"%d.%d\",\"JUR\":\"%s\",\"FLG\":\"US\",\"BMK\":\"%s\",\"EMK\":\"%s\"}",
+        id, ver, jur, bmk, emk );
+}
+
+uint64_t hostNanos() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+} // namespace HostTest
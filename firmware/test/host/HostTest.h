@@ -0,0 +1,80 @@
+/**
+ * @file    HostTest.h
+ * @brief   Minimal self-registering test harness and firmware boot helpers
+ *          for the host build.
+ *
+ * @details
+ * Each test_*.cpp declares cases with @c HT_TEST(name) and is linked against
+ * HostTestMain.cpp, which runs every registered case in declaration order and
+ * returns non-zero if any check failed.  No external framework is required.
+ */
+
+#pragma once
+
+#include "Particle.h"
+#include "HostSim.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace HostTest {
+
+struct Case {
+    const char *name;
+    void (*fn)();
+};
+
+inline std::vector<Case> &cases()    { static std::vector<Case> v; return v; }
+inline int               &failures() { static int n = 0; return n; }
+
+struct Registrar {
+    Registrar( const char *name, void (*fn)() ) { cases().push_back( { name, fn } ); }
+};
+
+/// Power-on the simulated unit at @p epoch (UTC) and run the real setup().
+/// The lid is closed and the flag sits on the FULL marker.  EEPROM is wiped
+/// unless @p keepEEPROM is true (reboot with persisted state).
+void bootFirmware( time_t epoch, bool keepEEPROM = false );
+
+/// Run loop() repeatedly while advancing the virtual clock by @p stepMs,
+/// until @p totalMs of virtual time has elapsed.
+void runLoop( unsigned long totalMs, unsigned long stepMs = 10 );
+
+/// Configure through s_Config and check it was accepted.  With no @p json,
+/// sets up the standard test unit: Columbus, OH (LAT 40, LNG -83, US DST),
+/// FED FE-US, STA FE-OH, upper flag OH at state priority.
+void configureUnit( const char *json = nullptr );
+
+/// FlagEvent JSON as the backend publishes it, with FLG "US".  The default
+/// marks are one hour on 2025-06-20 (UTC).
+String eventJSON( int id, int ver = 1, const char *jur = "FE-US",
+                  const char *bmk = "2025-06-20T12:00Z", const char *emk = "2025-06-20T13:00Z" );
+
+/// Monotonic host wall-clock in nanoseconds, for benchmarks.
+uint64_t hostNanos();
+
+} // namespace HostTest
+
+#define HT_TEST(name)                                                          \
+    static void name();                                                        \
+    static HostTest::Registrar name##_registrar( #name, name );                \
+    static void name()
+
+#define HT_CHECK(cond)                                                         \
+    do {                                                                       \
+        if ( !(cond) ) {                                                       \
+            fprintf( stderr, "%s:%d: CHECK failed: %s\n",                      \
+                     __FILE__, __LINE__, #cond );                              \
+            HostTest::failures()++;                                            \
+        }                                                                      \
+    } while (0)
+
+#define HT_CHECK_EQ(a, b)                                                      \
+    do {                                                                       \
+        auto _a = (a); auto _b = (b);                                          \
+        if ( !( _a == _b ) ) {                                                 \
+            fprintf( stderr, "%s:%d: CHECK_EQ failed: %s == %s (%lld vs %lld)\n", \
+                     __FILE__, __LINE__, #a, #b, (long long)_a, (long long)_b ); \
+            HostTest::failures()++;                                            \
+        }                                                                      \
+    } while (0)
@@ -0,0 +1,11 @@
+#include "HostTest.h"
+
+// Runs every HT_TEST case registered by the linked test_*.cpp file.
+int main() {
+    for ( const HostTest::Case &c : HostTest::cases() ) {
+        int before = HostTest::failures();
+        c.fn();
+        printf( "%-40s %s\n", c.name, HostTest::failures() == before ? "ok" : "FAILED" );
+    }
+    return HostTest::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file    LegacySchedule.h
+ * @brief   Reference copy of the Gen2 setNextEvent() overlap loop.
+ *
+ * @details
+ * Kept verbatim (minus the EventManager plumbing) so host tests and benchmarks
+ * can compare EventIndex against the algorithm it replaced.  Input is a list
+ * of applicable events' raw [GMTbegin, GMTend) marks, GMTend == 0 meaning
+ * open-ended.  Events the legacy loop would have cleared are flagged in
+ * @c cleared.
+ */
+
+#pragma once
+
+#include "Particle.h"
+#include "HalyardManager.h"
+
+#include <vector>
+
+struct LegacyResult {
+    FlagStation orderedSta;
+    time_t      nextChange;
+    FlagStation nextSta;
+};
+
+inline LegacyResult legacySetNextEvent( const std::vector<time_t> &GMTbegin,
+                                        const std::vector<time_t> &GMTend,
+                                        time_t now,
+                                        std::vector<bool> *cleared = nullptr ) {
+    const size_t N = GMTbegin.size();
+    time_t nullT      = now + 30L * 24 * 60 * 60;
+    time_t mxEnd      = now;
+    time_t nxBeg      = nullT;
+    bool   inProgress = false;
+    bool   waiting    = false;
+
+    std::vector<bool>   applies( N, true );
+    std::vector<time_t> begs( N, 0 ), ends( N, 0 );
+
+    for ( size_t idx = 0; idx < N; idx++ ) {
+        begs[idx] = GMTbegin[idx];
+        ends[idx] = ( GMTend[idx] == 0 ) ? nullT : GMTend[idx];
+
+        if ( begs[idx] > now ) {
+            waiting = true;
+            nxBeg = min( nxBeg, begs[idx] );
+        } else if ( begs[idx] > 0 && ends[idx] > now ) {
+            inProgress = true;
+            mxEnd = max( mxEnd, ends[idx] );
+        } else {
+            applies[idx] = false;   // clearEvent()
+        }
+    }
+
+    bool changed = true;
+    while ( changed ) {
+        changed = false;
+        for ( size_t idx = 0; idx < N; idx++ ) {
+            if ( !applies[idx] ) continue;
+            if ( begs[idx] > now && begs[idx] <= mxEnd && ends[idx] > mxEnd ) {
+                mxEnd   = ends[idx];
+                changed = true;
+            }
+        }
+    }
+
+    if ( cleared ) {
+        cleared->assign( N, false );
+        for ( size_t i = 0; i < N; i++ ) (*cleared)[i] = !applies[i];
+    }
+
+    if ( inProgress ) return { FLAG_HALF, mxEnd, FLAG_FULL };
+    if ( waiting )    return { FLAG_FULL, nxBeg, FLAG_HALF };
+    return { FLAG_FULL, 0, FLAG_UNKNOWN };
+}
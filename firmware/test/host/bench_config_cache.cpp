@@ -0,0 +1,52 @@
+/**
+ * @file    bench_config_cache.cpp
+ * @brief   Cost of a config read, and of a loop() pass that checks the status
+ *          heartbeat, with and without the RAM config cache.
+ *
+ * "uncached" drops the cache before every read, so each one loads ConfigData
+ * as after a reset: both A/B slots and their tags read and CRC-checked.
+ * The loop figures run the heartbeat check on every
+ * pass, as checkAndReportStatus(false, "RPT") was before the deadline
+ * scheduler, so the config read is on the per-loop path being measured.
+ */
+
+#include "HostTest.h"
+#include "EEPROMManager.h"
+#include "FlagUtils.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+void loop();
+
+static void report( const char *what, int n, uint64_t ns, uint32_t gets ) {
+    printf( "  %-34s %10.1f ns  %5.2f EEPROM.get\n", what, (double)ns / n, (double)gets / n );
+}
+
+template <typename F>
+static void run( const char *what, int n, F f ) {
+    HostSim::resetEepromStats();
+    uint64_t t0 = HostTest::hostNanos();
+    for ( int i = 0; i < n; i++ ) f();
+    report( what, n, HostTest::hostNanos() - t0, HostSim::eepromStats().getCalls );
+}
+
+int main() {
+    HostTest::bootFirmware( T0 );
+    checkAndReportStatus( false, "RPT" );       // first heartbeat: later checks only re-arm
+    HostSim::clearPublished();
+
+    const int N = 200000;
+    volatile uint32_t sink = 0;
+    printf( "config read (N=%d)\n", N );
+    run( "readConfig(), uncached", N, [&] { reloadConfigCache(); ConfigData c; readConfig( c ); sink += c.status_period_sec; } );
+    run( "readConfig(), cached",   N, [&] { ConfigData c; readConfig( c ); sink += c.status_period_sec; } );
+    run( "configData(), cached",   N, [&] { sink += configData().status_period_sec; } );
+
+    printf( "loop() with a heartbeat check per pass (N=%d)\n", N );
+    run( "uncached", N, [&] { reloadConfigCache(); checkAndReportStatus( false, "RPT" ); loop(); } );
+    run( "cached",   N, [&] { checkAndReportStatus( false, "RPT" ); loop(); } );
+    run( "loop() alone", N, [&] { loop(); } );
+
+    return (int)( sink & 0 );
+}
@@ -0,0 +1,55 @@
+/**
+ * @file    bench_eeprom_shadow.cpp
+ * @brief   Logical against physical EEPROM writes over one simulated day, and
+ *          EEPROM reads per event load.
+ *
+ * Same day as bench_status_log, with a full event table: one boot, N_EVENTS
+ * events, two of them today, an hourly time sync.  "logical" is every
+ * put()/write() EEPROMManager made (each reached EEPROM before the shadow);
+ * "physical" is the spans loop() and the A/B commits actually wrote.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "EEPROMManager.h"
+#include "EEPROMShadow.h"
+
+// 2025-06-15 00:00:00 UTC
+static const time_t T0 = 1749945600;
+
+int main() {
+    HostTest::bootFirmware( T0 );
+    eepromShadow.resetStats();
+    HostSim::resetEepromStats();
+
+    int rc = -1;
+    HostSim::callFunction( "s_Config",
+        "{\"LAT\":40.0,\"LNG\":-83.0,\"STD\":-5,\"DST\":true,\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\"}", rc );
+    HostSim::deliver( "FE-US",
+        "{\"IDV\":\"101.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-06-15T13:00Z\",\"EMK\":\"2025-06-15T15:00Z\"}" );
+    HostSim::deliver( "FE-OH",
+        "{\"IDV\":\"102.1\",\"JUR\":\"FE-OH\",\"FLG\":\"OH\",\"BMK\":\"2025-06-15T18:00Z\",\"EMK\":\"2025-06-15T22:00Z\"}" );
+    for ( int i = 0; i < EventManager::N_EVENTS - 2; i++ ) {
+        HostSim::deliver( "FE-US", String::format(
+            "{\"IDV\":\"%d.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-06-%02dT12:00Z\",\"EMK\":\"2025-06-%02dT13:00Z\"}",
+            200 + i, 17 + i % 12, 17 + i % 12 ).c_str() );
+        HostTest::runLoop( 1000, 1000 );
+    }
+    for ( int h = 0; h < 24; h++ ) {
+        HostTest::runLoop( 3600UL * 1000, 1000 );
+        HostSim::setTime( Time.now() );
+    }
+
+    const EEPROMShadow::Stats &st = eepromShadow.stats();
+    printf( "EEPROM writes, configure + %d events + one day\n", EventManager::N_EVENTS );
+    printf( "  %-28s %6lu calls %7lu bytes\n", "logical (before)",
+            (unsigned long)st.logicalWrites, (unsigned long)st.logicalBytes );
+    printf( "  %-28s %6lu calls %7lu bytes\n", "physical (after)",
+            (unsigned long)st.physicalWrites, (unsigned long)st.physicalBytes );
+
+    HostSim::resetEepromStats();
+    HostTest::bootFirmware( T0 + 86400, true );
+    printf( "boot with %d events stored (%s)\n", evMgr.getNEvents(), evMgr.showDigest().c_str() );
+    printf( "  %-28s %6lu EEPROM reads\n", "setup()", (unsigned long)HostSim::eepromStats().getCalls );
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file    bench_event_parse.cpp
+ * @brief   Heap allocations and time per inbound event / config message.
+ *
+ * The event case re-sends a superseded version of a resident event, so
+ * receiveEvent() parses, validates and matches it but has nothing to commit:
+ * what is measured is the parse path alone.  The config case re-applies an
+ * unchanged s_Config payload, which also includes the ConfigData / ConfigExt
+ * read-modify-write.  Global operator new is wrapped to count allocations.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+#include <cstdlib>
+#include <new>
+
+static uint64_t g_allocs = 0;
+
+void *operator new( size_t n ) {
+    void *p = malloc( n ? n : 1 );
+    if ( !p ) throw std::bad_alloc();
+    g_allocs++;
+    return p;
+}
+void operator delete( void *p ) noexcept { free( p ); }
+void operator delete( void *p, size_t ) noexcept { free( p ); }
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static const char *CONFIG =
+    "{\"LAT\":40.0,\"LNG\":-83.0,\"STD\":-5,\"DST\":true,\"FED\":\"FE-US\",\"STA\":\"FE-OH\","
+    "\"FLG\":\"OH\",\"FPR\":2,\"ZIP\":\"43215\",\"SJR\":[12,34]}";
+
+static void report( const char *what, int n, uint64_t allocs, uint64_t ns ) {
+    printf( "  %-28s %6.2f allocs  %8.2f us\n", what, (double)allocs / n, ns / 1e3 / n );
+}
+
+int main() {
+    HostTest::bootFirmware( T0 );
+    evMgr.configScheduler( CONFIG );
+    evMgr.receiveEvent( "{\"IDV\":\"7.5\",\"JUR\":\"FE-US\",\"FLG\":\"US\","
+                        "\"BMK\":\"2025-06-20TSR\",\"EMK\":\"2025-06-20T23:00Z\",\"SJR\":[12,34,56]}" );
+    HostSim::clearPublished();
+
+    // Held outside the timed loops so argument construction is not counted
+    const String stale  = "{\"IDV\":\"7.4\",\"JUR\":\"FE-US\",\"FLG\":\"US\","
+                          "\"BMK\":\"2025-06-20TSR\",\"EMK\":\"2025-06-20T23:00Z\",\"SJR\":[12,34,56]}";
+    const String config = CONFIG;
+
+    const int N = 20000;
+    printf( "per message (N=%d)\n", N );
+
+    uint64_t a0 = g_allocs, t0 = HostTest::hostNanos();
+    for ( int i = 0; i < N; i++ ) evMgr.receiveEvent( stale );
+    report( "event parse (stale IDV)", N, g_allocs - a0, HostTest::hostNanos() - t0 );
+
+    a0 = g_allocs; t0 = HostTest::hostNanos();
+    for ( int i = 0; i < N; i++ ) evMgr.configScheduler( config );
+    report( "config apply (unchanged)", N, g_allocs - a0, HostTest::hostNanos() - t0 );
+
+    printf( "  events resident              %d\n", evMgr.getNEvents() );
+    return 0;
+}
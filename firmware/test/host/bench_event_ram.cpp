@@ -0,0 +1,90 @@
+/**
+ * @file    bench_event_ram.cpp
+ * @brief   Static RAM of the event table and heap behaviour over 10,000
+ *          receive/delete cycles.
+ *
+ * Global operator new/delete are wrapped to count allocations and live bytes;
+ * glibc mallinfo2() reports how fragmented the arena is at the end (free
+ * chunks and free bytes still held inside the heap).
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+static uint64_t g_allocs = 0, g_frees = 0;
+static int64_t  g_live   = 0, g_peak = 0;
+
+void *operator new( size_t n ) {
+    void *p = malloc( n ? n : 1 );
+    if ( !p ) throw std::bad_alloc();
+    g_allocs++;
+    g_live += (int64_t)malloc_usable_size( p );
+    if ( g_live > g_peak ) g_peak = g_live;
+    return p;
+}
+void operator delete( void *p ) noexcept {
+    if ( !p ) return;
+    g_frees++;
+    g_live -= (int64_t)malloc_usable_size( p );
+    free( p );
+}
+void operator delete( void *p, size_t ) noexcept { operator delete( p ); }
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+int main() {
+    printf( "static RAM\n" );
+    printf( "  sizeof(FlagEventEx)        %5zu bytes\n", sizeof(FlagEventEx) );
+    printf( "  event table (N_EVENTS=%d)  %5zu bytes\n", EventManager::N_EVENTS,
+            sizeof(FlagEventEx) * EventManager::N_EVENTS );
+    printf( "  sizeof(EventManager)       %5zu bytes\n", sizeof(EventManager) );
+    printf( "  EEPROM save/load scratch   %5zu bytes\n",     // s_evIO in EventManager.cpp
+            EventManager::N_EVENTS * ( sizeof(PackedEvent) + sizeof(int32_t) + 2 * ( sizeof(const char *) + sizeof(int) ) ) );
+
+    HostTest::bootFirmware( T0 );
+    int rc;
+    HostSim::callFunction( "s_Config", "{\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\"}", rc );
+    // Keep ten events resident so each cycle works against a populated table
+    for ( int id = 1; id <= 10; id++ ) {
+        String js = String::format( "{\"IDV\":\"%d.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\","
+                                    "\"BMK\":\"2025-06-2%dT12:00Z\",\"EMK\":\"2025-06-2%dT13:00Z\"}", id, id % 9, id % 9 );
+        HostSim::callFunction( "s_InjectEv", js, rc );
+    }
+
+    HostSim::clearPublished();
+    struct mallinfo2 m0 = mallinfo2();
+    uint64_t a0 = g_allocs, f0 = g_frees;
+    int64_t  live0 = g_live;
+    g_peak = g_live;
+
+    const int CYCLES = 10000;
+    uint64_t t0 = HostTest::hostNanos();
+    for ( int i = 0; i < CYCLES; i++ ) {
+        int id = 100 + i;
+        String add = String::format( "{\"IDV\":\"%d.1\",\"JUR\":\"FE-OH-%d\",\"FLG\":\"OH\","
+                                     "\"BMK\":\"2025-06-20TSR\",\"EMK\":\"2025-06-20T23:00Z\",\"SJR\":[%d,%d]}",
+                                     id, i % 50, i % 7, i % 11 );
+        HostSim::callFunction( "s_InjectEv", add, rc );
+        String del = String::format( "{\"IDV\":\"%d.2\",\"DEL\":true}", id );
+        HostSim::callFunction( "s_InjectEv", del, rc );
+        HostSim::clearPublished();   // the shim's publish log is not firmware heap
+    }
+    uint64_t ns = HostTest::hostNanos() - t0;
+    struct mallinfo2 m1 = mallinfo2();
+
+    printf( "heap over %d receive/delete cycles\n", CYCLES );
+    printf( "  allocations / cycle        %8.1f\n", (double)( g_allocs - a0 ) / CYCLES );
+    printf( "  frees / cycle              %8.1f\n", (double)( g_frees  - f0 ) / CYCLES );
+    printf( "  live bytes  start/end/peak %lld / %lld / %lld\n",
+            (long long)live0, (long long)g_live, (long long)g_peak );
+    printf( "  arena bytes start/end      %zu / %zu\n", m0.arena, m1.arena );
+    printf( "  free chunks start/end      %zu / %zu\n", m0.ordblks, m1.ordblks );
+    printf( "  free bytes in arena end    %zu\n", m1.fordblks );
+    printf( "  time / cycle               %8.1f us\n", ns / 1e3 / CYCLES );
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file    bench_reprocess.cpp
+ * @brief   reprocessEvents() on a full table of mixed marks, and the date
+ *          conversions it used to make through libc.
+ *
+ * The table holds N_EVENTS events spread over sun (date-only / SR / SS),
+ * absolute (Z) and local (L) marks, so every resolution path runs.  The
+ * second block compares CivilDate against the mktime() / gmtime_r() calls
+ * the Gen2 resolver made per mark.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "CivilDate.h"
+
+#include <ctime>
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static void report( const char *what, int n, uint64_t ns ) {
+    printf( "  %-28s %10.1f ns\n", what, (double)ns / n );
+}
+
+int main() {
+    HostTest::bootFirmware( T0 );
+    evMgr.configScheduler( "{\"LAT\":40.0,\"LNG\":-83.0,\"STD\":-5,\"DST\":true,"
+                           "\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\"}" );
+    static const char *KINDS[][2] = {
+        { "",       "" },   { "TSR",    "TSS"    },
+        { "T10:00Z", "T18:00Z" }, { "T08:00L", "T20:00L" },
+    };
+    for ( int i = 0; i < EventManager::N_EVENTS; i++ ) {
+        const char *const *k = KINDS[i % 4];
+        String d = String::format( "2025-12-%02d", 1 + i );   // sunset before 00:00 UTC at this site
+        evMgr.receiveEvent( String::format(
+            "{\"IDV\":\"%d.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"%s%s\",\"EMK\":\"%s%s\"}",
+            100 + i, d.c_str(), k[0], d.c_str(), k[1] ) );
+    }
+    HostSim::clearPublished();
+
+    const int N = 20000;
+    printf( "reprocessEvents(), %d events (N=%d)\n", evMgr.getNEvents(), N );
+    uint64_t t0 = HostTest::hostNanos();
+    for ( int i = 0; i < N; i++ ) evMgr.reprocessEvents();
+    report( "per reprocess", N, HostTest::hostNanos() - t0 );
+
+    const int M = 1000000;
+    volatile long sink = 0;
+    printf( "date conversion (N=%d)\n", M );
+
+    t0 = HostTest::hostNanos();
+    for ( int i = 0; i < M; i++ ) {
+        struct tm t = {};
+        t.tm_year = 125; t.tm_mon = i % 12; t.tm_mday = 1 + i % 28;
+        sink += (long)mktime( &t );
+    }
+    report( "mktime()", M, HostTest::hostNanos() - t0 );
+
+    t0 = HostTest::hostNanos();
+    for ( int i = 0; i < M; i++ ) {
+        sink += (long)CivilDate::fromFields( 2025, 1 + i % 12, 1 + i % 28 );
+    }
+    report( "CivilDate::fromFields()", M, HostTest::hostNanos() - t0 );
+
+    t0 = HostTest::hostNanos();
+    for ( int i = 0; i < M; i++ ) {
+        time_t t = T0 + (time_t)i * 86400;
+        struct tm g;
+        gmtime_r( &t, &g );
+        sink += g.tm_yday;
+    }
+    report( "gmtime_r()", M, HostTest::hostNanos() - t0 );
+
+    t0 = HostTest::hostNanos();
+    for ( int i = 0; i < M; i++ ) {
+        sink += CivilDate::yearDay( (int32_t)( T0 / 86400 ) + i );
+    }
+    report( "CivilDate::yearDay()", M, HostTest::hostNanos() - t0 );
+
+    return (int)( sink & 0 );
+}
@@ -0,0 +1,70 @@
+/**
+ * @file    bench_set_next_event.cpp
+ * @brief   Legacy fixed-point overlap loop vs EventIndex at 20 / 200 / 2000 events.
+ *
+ * Two workloads per size:
+ *  - random:  windows scattered over +/- a few days around now
+ *  - chained: back-to-back future windows listed latest-first, the legacy
+ *             loop's worst case (one extension per full pass)
+ */
+
+#include "HostTest.h"
+#include "EventIndex.h"
+#include "LegacySchedule.h"
+
+#include <random>
+
+static const time_t NOW = 1750000000;
+
+static double nsPer( uint64_t t0, uint64_t t1, int iters ) { return (double)( t1 - t0 ) / iters; }
+
+static void run( const char *label, const std::vector<time_t> &b, const std::vector<time_t> &e ) {
+    const int n     = (int)b.size();
+    const int iters = n >= 2000 ? 5 : n >= 200 ? 200 : 20000;
+    volatile long sink = 0;
+
+    uint64_t t0 = HostTest::hostNanos();
+    for ( int i = 0; i < iters; i++ ) sink += (long)legacySetNextEvent( b, e, NOW ).nextChange;
+    uint64_t t1 = HostTest::hostNanos();
+
+    std::vector<EventSpan> spans( n );
+    time_t nullT = NOW + 30L * 24 * 60 * 60;
+    uint64_t t2 = HostTest::hostNanos();
+    for ( int i = 0; i < iters; i++ ) {
+        int m = 0;
+        for ( int k = 0; k < n; k++ ) {
+            time_t end = e[k] ? e[k] : nullT;
+            if ( b[k] > NOW || ( b[k] > 0 && end > NOW ) ) spans[m++] = { b[k], end };
+        }
+        m = EventIndex::merge( spans.data(), m );
+        time_t nc; FlagStation ns;
+        EventIndex::query( spans.data(), m, NOW, nc, ns );
+        sink += (long)nc;
+    }
+    uint64_t t3 = HostTest::hostNanos();
+
+    printf( "%-8s N=%-5d legacy %12.0f ns   index %10.0f ns   speedup %7.1fx\n",
+            label, n, nsPer( t0, t1, iters ), nsPer( t2, t3, iters ),
+            nsPer( t0, t1, iters ) / nsPer( t2, t3, iters ) );
+}
+
+int main() {
+    std::mt19937 rng( 7 );
+    for ( int n : { 20, 200, 2000 } ) {
+        std::vector<time_t> b( n ), e( n );
+        std::uniform_int_distribution<int> off( -72, 72 ), len( 1, 24 );
+        for ( int i = 0; i < n; i++ ) { b[i] = NOW + off( rng ) * 3600L; e[i] = b[i] + len( rng ) * 3600L; }
+        run( "random", b, e );
+
+        // In-progress window at [now-1h, now+1h), then n-1 back-to-back future
+        // windows stored in reverse order.
+        b[0] = NOW - 3600; e[0] = NOW + 3600;
+        for ( int i = 1; i < n; i++ ) {
+            int k = n - i;
+            b[i] = NOW + 3600L * k;
+            e[i] = NOW + 3600L * ( k + 1 );
+        }
+        run( "chained", b, e );
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file    bench_status_log.cpp
+ * @brief   StatusData EEPROM writes over one simulated day.
+ *
+ * One boot, two half-staff events and an hourly cloud time sync, through the
+ * real setup() / loop().  "requested" is every writeStatus() call; before the
+ * status log each one rewrote the same 64-byte block.  "appended" is the
+ * records actually written, spread over STATUS_LOG_SLOTS slots.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "EEPROMManager.h"
+
+// 2025-06-15 00:00:00 UTC
+static const time_t T0 = 1749945600;
+
+int main() {
+    HostTest::bootFirmware( T0 );
+    int rc = -1;
+    HostSim::callFunction( "s_Config",
+        "{\"LAT\":40.0,\"LNG\":-83.0,\"STD\":-5,\"DST\":true,\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\"}", rc );
+    HostSim::deliver( "FE-US",
+        "{\"IDV\":\"101.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-06-15T13:00Z\",\"EMK\":\"2025-06-15T15:00Z\"}" );
+    HostSim::deliver( "FE-OH",
+        "{\"IDV\":\"102.1\",\"JUR\":\"FE-OH\",\"FLG\":\"OH\",\"BMK\":\"2025-06-15T18:00Z\",\"EMK\":\"2025-06-15T22:00Z\"}" );
+
+    // A day of loop() at 1 s (the counters started at boot)
+    for ( int h = 0; h < 24; h++ ) {
+        HostTest::runLoop( 3600UL * 1000, 1000 );
+        HostSim::setTime( Time.now() );
+    }
+
+    StatusLogStats st = statusLogStats();
+    printf( "StatusData writes, boot + one day\n" );
+    printf( "  %-28s %6lu x 64 bytes, one block\n", "requested (before)", (unsigned long)st.writes );
+    printf( "  %-28s %6lu x 32 bytes, %d slots\n", "appended (after)", (unsigned long)st.appends, STATUS_LOG_SLOTS );
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file    bench_sun_calc.cpp
+ * @brief   Cost of one sunrise/sunset solve: the Gen2 libm kernel vs the
+ *          polynomial kernel, alone and inside a sun-table build.
+ *
+ * The table build is the one place that solves in bulk (732 events per site
+ * change); it runs with whichever kernel this build selected (SF_FAST_SUN).
+ * Rebuild with -DSF_FAST_SUN=ON to compare.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "SunCalc.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+int main() {
+    const int N = 200;
+    volatile long sink = 0;
+    int solves = 0;
+
+    uint64_t t0 = HostTest::hostNanos();
+    for ( int i = 0; i < N; i++ ) {
+        float lat = -66.0f + ( i % 133 );
+        for ( int doy = 0; doy < 366; doy++ ) {
+            sink += SunCalc::exact( lat, -83.0f, doy, 0 ) + SunCalc::exact( lat, -83.0f, doy, 1 );
+        }
+    }
+    uint64_t exactNs = HostTest::hostNanos() - t0;
+    solves = N * 366 * 2;
+
+    t0 = HostTest::hostNanos();
+    for ( int i = 0; i < N; i++ ) {
+        float lat = -66.0f + ( i % 133 );
+        SunCalc::Site site = SunCalc::site( lat, -83.0f );
+        for ( int doy = 0; doy < 366; doy++ ) {
+            sink += SunCalc::fast( site, doy, 0 ) + SunCalc::fast( site, doy, 1 );
+        }
+    }
+    uint64_t fastNs = HostTest::hostNanos() - t0;
+
+    printf( "sun solve (N=%d)\n", solves );
+    printf( "  SunCalc::exact()   %8.1f ns\n", (double)exactNs / solves );
+    printf( "  SunCalc::fast()    %8.1f ns  (max error %d s, |lat| <= 66)\n",
+            (double)fastNs / solves, SunCalc::FAST_MAX_ERR_S );
+
+    // Sun-table rebuild on a site change, with this build's kernel
+    HostTest::bootFirmware( T0 );
+    int rc;
+    const int M = 50;
+    t0 = HostTest::hostNanos();
+    for ( int i = 0; i < M; i++ ) {
+        HostSim::callFunction( "s_Config",
+            String::format( "{\"LAT\":%.2f,\"LNG\":-83.0}", 30.0 + i * 0.25 ), rc );
+    }
+    printf( "sun-table rebuild via s_Config, SF_FAST_SUN=%d: %.1f us\n",
+            SF_FAST_SUN, ( HostTest::hostNanos() - t0 ) / 1e3 / M );
+    return (int)( sink & 0 );
+}
@@ -0,0 +1,73 @@
+/**
+ * @file    bench_sun_table.cpp
+ * @brief   A simulated year of daily reprocessing: day-of-year cache vs the
+ *          precomputed annual sun table.
+ *
+ * N_EVENTS stored events, each with a date-only begin (sunrise) and an SS end,
+ * spread over the year so the 32-entry cache sees collisions.  The unit
+ * reprocesses once per day (the time-sync cadence) and the clock is walked
+ * forward a day at a time.  UTCSunEvent() solves are the cache misses plus,
+ * for the table, the 732 solves of the one-off build.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+// 2025-01-01 12:00:00 UTC
+static const time_t T0  = 1735732800;
+static const time_t DAY = 86400;
+
+struct Result { uint64_t ns; uint32_t solves; uint32_t lookups; };
+
+static Result simulateYear( bool table ) {
+    HostTest::bootFirmware( T0 );
+    int rc;
+    HostSim::callFunction( "s_Config", "{\"LAT\":51.5,\"LNG\":-0.1,\"FED\":\"FE-US\",\"STA\":\"FE-VA\"}", rc );
+    evMgr.setSunTableEnabled( table );
+
+    for ( int i = 0; i < EventManager::N_EVENTS; i++ ) {
+        int m = 1 + ( i * 11 ) % 12, d = 1 + ( i * 7 ) % 28;
+        String js = String::format(
+            "{\"IDV\":\"%d.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-%02d-%02d\",\"EMK\":\"2026-%02d-%02dTSS\"}",
+            i + 1, m, d, m, d );
+        HostSim::deliver( "FE-US", js.c_str() );
+    }
+
+    uint32_t m0 = evMgr.sunCacheMisses(), h0 = evMgr.sunCacheHits(), t0 = evMgr.sunTableHits();
+    uint64_t start = HostTest::hostNanos();
+    for ( int day = 0; day < 365; day++ ) {
+        HostSim::setTime( T0 + day * DAY, false );
+        evMgr.reprocessEvents();
+    }
+    uint64_t ns = HostTest::hostNanos() - start;
+
+    uint32_t misses = evMgr.sunCacheMisses() - m0;
+    return { ns, misses + ( table ? 2u * SUNTAB_DAYS : 0u ),
+             misses + ( evMgr.sunCacheHits() - h0 ) + ( evMgr.sunTableHits() - t0 ) };
+}
+
+int main() {
+    // One-off build cost, measured directly
+    HostTest::bootFirmware( T0 );
+    evMgr.setSunTableEnabled( false );
+    EEPROM.write( EEPROM_ADDR_SUNTAB, 0 );   // spoil the magic so enabling must rebuild
+    uint64_t b0 = HostTest::hostNanos();
+    evMgr.setSunTableEnabled( true );
+    uint64_t build = HostTest::hostNanos() - b0;
+
+    Result cache = simulateYear( false );
+    Result table = simulateYear( true );
+
+    printf( "storage: SunTable %u bytes EEPROM @%d, %u bytes RAM (EventManager::_sunTab)\n",
+            (unsigned)sizeof(SunTable), EEPROM_ADDR_SUNTAB, (unsigned)sizeof(SunTable) );
+    printf( "build:   %u solves, %.1f us (includes EEPROM read + write)\n",
+            2u * SUNTAB_DAYS, build / 1e3 );
+    printf( "year:    %u sun lookups\n", cache.lookups );
+    printf( "  cache  %6u UTCSunEvent solves  %8.2f ms\n", cache.solves, cache.ns / 1e6 );
+    printf( "  table  %6u UTCSunEvent solves  %8.2f ms (solves incl. build)\n", table.solves, table.ns / 1e6 );
+    printf( "saved:   %d solves, ~%.1f us of trig at %.0f ns/solve\n",
+            (int)cache.solves - (int)table.solves,
+            ( (int)cache.solves - (int)table.solves ) * ( build / ( 2.0 * SUNTAB_DAYS ) ) / 1e3,
+            build / ( 2.0 * SUNTAB_DAYS ) );
+    return 0;
+}
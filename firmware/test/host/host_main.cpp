@@ -0,0 +1,21 @@
+/**
+ * @file    host_main.cpp
+ * @brief   Host build of main.ino.
+ *
+ * @details
+ * The Particle toolchain preprocesses main.ino into a .cpp by inserting
+ * prototypes for every function it defines (see the stale src/main.cpp for an
+ * example of that output).  This file does the same by hand so the real
+ * setup() / loop() and the global objects they own (halMgr1, fsm, buzzer,
+ * sensors) are available to host tests.
+ */
+
+#include "Particle.h"
+
+int           setHALF         ( String duration );
+int           setFULL         ( String duration );
+int           setStation      ( String station );
+int           playIDTones     ( String dummyArg );
+unsigned long validateDuration( const String &duration );
+
+#include "main.ino"
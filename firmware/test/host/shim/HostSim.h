@@ -0,0 +1,83 @@
+/**
+ * @file    HostSim.h   (host shim)
+ * @brief   Test-side control surface for the simulated Device OS in Particle.h.
+ *
+ * @details
+ * The shim owns a single virtual clock.  @c millis() starts at 0 and only moves
+ * when a test calls @c advanceMs() (or the firmware calls @c delay() /
+ * @c Particle.process(), each of which consumes virtual time).  Wall-clock time
+ * (@c Time.now()) is an epoch anchored by @c setTime() and advances in step
+ * with @c millis().
+ *
+ * Cloud traffic is captured rather than sent: publishes are recorded, and
+ * subscriptions / functions / variables registered by the firmware can be
+ * driven from a test with @c deliver(), @c callFunction() and @c readVariable().
+ */
+
+#pragma once
+
+#include "Particle.h"
+#include <string>
+#include <vector>
+
+namespace HostSim {
+
+// ── Reset ────────────────────────────────────────────────────────────────────
+/// Return the simulation to power-on state: millis() = 0, time invalid,
+/// no registrations, pins low, publish log empty.  EEPROM is wiped to 0xFF
+/// only when @p wipeEEPROM is true, so a test can model a reboot.
+void reset( bool wipeEEPROM = true );
+
+// ── Virtual clock ────────────────────────────────────────────────────────────
+/// Set wall-clock time (UTC epoch).  Fires System.on(time_changed) handlers
+/// when @p notify is true, mirroring a cloud time sync.
+void          setTime  ( time_t epoch, bool notify = true );
+/// Advance virtual time; runs any software Timer callbacks that fall due.
+void          advanceMs( unsigned long ms );
+unsigned long nowMs    ();
+/// Virtual milliseconds consumed by each Particle.process() call (default 1).
+void          setYieldMs( unsigned long ms );
+
+// ── GPIO ─────────────────────────────────────────────────────────────────────
+void setDigital( pin_t pin, int value );
+int  getDigital( pin_t pin );
+void setAnalog ( pin_t pin, int value );
+int  getPwm    ( pin_t pin );
+
+// ── Cloud ────────────────────────────────────────────────────────────────────
+struct Publish {
+    std::string   name;
+    std::string   data;
+    unsigned long ms;
+};
+const std::vector<Publish> &published();
+void                        clearPublished();
+size_t                      publishCount( const char *name );
+
+void                     setConnected( bool connected );
+std::vector<std::string> subscriptions();
+size_t                   subscribeCalls();
+size_t                   unsubscribeCalls();
+/// Dispatch a cloud event to every subscription whose prefix matches @p topic.
+/// Returns the number of handlers invoked.
+int  deliver      ( const char *topic, const char *data );
+/// Invoke a registered Particle.function.  Returns false if @p name is unknown.
+bool callFunction ( const char *name, const String &arg, int &rc );
+/// Read a registered Particle.variable.  Returns false if @p name is unknown.
+bool readVariable ( const char *name, String &out );
+
+// ── EEPROM ───────────────────────────────────────────────────────────────────
+struct EepromStats {
+    uint32_t putCalls;       // EEPROM.put / EEPROM.write calls
+    uint32_t bytesWritten;   // bytes passed to put/write
+    uint32_t bytesChanged;   // bytes whose stored value actually differed
+    uint32_t getCalls;       // EEPROM.get / EEPROM.read calls
+};
+EepromStats eepromStats();
+void        resetEepromStats();
+
+// ── Diagnostics ──────────────────────────────────────────────────────────────
+/// Echo Log / Serial / publishes to stderr.
+void setVerbose( bool on );
+
+} // namespace HostSim
@@ -0,0 +1,438 @@
+/**
+ * @file    Particle.h   (host shim)
+ * @brief   Minimal Linux stand-in for the Device OS application API.
+ *
+ * @details
+ * Provides just enough of the Particle API for the SmartFlag sources in
+ * firmware/src to compile and run on a development host:
+ *
+ *  - Wiring:   String, millis(), delay(), GPIO, tone/noTone, min/max
+ *  - Cloud:    Particle.publish / subscribe / unsubscribe / function / variable
+ *  - System:   Time, EEPROM, System.on(time_changed), Timer, Cellular, Log, Serial
+ *  - JSON:     JSONValue, JSONObjectIterator, JSONArrayIterator, JSONBufferWriter
+ *
+ * Everything time-related is driven by a virtual clock owned by @c HostSim
+ * (HostSim.h).  Nothing advances on its own: tests move time forward with
+ * @c HostSim::advanceMs() / @c HostSim::setTime(), and @c delay() /
+ * @c Particle.process() consume virtual time so that blocking wait loops in
+ * the firmware (e.g. BuzzerManager::playEventWait) terminate.
+ *
+ * Only the behaviour the firmware actually depends on is modelled.  This file
+ * is never part of the device build — the Particle toolchain compiles src/
+ * and lib/ only.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <cctype>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Basic types and constants
+// ─────────────────────────────────────────────────────────────────────────────
+typedef int32_t  time32_t;
+typedef uint16_t pin_t;
+
+#define HIGH  1
+#define LOW   0
+
+enum PinMode { INPUT, OUTPUT, INPUT_PULLUP, INPUT_PULLDOWN };
+
+enum : pin_t {
+    D0 = 0, D1, D2, D3, D4, D5, D6, D7, D8, D9, D10, D11, D12, D13, D14,
+    A0 = 19, A1, A2, A3, A4, A5
+};
+
+#define SYSTEM_MODE(x)      static const int _host_system_mode_unused __attribute__((unused)) = 0
+#define SYSTEM_THREAD(x)    static const int _host_system_thread_unused __attribute__((unused)) = 0
+#define PRODUCT_VERSION(x)  static const int _host_product_version __attribute__((unused)) = (x);
+
+template <typename T, typename U>
+inline typename std::common_type<T, U>::type min( T a, U b ) { return (b < a) ? b : a; }
+template <typename T, typename U>
+inline typename std::common_type<T, U>::type max( T a, U b ) { return (a < b) ? b : a; }
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  String  (Wiring-compatible subset, backed by std::string)
+// ─────────────────────────────────────────────────────────────────────────────
+class String {
+public:
+    String() {}
+    String( const char *s )                 : _s( s ? s : "" ) {}
+    String( const char *s, size_t n )       : _s( s ? std::string(s, strnlen(s, n)) : std::string() ) {}
+    String( const std::string &s )          : _s( s ) {}
+    explicit String( char c )               : _s( 1, c ) {}
+    explicit String( int v, unsigned char base = 10 );
+    explicit String( unsigned int v, unsigned char base = 10 );
+    explicit String( long v, unsigned char base = 10 );
+    explicit String( unsigned long v, unsigned char base = 10 );
+    explicit String( long long v, unsigned char base = 10 );
+    explicit String( float v, int decimalPlaces = 6 );
+    explicit String( double v, int decimalPlaces = 6 );
+
+    static String format( const char *fmt, ... ) __attribute__((format(printf, 1, 2)));
+
+    unsigned int length() const            { return (unsigned int)_s.length(); }
+    const char  *c_str()  const            { return _s.c_str(); }
+    void         reserve( unsigned int n ) { _s.reserve( n ); }
+
+    char charAt( unsigned int i ) const    { return i < _s.length() ? _s[i] : '\0'; }
+    char operator[]( unsigned int i ) const { return charAt( i ); }
+    char &operator[]( unsigned int i )     { return _s[i]; }
+
+    String substring( unsigned int from ) const;
+    String substring( unsigned int from, unsigned int to ) const;
+    int    indexOf( char c, unsigned int from = 0 ) const;
+    int    indexOf( const String &s, unsigned int from = 0 ) const;
+    int    lastIndexOf( char c ) const;
+
+    long   toInt()   const { return atol( _s.c_str() ); }
+    float  toFloat() const { return (float)atof( _s.c_str() ); }
+
+    String &toUpperCase();
+    String &toLowerCase();
+    String &trim();
+    String &remove( unsigned int index );
+    String &remove( unsigned int index, unsigned int count );
+    String &replace( const String &find, const String &repl );
+
+    bool equals( const String &o ) const            { return _s == o._s; }
+    bool equalsIgnoreCase( const String &o ) const;
+    bool startsWith( const String &p ) const        { return _s.compare( 0, p._s.length(), p._s ) == 0; }
+    bool endsWith( const String &p ) const;
+
+    String &concat( const String &o )  { _s += o._s; return *this; }
+    String &concat( const char *o )    { if (o) _s += o; return *this; }
+    String &concat( char c )           { _s += c; return *this; }
+    String &operator+=( const String &o ) { return concat( o ); }
+    String &operator+=( const char *o )   { return concat( o ); }
+    String &operator+=( char c )          { return concat( c ); }
+
+    bool operator==( const String &o ) const { return _s == o._s; }
+    bool operator==( const char *o ) const   { return _s == ( o ? o : "" ); }
+    bool operator!=( const String &o ) const { return !( *this == o ); }
+    bool operator!=( const char *o ) const   { return !( *this == o ); }
+    bool operator< ( const String &o ) const { return _s < o._s; }
+
+    const std::string &str() const { return _s; }
+
+private:
+    std::string _s;
+};
+
+String operator+( const String &a, const String &b );
+String operator+( const String &a, const char *b );
+String operator+( const char *a, const String &b );
+String operator+( const String &a, char b );
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Wiring: time, GPIO, tone
+// ─────────────────────────────────────────────────────────────────────────────
+unsigned long millis();
+unsigned long micros();
+void delay( unsigned long ms );
+
+void pinMode     ( pin_t pin, PinMode mode );
+void digitalWrite( pin_t pin, uint8_t value );
+int32_t digitalRead( pin_t pin );
+void analogWrite ( pin_t pin, uint32_t value );
+int32_t analogRead( pin_t pin );
+void tone  ( pin_t pin, unsigned int frequency, unsigned long duration = 0 );
+void noTone( pin_t pin );
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Time
+// ─────────────────────────────────────────────────────────────────────────────
+#define TIME_FORMAT_DEFAULT       "asctime"
+#define TIME_FORMAT_ISO8601_FULL  "%Y-%m-%dT%H:%M:%S%z"
+
+class TimeClass {
+public:
+    time32_t now()     const;
+    time_t   local()   const { return now(); }
+    bool     isValid() const;
+    int      year()    const;
+    int      month()   const;
+    int      day()     const;
+    int      hour()    const;
+    int      minute()  const;
+    int      second()  const;
+    int      weekday() const;
+    void     zone( float ) {}
+    String   format( time_t t, const char *fmt = TIME_FORMAT_DEFAULT ) const;
+    String   format( const char *fmt = TIME_FORMAT_DEFAULT ) const { return format( now(), fmt ); }
+    String   timeStr( time_t t ) const { return format( t ); }
+};
+extern TimeClass Time;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  EEPROM  (emulated, byte array)
+// ─────────────────────────────────────────────────────────────────────────────
+class EEPROMClass {
+public:
+    static const size_t SIZE = 4096;
+
+    EEPROMClass() { clear(); }
+
+    uint8_t read ( int addr ) const { noteGet(); return inRange( addr, 1 ) ? _data[addr] : 0xFF; }
+    void    write( int addr, uint8_t value ) { if ( inRange( addr, 1 ) ) putBytes( addr, &value, 1 ); }
+    size_t  length() const { return SIZE; }
+    void    clear()        { memset( _data, 0xFF, sizeof(_data) ); }
+
+    template <typename T> T &get( int addr, T &t ) const {
+        noteGet();
+        if ( inRange( addr, sizeof(T) ) ) memcpy( (void *)&t, &_data[addr], sizeof(T) );
+        return t;
+    }
+    template <typename T> const T &put( int addr, const T &t ) {
+        if ( inRange( addr, sizeof(T) ) ) putBytes( addr, (const uint8_t *)&t, sizeof(T) );
+        return t;
+    }
+
+    /// Host only: raw image access for tests (HostSim snapshots / corruption).
+    uint8_t *image() { return _data; }
+
+private:
+    friend void HAL_EEPROM_Get( uint32_t index, void *data, size_t length );
+    friend void HAL_EEPROM_Put( uint32_t index, const void *data, size_t length );
+
+    bool inRange ( int addr, size_t n ) const { return addr >= 0 && (size_t)addr + n <= SIZE; }
+    void putBytes( int addr, const uint8_t *src, size_t n );   // counts writes (HostSim)
+    void noteGet () const;                                      // counts reads  (HostSim)
+
+    uint8_t _data[SIZE];
+};
+extern EEPROMClass EEPROM;
+
+// Device OS eeprom_hal.h: byte spans of any length (what EEPROM.get/put use)
+void HAL_EEPROM_Get( uint32_t index, void *data, size_t length );
+void HAL_EEPROM_Put( uint32_t index, const void *data, size_t length );
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Cloud
+// ─────────────────────────────────────────────────────────────────────────────
+enum PublishFlag { PUBLIC = 0, PRIVATE = 1, NO_ACK = 2, WITH_ACK = 8 };
+
+typedef void (*EventHandler)( const char *event, const char *data );
+
+class CloudClass {
+public:
+    bool publish( const char *name, const char *data = nullptr, PublishFlag flags = PRIVATE );
+    bool publish( const char *name, const String &data, PublishFlag flags = PRIVATE ) {
+        return publish( name, data.c_str(), flags );
+    }
+    bool publish( const String &name, const String &data, PublishFlag flags = PRIVATE ) {
+        return publish( name.c_str(), data.c_str(), flags );
+    }
+
+    bool subscribe( const char *prefix, EventHandler handler );
+    bool subscribe( const String &prefix, EventHandler handler ) { return subscribe( prefix.c_str(), handler ); }
+    void unsubscribe();
+
+    bool function( const char *name, std::function<int(String)> fn );
+    bool variable( const char *name, std::function<String()> fn );
+
+    bool connected() const;
+    void connect() {}
+    void disconnect() {}
+    bool process();
+};
+extern CloudClass Particle;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  System events, software timers, cellular
+// ─────────────────────────────────────────────────────────────────────────────
+typedef uint64_t system_event_t;
+static const system_event_t time_changed = 1ULL << 15;
+typedef void (*SystemEventHandler)( system_event_t event, int param );
+
+class SystemClass {
+public:
+    bool     on( system_event_t events, SystemEventHandler handler );
+    uint32_t freeMemory() const;
+    void     reset() {}
+};
+extern SystemClass System;
+
+class Timer {
+public:
+    Timer( unsigned int periodMs, std::function<void()> callback, bool oneShot = false );
+    ~Timer();
+    void start();
+    void stop();
+    bool isActive() const { return _active; }
+
+    unsigned int          _period;
+    std::function<void()> _cb;
+    bool                  _oneShot;
+    bool                  _active   = false;
+    unsigned long         _nextDue  = 0;
+};
+
+class CellularSignal {
+public:
+    float getStrengthValue() const { return -70.0f; }
+    float getQualityValue()  const { return -8.0f;  }
+};
+class CellularClass {
+public:
+    CellularSignal RSSI() const { return CellularSignal(); }
+};
+extern CellularClass Cellular;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Logging / serial  (routed to stderr only when HostSim verbose is on)
+// ─────────────────────────────────────────────────────────────────────────────
+class LoggerClass {
+public:
+    void trace( const char *fmt, ... ) __attribute__((format(printf, 2, 3)));
+    void info ( const char *fmt, ... ) __attribute__((format(printf, 2, 3)));
+    void warn ( const char *fmt, ... ) __attribute__((format(printf, 2, 3)));
+    void error( const char *fmt, ... ) __attribute__((format(printf, 2, 3)));
+};
+extern LoggerClass Log;
+
+class SerialClass {
+public:
+    void begin( unsigned long ) {}
+    void print  ( const char *s );
+    void print  ( const String &s ) { print( s.c_str() ); }
+    void println( const char *s = "" );
+    void println( const String &s ) { println( s.c_str() ); }
+    void printf ( const char *fmt, ... ) __attribute__((format(printf, 2, 3)));
+};
+extern SerialClass Serial;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  JSON  (JSONValue / iterators / JSONBufferWriter)
+// ─────────────────────────────────────────────────────────────────────────────
+struct JSONNode;
+
+class JSONString {
+public:
+    JSONString() {}
+    explicit JSONString( const std::string *s ) : _s( s ) {}
+    const char *data() const { return _s ? _s->c_str() : ""; }
+    size_t      size() const { return _s ? _s->size() : 0; }
+    bool        isEmpty() const { return size() == 0; }
+    operator const char *() const { return data(); }
+    bool operator==( const char *o ) const { return strcmp( data(), o ? o : "" ) == 0; }
+    bool operator!=( const char *o ) const { return !( *this == o ); }
+private:
+    const std::string *_s = nullptr;
+};
+
+class JSONValue {
+public:
+    JSONValue() {}
+
+    static JSONValue parseCopy( const char *json, size_t size );
+    static JSONValue parseCopy( const char *json ) { return parseCopy( json, json ? strlen(json) : 0 ); }
+    static JSONValue parseCopy( const String &json ) { return parseCopy( json.c_str(), json.length() ); }
+
+    bool isValid()  const;
+    bool isNull()   const;
+    bool isBool()   const;
+    bool isNumber() const;
+    bool isString() const;
+    bool isArray()  const;
+    bool isObject() const;
+
+    bool       toBool()   const;
+    int        toInt()    const;
+    unsigned   toUInt()   const;
+    double     toDouble() const;
+    JSONString toString() const;
+
+private:
+    explicit JSONValue( std::shared_ptr<JSONNode> root, const JSONNode *n ) : _root( root ), _n( n ) {}
+    std::shared_ptr<JSONNode> _root;
+    const JSONNode           *_n = nullptr;
+    friend class JSONObjectIterator;
+    friend class JSONArrayIterator;
+};
+
+class JSONObjectIterator {
+public:
+    explicit JSONObjectIterator( const JSONValue &obj );
+    bool       next();
+    JSONString name()  const;
+    JSONValue  value() const;
+    size_t     count() const;
+private:
+    JSONValue _obj;
+    int       _idx = -1;
+};
+
+class JSONArrayIterator {
+public:
+    explicit JSONArrayIterator( const JSONValue &arr );
+    bool      next();
+    JSONValue value() const;
+    size_t    count() const;
+private:
+    JSONValue _arr;
+    int       _idx = -1;
+};
+
+class JSONWriter {
+public:
+    virtual ~JSONWriter() {}
+
+    JSONWriter &beginObject();
+    JSONWriter &endObject();
+    JSONWriter &beginArray();
+    JSONWriter &endArray();
+    JSONWriter &name( const char *name );
+    JSONWriter &name( const String &name ) { return this->name( name.c_str() ); }
+    JSONWriter &nullValue();
+    JSONWriter &value( bool v );
+    JSONWriter &value( int v );
+    JSONWriter &value( unsigned v );
+    JSONWriter &value( long v );
+    JSONWriter &value( unsigned long v );
+    JSONWriter &value( long long v );
+    JSONWriter &value( double v, int precision );
+    JSONWriter &value( double v );
+    JSONWriter &value( float v, int precision ) { return value( (double)v, precision ); }
+    JSONWriter &value( float v )                { return value( (double)v ); }
+    JSONWriter &value( const char *s );
+    JSONWriter &value( const String &s ) { return value( s.c_str() ); }
+
+protected:
+    virtual void write( const char *data, size_t size ) = 0;
+
+private:
+    void writeSeparator();
+    void printf( const char *fmt, ... ) __attribute__((format(printf, 2, 3)));
+    void writeEscaped( const char *s );
+
+    bool _first   = true;
+    bool _afterName = false;
+};
+
+class JSONBufferWriter : public JSONWriter {
+public:
+    JSONBufferWriter( char *buf, size_t size ) : _buf( buf ), _size( size ) {}
+    char  *buffer()     const { return _buf; }
+    size_t bufferSize() const { return _size; }   // capacity, as on Device OS
+    size_t dataSize()   const { return _n; }      // bytes written (may exceed capacity)
+protected:
+    void write( const char *data, size_t size ) override;
+private:
+    char  *_buf;
+    size_t _size;
+    size_t _n = 0;
+};
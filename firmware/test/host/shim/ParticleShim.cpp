@@ -0,0 +1,699 @@
+/**
+ * @file    ParticleShim.cpp   (host shim)
+ * @brief   Implementation of the host stand-in declared in Particle.h / HostSim.h.
+ */
+
+#include "Particle.h"
+#include "HostSim.h"
+
+#include <algorithm>
+#include <map>
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Simulation state
+// ─────────────────────────────────────────────────────────────────────────────
+namespace {
+
+struct SimState {
+    unsigned long ms          = 0;       // virtual millis()
+    unsigned long yieldMs     = 1;       // cost of one Particle.process()
+    bool          timeValid   = false;
+    time_t        epochAtMs0  = 0;       // Time.now() == epochAtMs0 + ms / 1000
+    bool          connected   = true;
+    bool          verbose     = false;
+
+    int           digital[64] = {0};
+    int           analog [64] = {0};
+    int           pwm    [64] = {0};
+
+    std::vector<HostSim::Publish>                              published;
+    std::vector<std::pair<std::string, EventHandler>>          subs;
+    size_t                                                     subscribeCalls   = 0;
+    size_t                                                     unsubscribeCalls = 0;
+    std::map<std::string, std::function<int(String)>>         functions;
+    std::map<std::string, std::function<String()>>            variables;
+    std::vector<SystemEventHandler>                            timeHandlers;
+    std::vector<Timer *>                                       timers;
+
+    HostSim::EepromStats eeprom = {0, 0, 0, 0};
+};
+
+SimState &sim() {
+    static SimState s;
+    return s;
+}
+
+// Device OS runs with the C library in UTC; mktime()/gmtime() in the firmware
+// rely on that, so pin the host process to UTC before any test code runs.
+struct ForceUTC {
+    ForceUTC() { setenv( "TZ", "UTC", 1 ); tzset(); }
+} s_forceUTC;
+
+void vlog( const char *level, const char *fmt, va_list ap ) {
+    if ( !sim().verbose ) return;
+    fprintf( stderr, "[%8lu] %s ", sim().ms, level );
+    vfprintf( stderr, fmt, ap );
+    fputc( '\n', stderr );
+}
+
+void runTimers() {
+    // Fire every due timer, earliest first.  Callbacks may start/stop timers.
+    for (;;) {
+        Timer *due = nullptr;
+        for ( Timer *t : sim().timers ) {
+            if ( t->_active && t->_nextDue <= sim().ms &&
+                 ( !due || t->_nextDue < due->_nextDue ) ) due = t;
+        }
+        if ( !due ) return;
+        if ( due->_oneShot ) due->_active = false;
+        else                 due->_nextDue += due->_period ? due->_period : 1;
+        if ( due->_cb ) due->_cb();
+    }
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Globals
+// ─────────────────────────────────────────────────────────────────────────────
+TimeClass     Time;
+EEPROMClass   EEPROM;
+CloudClass    Particle;
+SystemClass   System;
+CellularClass Cellular;
+LoggerClass   Log;
+SerialClass   Serial;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  String
+// ─────────────────────────────────────────────────────────────────────────────
+static std::string intToBase( long long v, unsigned char base ) {
+    if ( base == 10 ) return std::to_string( v );
+    bool neg = v < 0;
+    unsigned long long u = neg ? (unsigned long long)(-v) : (unsigned long long)v;
+    std::string out;
+    do { int d = (int)( u % base ); out += (char)( d < 10 ? '0' + d : 'A' + d - 10 ); u /= base; } while ( u );
+    if ( neg ) out += '-';
+    std::reverse( out.begin(), out.end() );
+    return out;
+}
+
+String::String( int v, unsigned char base )           : _s( intToBase( v, base ) ) {}
+String::String( unsigned int v, unsigned char base )  : _s( intToBase( v, base ) ) {}
+String::String( long v, unsigned char base )          : _s( intToBase( v, base ) ) {}
+String::String( unsigned long v, unsigned char base ) : _s( intToBase( (long long)v, base ) ) {}
+String::String( long long v, unsigned char base )     : _s( intToBase( v, base ) ) {}
+String::String( float v, int decimalPlaces )          : String( (double)v, decimalPlaces ) {}
+String::String( double v, int decimalPlaces ) {
+    char buf[64];
+    snprintf( buf, sizeof(buf), "%.*f", decimalPlaces, v );
+    _s = buf;
+}
+
+String String::format( const char *fmt, ... ) {
+    va_list ap;
+    va_start( ap, fmt );
+    va_list ap2;
+    va_copy( ap2, ap );
+    int n = vsnprintf( nullptr, 0, fmt, ap );
+    va_end( ap );
+    std::string out( n > 0 ? (size_t)n : 0, '\0' );
+    if ( n > 0 ) vsnprintf( &out[0], (size_t)n + 1, fmt, ap2 );
+    va_end( ap2 );
+    return String( out );
+}
+
+String String::substring( unsigned int from ) const {
+    return from >= _s.length() ? String() : String( _s.substr( from ) );
+}
+
+String String::substring( unsigned int from, unsigned int to ) const {
+    if ( from > to ) std::swap( from, to );
+    if ( from >= _s.length() ) return String();
+    if ( to > _s.length() ) to = (unsigned int)_s.length();
+    return String( _s.substr( from, to - from ) );
+}
+
+int String::indexOf( char c, unsigned int from ) const {
+    size_t p = _s.find( c, from );
+    return p == std::string::npos ? -1 : (int)p;
+}
+
+int String::indexOf( const String &s, unsigned int from ) const {
+    size_t p = _s.find( s._s, from );
+    return p == std::string::npos ? -1 : (int)p;
+}
+
+int String::lastIndexOf( char c ) const {
+    size_t p = _s.rfind( c );
+    return p == std::string::npos ? -1 : (int)p;
+}
+
+String &String::toUpperCase() {
+    for ( auto &c : _s ) c = (char)toupper( (unsigned char)c );
+    return *this;
+}
+
+String &String::toLowerCase() {
+    for ( auto &c : _s ) c = (char)tolower( (unsigned char)c );
+    return *this;
+}
+
+String &String::trim() {
+    size_t b = 0, e = _s.length();
+    while ( b < e && isspace( (unsigned char)_s[b] ) ) b++;
+    while ( e > b && isspace( (unsigned char)_s[e - 1] ) ) e--;
+    _s = _s.substr( b, e - b );
+    return *this;
+}
+
+String &String::remove( unsigned int index ) {
+    if ( index < _s.length() ) _s.erase( index );
+    return *this;
+}
+
+String &String::remove( unsigned int index, unsigned int count ) {
+    if ( index < _s.length() ) _s.erase( index, count );
+    return *this;
+}
+
+String &String::replace( const String &find, const String &repl ) {
+    if ( find._s.empty() ) return *this;
+    size_t p = 0;
+    while ( ( p = _s.find( find._s, p ) ) != std::string::npos ) {
+        _s.replace( p, find._s.length(), repl._s );
+        p += repl._s.length();
+    }
+    return *this;
+}
+
+bool String::equalsIgnoreCase( const String &o ) const {
+    if ( _s.length() != o._s.length() ) return false;
+    for ( size_t i = 0; i < _s.length(); i++ ) {
+        if ( tolower( (unsigned char)_s[i] ) != tolower( (unsigned char)o._s[i] ) ) return false;
+    }
+    return true;
+}
+
+bool String::endsWith( const String &p ) const {
+    return _s.length() >= p._s.length() &&
+           _s.compare( _s.length() - p._s.length(), p._s.length(), p._s ) == 0;
+}
+
+String operator+( const String &a, const String &b ) { String r( a ); r += b; return r; }
+String operator+( const String &a, const char *b )   { String r( a ); r += b; return r; }
+String operator+( const char *a, const String &b )   { String r( a ); r += b; return r; }
+String operator+( const String &a, char b )          { String r( a ); r += b; return r; }
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Wiring
+// ─────────────────────────────────────────────────────────────────────────────
+unsigned long millis() { return sim().ms; }
+unsigned long micros() { return sim().ms * 1000UL; }
+void delay( unsigned long ms ) { HostSim::advanceMs( ms ); }
+
+void    pinMode     ( pin_t, PinMode ) {}
+void    digitalWrite( pin_t pin, uint8_t v ) { if ( pin < 64 ) sim().digital[pin] = v ? HIGH : LOW; }
+int32_t digitalRead ( pin_t pin )            { return pin < 64 ? sim().digital[pin] : LOW; }
+void    analogWrite ( pin_t pin, uint32_t v ){ if ( pin < 64 ) sim().pwm[pin] = (int)v; }
+int32_t analogRead  ( pin_t pin )            { return pin < 64 ? sim().analog[pin] : 0; }
+void    tone  ( pin_t, unsigned int, unsigned long ) {}
+void    noTone( pin_t ) {}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Time
+// ─────────────────────────────────────────────────────────────────────────────
+time32_t TimeClass::now() const {
+    return (time32_t)( sim().epochAtMs0 + (time_t)( sim().ms / 1000UL ) );
+}
+
+bool TimeClass::isValid() const { return sim().timeValid; }
+
+static struct tm nowTm() {
+    time_t t = Time.now();
+    struct tm r;
+    gmtime_r( &t, &r );
+    return r;
+}
+
+int TimeClass::year()    const { return nowTm().tm_year + 1900; }
+int TimeClass::month()   const { return nowTm().tm_mon + 1; }
+int TimeClass::day()     const { return nowTm().tm_mday; }
+int TimeClass::hour()    const { return nowTm().tm_hour; }
+int TimeClass::minute()  const { return nowTm().tm_min; }
+int TimeClass::second()  const { return nowTm().tm_sec; }
+int TimeClass::weekday() const { return nowTm().tm_wday + 1; }
+
+String TimeClass::format( time_t t, const char *fmt ) const {
+    struct tm r;
+    gmtime_r( &t, &r );
+    std::string f = ( strcmp( fmt, TIME_FORMAT_DEFAULT ) == 0 ) ? "%a %b %e %H:%M:%S %Y" : fmt;
+    size_t p = f.find( "%z" );
+    if ( p != std::string::npos ) f.replace( p, 2, "Z" );   // zone is always UTC here
+    char buf[64];
+    size_t n = strftime( buf, sizeof(buf), f.c_str(), &r );
+    return String( buf, n );
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  EEPROM
+// ─────────────────────────────────────────────────────────────────────────────
+void EEPROMClass::putBytes( int addr, const uint8_t *src, size_t n ) {
+    HostSim::EepromStats &st = sim().eeprom;
+    st.putCalls++;
+    st.bytesWritten += (uint32_t)n;
+    for ( size_t i = 0; i < n; i++ ) {
+        if ( _data[addr + i] != src[i] ) st.bytesChanged++;
+    }
+    memcpy( &_data[addr], src, n );
+}
+
+void EEPROMClass::noteGet() const {
+    sim().eeprom.getCalls++;
+}
+
+void HAL_EEPROM_Get( uint32_t index, void *data, size_t length ) {
+    EEPROM.noteGet();
+    if ( EEPROM.inRange( (int)index, length ) ) memcpy( data, &EEPROM._data[index], length );
+}
+
+void HAL_EEPROM_Put( uint32_t index, const void *data, size_t length ) {
+    if ( EEPROM.inRange( (int)index, length ) ) EEPROM.putBytes( (int)index, (const uint8_t *)data, length );
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Cloud
+// ─────────────────────────────────────────────────────────────────────────────
+bool CloudClass::publish( const char *name, const char *data, PublishFlag ) {
+    sim().published.push_back( { name ? name : "", data ? data : "", sim().ms } );
+    if ( sim().verbose ) fprintf( stderr, "[%8lu] PUB %s %s\n", sim().ms, name, data ? data : "" );
+    return sim().connected;
+}
+
+bool CloudClass::subscribe( const char *prefix, EventHandler handler ) {
+    sim().subscribeCalls++;
+    sim().subs.push_back( { prefix ? prefix : "", handler } );
+    return true;
+}
+
+void CloudClass::unsubscribe() {
+    sim().unsubscribeCalls++;
+    sim().subs.clear();
+}
+
+bool CloudClass::function( const char *name, std::function<int(String)> fn ) {
+    sim().functions[name] = fn;
+    return true;
+}
+
+bool CloudClass::variable( const char *name, std::function<String()> fn ) {
+    sim().variables[name] = fn;
+    return true;
+}
+
+bool CloudClass::connected() const { return sim().connected; }
+
+bool CloudClass::process() {
+    HostSim::advanceMs( sim().yieldMs );
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  System / Timer
+// ─────────────────────────────────────────────────────────────────────────────
+bool SystemClass::on( system_event_t events, SystemEventHandler handler ) {
+    if ( events & time_changed ) sim().timeHandlers.push_back( handler );
+    return true;
+}
+
+uint32_t SystemClass::freeMemory() const { return 64 * 1024; }
+
+Timer::Timer( unsigned int periodMs, std::function<void()> callback, bool oneShot )
+    : _period( periodMs ), _cb( callback ), _oneShot( oneShot ) {
+    sim().timers.push_back( this );
+}
+
+Timer::~Timer() {
+    auto &v = sim().timers;
+    v.erase( std::remove( v.begin(), v.end(), this ), v.end() );
+}
+
+void Timer::start() { _active = true;  _nextDue = sim().ms + _period; }
+void Timer::stop()  { _active = false; }
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Log / Serial
+// ─────────────────────────────────────────────────────────────────────────────
+#define SHIM_VLOG(level) do { va_list ap; va_start( ap, fmt ); vlog( level, fmt, ap ); va_end( ap ); } while (0)
+void LoggerClass::trace( const char *fmt, ... ) { SHIM_VLOG( "TRACE" ); }
+void LoggerClass::info ( const char *fmt, ... ) { SHIM_VLOG( "INFO " ); }
+void LoggerClass::warn ( const char *fmt, ... ) { SHIM_VLOG( "WARN " ); }
+void LoggerClass::error( const char *fmt, ... ) { SHIM_VLOG( "ERROR" ); }
+void SerialClass::printf( const char *fmt, ... ) { SHIM_VLOG( "SER  " ); }
+#undef SHIM_VLOG
+
+void SerialClass::print  ( const char *s ) { if ( sim().verbose ) fputs( s, stderr ); }
+void SerialClass::println( const char *s ) { if ( sim().verbose ) { fputs( s, stderr ); fputc( '\n', stderr ); } }
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  JSON parser (recursive descent into an owned node tree)
+// ─────────────────────────────────────────────────────────────────────────────
+struct JSONNode {
+    enum Type { INVALID, NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = INVALID;
+    std::string              text;       // string value, or raw number / literal text
+    std::vector<std::string> keys;       // OBJECT member names (parallel to children)
+    std::vector<JSONNode>    children;   // ARRAY elements / OBJECT member values
+};
+
+namespace {
+
+struct JSONReader {
+    const char *p;
+    const char *end;
+
+    void skipWs() { while ( p < end && isspace( (unsigned char)*p ) ) p++; }
+
+    bool parseString( std::string &out ) {
+        if ( p >= end || *p != '"' ) return false;
+        p++;
+        while ( p < end && *p != '"' ) {
+            char c = *p++;
+            if ( c == '\\' && p < end ) {
+                char e = *p++;
+                switch ( e ) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u':
+                        if ( end - p >= 4 ) { out += (char)strtol( std::string( p, 4 ).c_str(), nullptr, 16 ); p += 4; }
+                        break;
+                    default:  out += e; break;
+                }
+            } else {
+                out += c;
+            }
+        }
+        if ( p >= end ) return false;
+        p++;   // closing quote
+        return true;
+    }
+
+    bool parseValue( JSONNode &n ) {
+        skipWs();
+        if ( p >= end ) return false;
+        if ( *p == '{' ) {
+            n.type = JSONNode::OBJECT;
+            p++;
+            skipWs();
+            if ( p < end && *p == '}' ) { p++; return true; }
+            for (;;) {
+                skipWs();
+                std::string key;
+                if ( !parseString( key ) ) return false;
+                skipWs();
+                if ( p >= end || *p != ':' ) return false;
+                p++;
+                JSONNode child;
+                if ( !parseValue( child ) ) return false;
+                n.keys.push_back( key );
+                n.children.push_back( std::move( child ) );
+                skipWs();
+                if ( p < end && *p == ',' ) { p++; continue; }
+                if ( p < end && *p == '}' ) { p++; return true; }
+                return false;
+            }
+        }
+        if ( *p == '[' ) {
+            n.type = JSONNode::ARRAY;
+            p++;
+            skipWs();
+            if ( p < end && *p == ']' ) { p++; return true; }
+            for (;;) {
+                JSONNode child;
+                if ( !parseValue( child ) ) return false;
+                n.children.push_back( std::move( child ) );
+                skipWs();
+                if ( p < end && *p == ',' ) { p++; continue; }
+                if ( p < end && *p == ']' ) { p++; return true; }
+                return false;
+            }
+        }
+        if ( *p == '"' ) {
+            n.type = JSONNode::STRING;
+            return parseString( n.text );
+        }
+        const char *b = p;
+        while ( p < end && !isspace( (unsigned char)*p ) && *p != ',' && *p != '}' && *p != ']' ) p++;
+        n.text.assign( b, p );
+        if      ( n.text == "true" || n.text == "false" ) n.type = JSONNode::BOOL;
+        else if ( n.text == "null" )                      n.type = JSONNode::NUL;
+        else if ( !n.text.empty() && ( isdigit( (unsigned char)n.text[0] ) || n.text[0] == '-' ) )
+                                                          n.type = JSONNode::NUMBER;
+        else return false;
+        return true;
+    }
+};
+
+const JSONNode &invalidNode() {
+    static JSONNode n;
+    return n;
+}
+
+} // namespace
+
+JSONValue JSONValue::parseCopy( const char *json, size_t size ) {
+    auto root = std::make_shared<JSONNode>();
+    if ( json ) {
+        JSONReader r{ json, json + size };
+        if ( !r.parseValue( *root ) ) *root = JSONNode();
+        else { r.skipWs(); if ( r.p != r.end ) *root = JSONNode(); }
+    }
+    const JSONNode *n = root.get();
+    return JSONValue( root, n );
+}
+
+bool JSONValue::isValid()  const { return _n && _n->type != JSONNode::INVALID; }
+bool JSONValue::isNull()   const { return _n && _n->type == JSONNode::NUL;    }
+bool JSONValue::isBool()   const { return _n && _n->type == JSONNode::BOOL;   }
+bool JSONValue::isNumber() const { return _n && _n->type == JSONNode::NUMBER; }
+bool JSONValue::isString() const { return _n && _n->type == JSONNode::STRING; }
+bool JSONValue::isArray()  const { return _n && _n->type == JSONNode::ARRAY;  }
+bool JSONValue::isObject() const { return _n && _n->type == JSONNode::OBJECT; }
+
+bool JSONValue::toBool() const {
+    if ( !_n ) return false;
+    switch ( _n->type ) {
+        case JSONNode::BOOL:   return _n->text == "true";
+        case JSONNode::NUMBER: return atof( _n->text.c_str() ) != 0.0;
+        case JSONNode::STRING: return _n->text == "true" || _n->text == "1";
+        default:               return false;
+    }
+}
+
+int      JSONValue::toInt()    const { return ( isNumber() || isString() ) ? (int)strtol( _n->text.c_str(), nullptr, 10 ) : (int)toBool(); }
+unsigned JSONValue::toUInt()   const { return ( isNumber() || isString() ) ? (unsigned)strtoul( _n->text.c_str(), nullptr, 10 ) : (unsigned)toBool(); }
+double   JSONValue::toDouble() const { return ( isNumber() || isString() ) ? strtod( _n->text.c_str(), nullptr ) : (double)toBool(); }
+
+JSONString JSONValue::toString() const {
+    if ( !_n || _n->type == JSONNode::ARRAY || _n->type == JSONNode::OBJECT ) return JSONString();
+    return JSONString( &_n->text );
+}
+
+JSONObjectIterator::JSONObjectIterator( const JSONValue &obj ) : _obj( obj ) {}
+
+bool JSONObjectIterator::next() {
+    if ( !_obj.isObject() ) return false;
+    if ( _idx + 1 >= (int)_obj._n->children.size() ) return false;
+    _idx++;
+    return true;
+}
+
+JSONString JSONObjectIterator::name() const {
+    if ( !_obj.isObject() || _idx < 0 ) return JSONString();
+    return JSONString( &_obj._n->keys[_idx] );
+}
+
+JSONValue JSONObjectIterator::value() const {
+    if ( !_obj.isObject() || _idx < 0 ) return JSONValue( _obj._root, &invalidNode() );
+    return JSONValue( _obj._root, &_obj._n->children[_idx] );
+}
+
+size_t JSONObjectIterator::count() const { return _obj.isObject() ? _obj._n->children.size() : 0; }
+
+JSONArrayIterator::JSONArrayIterator( const JSONValue &arr ) : _arr( arr ) {}
+
+bool JSONArrayIterator::next() {
+    if ( !_arr.isArray() ) return false;
+    if ( _idx + 1 >= (int)_arr._n->children.size() ) return false;
+    _idx++;
+    return true;
+}
+
+JSONValue JSONArrayIterator::value() const {
+    if ( !_arr.isArray() || _idx < 0 ) return JSONValue( _arr._root, &invalidNode() );
+    return JSONValue( _arr._root, &_arr._n->children[_idx] );
+}
+
+size_t JSONArrayIterator::count() const { return _arr.isArray() ? _arr._n->children.size() : 0; }
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  JSON writer
+// ─────────────────────────────────────────────────────────────────────────────
+void JSONWriter::writeSeparator() {
+    if ( _afterName ) { _afterName = false; return; }
+    if ( !_first ) write( ",", 1 );
+    _first = false;
+}
+
+void JSONWriter::printf( const char *fmt, ... ) {
+    char buf[64];
+    va_list ap;
+    va_start( ap, fmt );
+    int n = vsnprintf( buf, sizeof(buf), fmt, ap );
+    va_end( ap );
+    if ( n > 0 ) write( buf, (size_t)min( n, (int)sizeof(buf) - 1 ) );
+}
+
+void JSONWriter::writeEscaped( const char *s ) {
+    write( "\"", 1 );
+    for ( ; s && *s; s++ ) {
+        char c = *s;
+        if      ( c == '"' )  write( "\\\"", 2 );
+        else if ( c == '\\' ) write( "\\\\", 2 );
+        else if ( c == '\n' ) write( "\\n", 2 );
+        else if ( c == '\r' ) write( "\\r", 2 );
+        else if ( c == '\t' ) write( "\\t", 2 );
+        else if ( (unsigned char)c < 0x20 ) printf( "\\u%04x", (unsigned)c );
+        else write( &c, 1 );
+    }
+    write( "\"", 1 );
+}
+
+JSONWriter &JSONWriter::beginObject() { writeSeparator(); write( "{", 1 ); _first = true; return *this; }
+JSONWriter &JSONWriter::endObject()   { write( "}", 1 ); _first = false; return *this; }
+JSONWriter &JSONWriter::beginArray()  { writeSeparator(); write( "[", 1 ); _first = true; return *this; }
+JSONWriter &JSONWriter::endArray()    { write( "]", 1 ); _first = false; return *this; }
+
+JSONWriter &JSONWriter::name( const char *n ) {
+    writeSeparator();
+    writeEscaped( n );
+    write( ":", 1 );
+    _afterName = true;
+    return *this;
+}
+
+JSONWriter &JSONWriter::nullValue()            { writeSeparator(); write( "null", 4 ); return *this; }
+JSONWriter &JSONWriter::value( bool v )        { writeSeparator(); v ? write( "true", 4 ) : write( "false", 5 ); return *this; }
+JSONWriter &JSONWriter::value( int v )         { writeSeparator(); printf( "%d", v );   return *this; }
+JSONWriter &JSONWriter::value( unsigned v )    { writeSeparator(); printf( "%u", v );   return *this; }
+JSONWriter &JSONWriter::value( long v )        { writeSeparator(); printf( "%ld", v );  return *this; }
+JSONWriter &JSONWriter::value( unsigned long v ){ writeSeparator(); printf( "%lu", v ); return *this; }
+JSONWriter &JSONWriter::value( long long v )   { writeSeparator(); printf( "%lld", v ); return *this; }
+JSONWriter &JSONWriter::value( double v, int precision ) { writeSeparator(); printf( "%.*f", precision, v ); return *this; }
+JSONWriter &JSONWriter::value( double v )      { writeSeparator(); printf( "%g", v );   return *this; }
+JSONWriter &JSONWriter::value( const char *s ) { writeSeparator(); writeEscaped( s );    return *this; }
+
+void JSONBufferWriter::write( const char *data, size_t size ) {
+    if ( _n < _size ) memcpy( _buf + _n, data, min( size, _size - _n ) );
+    _n += size;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  HostSim
+// ─────────────────────────────────────────────────────────────────────────────
+namespace HostSim {
+
+void reset( bool wipeEEPROM ) {
+    std::vector<Timer *> timers = sim().timers;   // Timer objects outlive a reset
+    for ( Timer *t : timers ) t->stop();
+    bool verbose = sim().verbose;
+    sim() = SimState();
+    sim().timers  = timers;
+    sim().verbose = verbose;
+    if ( wipeEEPROM ) EEPROM.clear();
+}
+
+void setTime( time_t epoch, bool notify ) {
+    sim().epochAtMs0 = epoch - (time_t)( sim().ms / 1000UL );
+    sim().timeValid  = true;
+    if ( notify ) {
+        for ( SystemEventHandler h : sim().timeHandlers ) h( time_changed, 0 );
+    }
+}
+
+void advanceMs( unsigned long ms ) {
+    // Step through timer deadlines so each callback sees the right millis().
+    unsigned long target = sim().ms + ms;
+    for (;;) {
+        unsigned long next = target;
+        for ( Timer *t : sim().timers ) {
+            if ( t->_active && t->_nextDue < next ) next = t->_nextDue;
+        }
+        if ( next > sim().ms ) sim().ms = next;
+        runTimers();
+        if ( sim().ms >= target ) break;
+    }
+}
+
+unsigned long nowMs() { return sim().ms; }
+void setYieldMs( unsigned long ms ) { sim().yieldMs = ms; }
+
+void setDigital( pin_t pin, int v ) { if ( pin < 64 ) sim().digital[pin] = v; }
+int  getDigital( pin_t pin )        { return pin < 64 ? sim().digital[pin] : 0; }
+void setAnalog ( pin_t pin, int v ) { if ( pin < 64 ) sim().analog[pin] = v; }
+int  getPwm    ( pin_t pin )        { return pin < 64 ? sim().pwm[pin] : 0; }
+
+const std::vector<Publish> &published() { return sim().published; }
+void clearPublished() { sim().published.clear(); }
+
+size_t publishCount( const char *name ) {
+    size_t n = 0;
+    for ( const Publish &p : sim().published ) if ( p.name == name ) n++;
+    return n;
+}
+
+void setConnected( bool c ) { sim().connected = c; }
+
+std::vector<std::string> subscriptions() {
+    std::vector<std::string> out;
+    for ( auto &s : sim().subs ) out.push_back( s.first );
+    return out;
+}
+
+size_t subscribeCalls()   { return sim().subscribeCalls; }
+size_t unsubscribeCalls() { return sim().unsubscribeCalls; }
+
+int deliver( const char *topic, const char *data ) {
+    int n = 0;
+    auto subs = sim().subs;   // handlers may re-subscribe
+    for ( auto &s : subs ) {
+        if ( strncmp( topic, s.first.c_str(), s.first.length() ) == 0 ) {
+            s.second( topic, data );
+            n++;
+        }
+    }
+    return n;
+}
+
+bool callFunction( const char *name, const String &arg, int &rc ) {
+    auto it = sim().functions.find( name );
+    if ( it == sim().functions.end() ) return false;
+    rc = it->second( arg );
+    return true;
+}
+
+bool readVariable( const char *name, String &out ) {
+    auto it = sim().variables.find( name );
+    if ( it == sim().variables.end() ) return false;
+    out = it->second();
+    return true;
+}
+
+EepromStats eepromStats()      { return sim().eeprom; }
+void        resetEepromStats() { sim().eeprom = { 0, 0, 0, 0 }; }
+
+void setVerbose( bool on ) { sim().verbose = on; }
+
+} // namespace HostSim
@@ -0,0 +1,113 @@
+/**
+ * @file    test_batch_ingest.cpp
+ * @brief   Batch event ingestion through s_InjectEv: one reprocess, one save
+ *          and one status report per batch, with per-entry result codes.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+//  Event @p id, one hour on 2025-06-@p day
+static String dayEvent( int id, int day ) {
+    String bmk = String::format( "2025-06-%02dT12:00Z", day );
+    String emk = String::format( "2025-06-%02dT13:00Z", day );
+    return HostTest::eventJSON( id, 1, "FE-US", bmk.c_str(), emk.c_str() );
+}
+
+static String batchJSON( int firstId, int n ) {
+    String js = "[";
+    for ( int i = 0; i < n; i++ ) {
+        if ( i ) js += ",";
+        js += dayEvent( firstId + i, 16 + i % 10 );
+    }
+    return js + "]";
+}
+
+HT_TEST(batch_commits_and_reports_once) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    HostSim::clearPublished();
+    uint32_t saves0 = evMgr.eventSaveCalls();
+    uint32_t slots0 = evMgr.eventSlotWrites();
+
+    int rc = -1;
+    HT_CHECK( HostSim::callFunction( "s_InjectEv", batchJSON( 1, 8 ), rc ) );
+    HT_CHECK_EQ( rc, (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( evMgr.getNEvents(), 8 );
+    HT_CHECK_EQ( evMgr.eventSaveCalls() - saves0, 1u );
+    HT_CHECK_EQ( evMgr.eventSlotWrites() - slots0, 8u );
+    HT_CHECK_EQ( HostSim::publishCount( "statusReport" ), (size_t)1 );
+
+    String out;
+    HT_CHECK( HostSim::readVariable( "s_BatchRC", out ) );
+    HT_CHECK( out == "{\"N\":8,\"RC\":[0,0,0,0,0,0,0,0]}" );
+}
+
+HT_TEST(batch_matches_one_at_a_time) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    for ( int i = 0; i < 6; i++ ) evMgr.receiveEvent( dayEvent( 1 + i, 16 + i ) );
+    time_t   next1 = evMgr.nextFlagChange();
+    String   list1 = evMgr.showEventList();
+
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    HT_CHECK_EQ( evMgr.receiveEvents( batchJSON( 1, 6 ) ), (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( evMgr.nextFlagChange(), next1 );
+    HT_CHECK( evMgr.showEventList() == list1 );
+}
+
+HT_TEST(batch_reports_per_entry_codes) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    evMgr.receiveEvent( dayEvent( 5, 20 ) );
+
+    // good, malformed, stale re-send of 5, delete of unknown id, good
+    String js = "[" + dayEvent( 1, 16 ) + ",{\"IDV\":\"x\"}," + dayEvent( 5, 20 ) +
+                ",{\"IDV\":\"99.1\",\"JUR\":\"FE-US\",\"DEL\":true}," + dayEvent( 2, 17 ) + "]";
+    int codes[5] = { -1, -1, -1, -1, -1 };
+    HT_CHECK_EQ( evMgr.receiveEvents( js, codes, 5 ), (int)EMrc::GENFAIL );
+    HT_CHECK_EQ( codes[0], (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( codes[1], (int)EMrc::PARSE_ERROR );
+    HT_CHECK_EQ( codes[2], (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( codes[3], (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( codes[4], (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( evMgr.getNEvents(), 3 );
+}
+
+HT_TEST(batch_overflow_is_per_entry) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    for ( int id = 1; id <= EventManager::N_EVENTS - 2; id++ ) evMgr.receiveEvent( dayEvent( id, 16 + id % 10 ) );
+
+    int codes[4];
+    HT_CHECK_EQ( evMgr.receiveEvents( batchJSON( 100, 4 ), codes, 4 ), (int)EMrc::GENFAIL );
+    HT_CHECK_EQ( codes[1], (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( codes[2], (int)EMrc::EVL_OVERFLOW );
+    HT_CHECK_EQ( codes[3], (int)EMrc::EVL_OVERFLOW );
+    HT_CHECK_EQ( evMgr.getNEvents(), EventManager::N_EVENTS );
+}
+
+HT_TEST(oversized_payload_rejected) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    // Larger than any cloud-function argument; fails whole rather than in part
+    HT_CHECK_EQ( evMgr.receiveEvents( batchJSON( 1, 12 ) ), (int)EMrc::PARSE_ERROR );
+    HT_CHECK_EQ( evMgr.getNEvents(), 0 );
+}
+
+HT_TEST(non_array_payload_rejected) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    HT_CHECK_EQ( evMgr.receiveEvents( "{\"IDV\":\"1.1\"}" ), (int)EMrc::PARSE_ERROR );
+    HT_CHECK_EQ( evMgr.receiveEvents( "[" ), (int)EMrc::PARSE_ERROR );
+
+    // A single object still goes through the one-event path
+    int rc = -1;
+    HT_CHECK( HostSim::callFunction( "s_InjectEv", dayEvent( 1, 16 ), rc ) );
+    HT_CHECK_EQ( rc, (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( evMgr.getNEvents(), 1 );
+}
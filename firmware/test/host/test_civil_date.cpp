@@ -0,0 +1,56 @@
+/**
+ * @file    test_civil_date.cpp
+ * @brief   CivilDate arithmetic against libc gmtime_r() / timegm() for every
+ *          day 1970–2100, and parseUTC() built on it.
+ */
+
+#include "HostTest.h"
+#include "CivilDate.h"
+#include "EEPROMManager.h"
+
+#include <ctime>
+
+static const int32_t DAY_1970 = 0;
+static const int32_t DAY_2101 = CivilDate::daysFromCivil( 2101, 1, 1 );
+
+HT_TEST(every_day_matches_gmtime) {
+    HT_CHECK_EQ( DAY_2101, 47847 );
+    for ( int32_t day = DAY_1970; day < DAY_2101; day++ ) {
+        time_t t = (time_t)day * 86400;
+        struct tm g;
+        gmtime_r( &t, &g );
+
+        CivilDate::Ymd c = CivilDate::civilFromDays( day );
+        HT_CHECK_EQ( c.year,  g.tm_year + 1900 );
+        HT_CHECK_EQ( c.month, g.tm_mon + 1 );
+        HT_CHECK_EQ( c.day,   g.tm_mday );
+        HT_CHECK_EQ( CivilDate::yearDay( day ), g.tm_yday );
+        HT_CHECK_EQ( CivilDate::weekDay( day ), g.tm_wday );
+        HT_CHECK_EQ( CivilDate::daysFromCivil( c.year, c.month, c.day ), day );
+    }
+}
+
+HT_TEST(out_of_range_fields_match_timegm) {
+    // Month 0..13, day 0..32 and carried clock fields, as timegm() normalises them
+    for ( int y = 1970; y <= 2100; y++ ) {
+        for ( int mon = 0; mon <= 13; mon++ ) {
+            for ( int d = 0; d <= 32; d++ ) {
+                struct tm t = {};
+                t.tm_year = y - 1900; t.tm_mon = mon - 1; t.tm_mday = d;
+                t.tm_hour = 25; t.tm_min = -1; t.tm_sec = 61;
+                time_t ref = timegm( &t );
+                if ( ref < 0 ) continue;                    // before 1970-01-01
+                HT_CHECK_EQ( CivilDate::toEpoch( y, mon, d, 25, -1, 61 ), ref );
+            }
+        }
+    }
+}
+
+HT_TEST(parse_utc) {
+    HT_CHECK_EQ( parseUTC( "2025-06-15T12:00:00" ),  (time_t)1749988800 );
+    HT_CHECK_EQ( parseUTC( "2000-02-29T23:59:59" ),  (time_t)951868799 );
+    HT_CHECK_EQ( parseUTC( "2100-12-31T00:00:00" ),  (time_t)4133894400LL );
+    HT_CHECK_EQ( parseUTC( "1970-01-01T00:00:00" ),  (time_t)0 );
+    HT_CHECK_EQ( parseUTC( "2025-06-15" ),           (time_t)0 );
+    HT_CHECK_EQ( parseUTC( "" ),                     (time_t)0 );
+}
@@ -0,0 +1,49 @@
+/**
+ * @file    test_config_cache.cpp
+ * @brief   Config cache: reads after boot stay off EEPROM, writes go through
+ *          and bump the generation, and the cache survives a reboot.
+ */
+
+#include "HostTest.h"
+#include "EEPROMManager.h"
+#include "EventManager.h"
+#include "FlagUtils.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+HT_TEST(reads_after_boot_skip_eeprom) {
+    HostTest::bootFirmware( T0 );
+    checkAndReportStatus( false, "RPT" );       // first report reads StatusData
+    HostSim::resetEepromStats();
+
+    checkAndReportStatus( false, "RPT" );       // not due: config read only
+    String js;
+    HT_CHECK( HostSim::readVariable( "s_ShowConfig", js ) );
+    ConfigData c;
+    readConfig( c );
+    ConfigExt x;
+    readConfigExt( x );
+    HT_CHECK_EQ( HostSim::eepromStats().getCalls, 0u );
+    HT_CHECK_EQ( x.magic, (uint16_t)CFGX_MAGIC );
+}
+
+HT_TEST(writes_go_through_and_bump_generation) {
+    HostTest::bootFirmware( T0 );
+    uint32_t g0 = configGeneration();
+
+    int rc = -1;
+    HostSim::callFunction( "s_Config", "{\"LAT\":41.5}", rc );
+    HT_CHECK_EQ( rc, (int)EMrc::SUCCESS );
+    HT_CHECK( configGeneration() != g0 );
+    HT_CHECK( fabsf( configData().LAT - 41.5f ) < 1e-4f );
+
+    ConfigData a, b;                                        // committed to one of the A/B slots
+    EEPROM.get( EEPROM_ADDR_CONFIG,   a );
+    EEPROM.get( EEPROM_ADDR_CONFIG_B, b );
+    HT_CHECK( memcmp( &a, &configData(), sizeof a ) == 0 || memcmp( &b, &configData(), sizeof b ) == 0 );
+
+    // A reboot reloads the same values from EEPROM
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK( fabsf( configData().LAT - 41.5f ) < 1e-4f );
+}
@@ -0,0 +1,170 @@
+/**
+ * @file    test_config_commit.cpp
+ * @brief   A/B config commits: slots alternate, a torn commit or a damaged
+ *          live slot leaves the previous commit in force, and v2 / v3 / v5
+ *          images migrate.
+ */
+
+#include "HostTest.h"
+#include "EEPROMManager.h"
+#include "EEPROMShadow.h"
+
+#include <cmath>
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static void setLat( float lat ) {
+    int rc = -1;
+    HostSim::callFunction( "s_Config", String::format( "{\"LAT\":%.2f}", lat ).c_str(), rc );
+    HT_CHECK_EQ( rc, 0 );
+}
+
+static bool near( float a, float b ) { return fabsf( a - b ) < 1e-3f; }
+
+static const int CFG_SLOT[2] = { EEPROM_ADDR_CONFIG, EEPROM_ADDR_CONFIG_B };
+
+//  Slot holding the current ConfigData, or -1
+static int liveSlot() {
+    for ( int i = 0; i < 2; i++ ) {
+        ConfigData c;
+        EEPROM.get( CFG_SLOT[i], c );
+        if ( memcmp( &c, &configData(), sizeof c ) == 0 ) return i;
+    }
+    return -1;
+}
+
+static CommitTag tagOf( int slot ) {
+    CommitTag t;
+    EEPROM.get( EEPROM_ADDR_CFG_TAGS + slot * (int)sizeof(CommitTag), t );
+    return t;
+}
+
+HT_TEST(commits_alternate_slots) {
+    HostTest::bootFirmware( T0 );
+    setLat( 41.0f );
+    int s0 = liveSlot();
+    HT_CHECK( s0 >= 0 );
+    uint32_t seq0 = tagOf( s0 ).seq;
+
+    setLat( 42.0f );
+    HT_CHECK_EQ( liveSlot(), 1 - s0 );
+    HT_CHECK_EQ( tagOf( 1 - s0 ).seq, seq0 + 1 );
+    setLat( 43.0f );
+    HT_CHECK_EQ( liveSlot(), s0 );
+}
+
+HT_TEST(torn_commit_keeps_previous) {
+    HostTest::bootFirmware( T0 );
+    setLat( 41.5f );
+    int live = liveSlot();
+
+    // Reset part-way through the next payload: the tag was never written
+    for ( int i = 0; i < 20; i++ ) EEPROM.write( CFG_SLOT[1 - live] + i, 0xA5 );
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK( near( configData().LAT, 41.5f ) );
+
+    // Payload complete, reset part-way through the tag
+    setLat( 42.5f );
+    live = liveSlot();
+    CommitTag t = tagOf( live );
+    EEPROM.write( EEPROM_ADDR_CFG_TAGS + live * (int)sizeof(CommitTag) + 5, (uint8_t)( ( t.crc32 >> 8 ) ^ 0xFF ) );
+    HostTest::bootFirmware( T0 + 120, true );
+    HT_CHECK( near( configData().LAT, 41.5f ) );
+}
+
+HT_TEST(damaged_live_slot_falls_back) {
+    HostTest::bootFirmware( T0 );
+    setLat( 41.0f );
+    setLat( 44.0f );
+    int live = liveSlot();
+    uint8_t b = EEPROM.read( CFG_SLOT[live] + 10 );
+    EEPROM.write( CFG_SLOT[live] + 10, (uint8_t)( b ^ 0x10 ) );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK( near( configData().LAT, 41.0f ) );
+}
+
+HT_TEST(v5_image_migrates) {
+    HostTest::bootFirmware( T0 );
+    setLat( 39.25f );
+    ConfigExt x = configExt();
+    x.stall_limit_ma = 1500;
+    writeConfigExt( x );
+
+    // v5: single ConfigData / ConfigExt blocks, status in a 16-slot log
+    eepromShadow.commit();
+    EEPROMHeader h;
+    EEPROM.get( EEPROM_ADDR_HEADER, h );
+    h.version = 5;
+    EEPROM.put( EEPROM_ADDR_HEADER, h );
+    EEPROM.put( EEPROM_ADDR_CONFIG, configData() );
+    EEPROM.put( EEPROM_ADDR_CFGX,   configExt() );
+    for ( int i = 0; i < 4 * (int)sizeof(CommitTag); i++ ) EEPROM.write( EEPROM_ADDR_CFG_TAGS + i, 0 );
+    for ( int i = 0; i < 16; i++ ) EEPROM.write( EEPROM_ADDR_STATUS_LOG + i * (int)sizeof(StatusRec), 0 );
+    StatusRec r = {};
+    r.magic        = STATUS_REC_MAGIC;
+    r.seq          = 7;
+    r.reboot_count = 9;
+    r.OSTA         = FLAG_FULL;
+    r.NSTA         = FLAG_FULL;
+    r.crc8         = statusRecCRC( r );
+    EEPROM.put( EEPROM_ADDR_STATUS_LOG + 14 * (int)sizeof(StatusRec), r );   // past the v6 log
+
+    HostTest::bootFirmware( T0 + 60, true );
+    EEPROM.get( EEPROM_ADDR_HEADER, h );
+    HT_CHECK_EQ( h.version, (uint8_t)EEPROM_VERSION );
+    HT_CHECK( near( configData().LAT, 39.25f ) );
+    HT_CHECK_EQ( configExt().stall_limit_ma, 1500 );
+    StatusData st;
+    readStatus( st );
+    HT_CHECK_EQ( st.reboot_count, 10u );
+}
+
+//  Rewrite the booted image as a v2 / v3 one: single ConfigData / ConfigExt
+//  blocks, StatusData over the tags
+static void makeLegacyImage( uint8_t version ) {
+    eepromShadow.commit();
+    EEPROMHeader h;
+    EEPROM.get( EEPROM_ADDR_HEADER, h );
+    h.version = version;
+    EEPROM.put( EEPROM_ADDR_HEADER, h );
+    EEPROM.put( EEPROM_ADDR_CONFIG, configData() );
+    EEPROM.put( EEPROM_ADDR_CFGX,   configExt() );
+    for ( int i = 0; i < 4 * (int)sizeof(CommitTag); i++ ) EEPROM.write( EEPROM_ADDR_CFG_TAGS + i, 0 );
+}
+
+//  Migration committed ConfigExt into slot B (no slot was valid), so a reset
+//  part-way through the next commit, into slot A, keeps it
+static void checkConfigExtCommitted( time_t t ) {
+    HT_CHECK_EQ( configExt().stall_limit_ma, 1500 );
+    HT_CHECK_EQ( tagOf( 3 ).seq, 1u );
+    for ( int i = 0; i < 20; i++ ) EEPROM.write( EEPROM_ADDR_CFGX + i, 0xA5 );
+    HostTest::bootFirmware( t, true );
+    HT_CHECK_EQ( configExt().stall_limit_ma, 1500 );
+}
+
+HT_TEST(v3_image_commits_config_ext) {
+    HostTest::bootFirmware( T0 );
+    ConfigExt x = configExt();
+    x.stall_limit_ma = 1500;
+    writeConfigExt( x );
+    makeLegacyImage( 3 );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    checkConfigExtCommitted( T0 + 120 );
+}
+
+HT_TEST(v2_image_commits_config_ext) {
+    HostTest::bootFirmware( T0 );
+    ConfigExt x = configExt();
+    x.stall_limit_ma = 1500;
+    writeConfigExt( x );
+    makeLegacyImage( 2 );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    EEPROMHeader h;
+    EEPROM.get( EEPROM_ADDR_HEADER, h );
+    HT_CHECK_EQ( h.version, (uint8_t)EEPROM_VERSION );
+    checkConfigExtCommitted( T0 + 120 );
+}
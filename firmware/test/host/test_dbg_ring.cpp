@@ -0,0 +1,86 @@
+/**
+ * @file    test_dbg_ring.cpp
+ * @brief   Per-event diagnostics go to the SFDBG ring, not to one forced
+ *          publish each; the ring is paged through s_DbgLog and flushed in
+ *          batches while debug is enabled.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "Dbg.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+// 20 events for a flag this unit does not fly: each one fails flg-match
+static void injectForeign() {
+    for ( int i = 0; i < 20; i++ ) {
+        String js = String::format(
+            "{\"IDV\":\"%d.1\",\"JUR\":\"FE-US\",\"FLG\":\"ZZ\",\"BMK\":\"2025-06-16T12:00Z\",\"EMK\":\"2025-06-16T13:00Z\"}",
+            100 + i );
+        HostSim::deliver( "FE-US", js.c_str() );
+    }
+}
+
+HT_TEST(reprocess_does_not_publish_per_event) {
+    HostTest::bootFirmware( T0 );
+    injectForeign();
+    HT_CHECK_EQ( SFDBG::noted(), 20u );
+
+    HostSim::clearPublished();
+    evMgr.reprocessEvents( EVD_ALL );
+    HT_CHECK_EQ( HostSim::publishCount( "SFDBG" ), (size_t)0 );
+    HT_CHECK_EQ( SFDBG::noted(), 40u );
+
+    SFDBG::Rec r;
+    HT_CHECK( SFDBG::at( 0, r ) );
+    HT_CHECK_EQ( (int)r.code, (int)SFDBG::FLG_FAIL );
+    HT_CHECK_EQ( (int)r.tag,  (int)SFDBG::TAG_EM );
+    HT_CHECK( r.t >= (uint32_t)T0 && r.t < (uint32_t)T0 + 60 );
+    HT_CHECK( SFDBG::at( SFDBG::RING_N - 1, r ) );
+    HT_CHECK( !SFDBG::at( SFDBG::RING_N, r ) );
+}
+
+HT_TEST(log_is_paged_newest_first) {
+    HostTest::bootFirmware( T0 );
+    injectForeign();
+
+    String js;
+    HT_CHECK( HostSim::readVariable( "s_DbgLog", js ) );
+    HT_CHECK( js.startsWith( "{\"N\":20,\"P\":0,\"NP\":2,\"R\":[" ) );
+    HT_CHECK( js.indexOf( String::format( ",1,%d,119,", (int)SFDBG::FLG_FAIL ) ) > 0 );
+    HT_CHECK( js.length() < 622 );
+
+    int rc = -1;
+    HostSim::callFunction( "s_DbgPage", "1", rc );
+    HT_CHECK_EQ( rc, 1 );
+    HT_CHECK( HostSim::readVariable( "s_DbgLog", js ) );
+    HT_CHECK( js.indexOf( ",100," ) > 0 );      // oldest record on the last page
+    HT_CHECK( js.indexOf( ",119," ) < 0 );
+}
+
+static size_t logPublishes() {
+    size_t n = 0;
+    for ( const auto &p : HostSim::published() ) {
+        if ( p.name != "SFDBG" || p.data.find( "\"T\":\"LOG\"" ) == std::string::npos ) continue;
+        HT_CHECK( p.data.size() < 622 );
+        n++;
+    }
+    return n;
+}
+
+HT_TEST(enabled_ring_flushes_in_batches) {
+    HostTest::bootFirmware( T0 );
+    SFDBG::enabled = true;
+    HostSim::clearPublished();
+    injectForeign();
+    HT_CHECK_EQ( logPublishes(), (size_t)0 );
+
+    HostTest::runLoop( SFDBG::MIN_GAP_MS + 1000, 100 );
+    HT_CHECK_EQ( logPublishes(), (size_t)1 );       // LOG_PAGE records
+    HostTest::runLoop( SFDBG::MIN_GAP_MS + 1000, 100 );
+    HT_CHECK_EQ( logPublishes(), (size_t)2 );       // the remaining 8
+    HostTest::runLoop( 2 * SFDBG::MIN_GAP_MS, 1000 );
+    HT_CHECK_EQ( logPublishes(), (size_t)2 );
+    SFDBG::enabled = false;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file    test_deadlines.cpp
+ * @brief   DeadlineScheduler ordering, re-arming and millis() wrap, and the
+ *          firmware timers that moved onto it.
+ */
+
+#include "HostTest.h"
+#include "Deadlines.h"
+#include "EventManager.h"
+#include "HalyardManager.h"
+#include "SmartFlagFSM.h"
+
+#include <string>
+
+extern HalyardManager halMgr1;
+extern FSMController  fsm;
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static const pin_t LID_PIN = D12;
+
+static std::string s_log;
+static void logId( void *ctx ) { s_log += (char)( 'a' + (intptr_t)ctx ); }
+
+static size_t reports( const char *rsn ) {
+    std::string tag = std::string( "\"RSN\":\"" ) + rsn + "\"";
+    size_t n = 0;
+    for ( const HostSim::Publish &p : HostSim::published() ) {
+        if ( p.name == "statusReport" && p.data.find( tag ) != std::string::npos ) n++;
+    }
+    return n;
+}
+
+HT_TEST(fires_in_deadline_order) {
+    HostSim::reset();
+    DeadlineScheduler d;
+    int a = d.add( logId, (void *)0 ), b = d.add( logId, (void *)1 ), c = d.add( logId, (void *)2 );
+    s_log.clear();
+
+    d.arm( a, 300 ); d.arm( b, 100 ); d.arm( c, 200 );
+    HT_CHECK_EQ( d.msUntilNext(), 100u );
+    HT_CHECK_EQ( d.poll(), 0 );                      // nothing due yet
+
+    HostSim::advanceMs( 250 );
+    HT_CHECK_EQ( d.poll(), 2 );
+    HT_CHECK( s_log == "bc" );
+    HT_CHECK_EQ( d.msUntilNext(), 50u );
+
+    d.arm( a, 10 );                                  // re-arming moves it
+    d.arm( b, 5 );
+    d.disarm( b );
+    HostSim::advanceMs( 50 );
+    HT_CHECK_EQ( d.poll(), 1 );
+    HT_CHECK( s_log == "bca" );
+    HT_CHECK( !d.armed( a ) && !d.armed( b ) );
+    HT_CHECK_EQ( d.msUntilNext(), DeadlineScheduler::IDLE );
+}
+
+static DeadlineScheduler *s_sched;
+static int s_self = -1, s_runs = 0;
+static void rearmSelf( void * ) { s_runs++; s_sched->arm( s_self, 0 ); }
+static void periodic ( void * ) { s_runs++; s_sched->rearm( s_self, 1000 ); }
+
+HT_TEST(self_rearm_runs_once_per_poll) {
+    HostSim::reset();
+    DeadlineScheduler d;
+    s_sched = &d;
+    s_self  = d.add( rearmSelf );
+    s_runs  = 0;
+    d.arm( s_self, 0 );
+    HT_CHECK_EQ( d.poll(), 1 );
+    HT_CHECK_EQ( d.poll(), 1 );
+    HT_CHECK_EQ( s_runs, 2 );
+
+    // rearm() steps from the previous due time, so late polls do not drift
+    d.clear();
+    s_self = d.add( periodic );
+    s_runs = 0;
+    d.arm( s_self, 1000 );
+    for ( int i = 0; i < 10; i++ ) { HostSim::advanceMs( 1003 ); d.poll(); }
+    HT_CHECK_EQ( s_runs, 10 );
+    HT_CHECK_EQ( d.msUntilNext(), 1000u - 30u );
+}
+
+HT_TEST(survives_millis_wrap) {
+    HostSim::reset();
+    DeadlineScheduler d;
+    int a = d.add( logId, (void *)0 );
+    s_log.clear();
+    d.poll();
+    HostSim::advanceMs( 0xFFFFFF00UL );
+    d.arm( a, 0x200 );                               // due after the 32-bit wrap
+    HostSim::advanceMs( 0x100 );
+    HT_CHECK_EQ( d.poll(), 0 );
+    HT_CHECK_EQ( d.msUntilNext(), 0x100u );
+    HostSim::advanceMs( 0x100 );
+    HT_CHECK_EQ( d.poll(), 1 );
+    HT_CHECK( s_log == "a" );
+}
+
+HT_TEST(move_timeout_then_fault_recovery_timeout) {
+    HostTest::bootFirmware( T0 );
+    HostTest::runLoop( 1000 );
+    int rc = -1;
+    HT_CHECK( HostSim::callFunction( "OrderHFS", "H", rc ) );
+    HostTest::runLoop( 1000 );
+    HT_CHECK_EQ( fsm.currentState(), STATE_MOVING_TO_STATION );
+    HT_CHECK( halMgr1.isRunning() );
+
+    HostTest::runLoop( 121UL * 1000, 1000 );                // half marker never seen
+    HT_CHECK( !halMgr1.isRunning() );
+    HT_CHECK_EQ( halMgr1.getMoveStatus(), FLAG_MOVE_TIMEOUT );
+    HT_CHECK_EQ( fsm.currentState(), STATE_FAULT_RECOVERY );
+
+    HostTest::runLoop( 890UL * 1000, 1000 );
+    HT_CHECK_EQ( fsm.currentState(), STATE_FAULT_RECOVERY );
+    HostTest::runLoop( 20UL * 1000, 1000 );
+    HT_CHECK( fsm.currentState() != STATE_FAULT_RECOVERY );
+}
+
+HT_TEST(heartbeat_runs_on_its_period) {
+    // A day later, clear of the previous boot's reports in the burst limiter
+    HostTest::bootFirmware( T0 + 86400 );
+    HostTest::runLoop( 1000 );
+    size_t first = reports( "RPT" );
+    HT_CHECK( first >= 1 );
+
+    HostTest::runLoop( 21600UL * 1000 - 10000, 5000 );      // default status_period_sec
+    HT_CHECK_EQ( reports( "RPT" ), first );
+    HostTest::runLoop( 20000, 5000 );
+    HT_CHECK_EQ( reports( "RPT" ), first + 1 );
+}
+
+HT_TEST(forced_station_expires) {
+    HostTest::bootFirmware( T0 );
+    HostTest::runLoop( 1000 );
+    int rc = -1;
+    HT_CHECK( HostSim::callFunction( "TempHALF", "2", rc ) );
+    HT_CHECK( halMgr1.getOrderedStation() == FLAG_HALF );
+    HostTest::runLoop( 119UL * 1000, 1000 );
+    HT_CHECK( halMgr1.getOrderedStation() == FLAG_HALF );
+    HostTest::runLoop( 2000, 1000 );
+    HT_CHECK( halMgr1.getOrderedStation() == FLAG_FULL );
+}
+
+HT_TEST(lid_countdown_then_calibrates) {
+    HostTest::bootFirmware( T0 );
+    HostTest::runLoop( 1000 );
+    HT_CHECK_EQ( fsm.currentState(), STATE_ON_STATION );
+
+    HostSim::setDigital( LID_PIN, HIGH );                   // lid open
+    HostTest::runLoop( 500 );
+    HT_CHECK_EQ( fsm.currentState(), STATE_LID_OPEN );
+
+    HostSim::setDigital( LID_PIN, LOW );                    // closed for 5 s, then reopened
+    HostTest::runLoop( 5000 );
+    HostSim::setDigital( LID_PIN, HIGH );
+    HostTest::runLoop( 500 );
+    HostSim::setDigital( LID_PIN, LOW );
+    HostTest::runLoop( 9500 );
+    HT_CHECK_EQ( fsm.currentState(), STATE_LID_OPEN );      // countdown restarted
+    HostTest::runLoop( 1000 );
+    HT_CHECK( fsm.currentState() != STATE_LID_OPEN );
+}
+
+HT_TEST(idle_loop_has_nothing_due) {
+    HostTest::bootFirmware( T0 );
+    HostTest::runLoop( 1000 );
+    // Heartbeat and the event-check timer are armed; neither is due for a while
+    HT_CHECK_EQ( deadlines.poll(), 0 );
+    HT_CHECK( deadlines.msUntilNext() > 60UL * 1000 );
+    HT_CHECK( deadlines.msUntilNext() != DeadlineScheduler::IDLE );
+}
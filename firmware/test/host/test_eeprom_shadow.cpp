@@ -0,0 +1,72 @@
+/**
+ * @file    test_eeprom_shadow.cpp
+ * @brief   EEPROM shadow: reads stay in RAM, writes reach EEPROM only as
+ *          coalesced spans on commit(), and the upper region passes through.
+ */
+
+#include "HostTest.h"
+#include "EEPROMManager.h"
+#include "EEPROMShadow.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+HT_TEST(reads_are_served_from_ram) {
+    HostTest::bootFirmware( T0 );
+    HostSim::resetEepromStats();
+    for ( int i = 0; i < 10; i++ ) {
+        EventHeader eh;
+        readEventHeader( eh );
+        EventStrings t;
+        readEventStrings( t );
+    }
+    HT_CHECK_EQ( HostSim::eepromStats().getCalls, 0u );
+}
+
+HT_TEST(writes_flush_as_coalesced_spans) {
+    HostTest::bootFirmware( T0 );
+    eepromShadow.commit();
+    eepromShadow.resetStats();
+    HostSim::resetEepromStats();
+
+    uint32_t a = 0x11223344, b = 0x55667788;
+    eepromShadow.put( 1000, a );
+    eepromShadow.put( 1006, b );              // 2 clean bytes between: one span
+    eepromShadow.write( 1500, 0x5A );
+    eepromShadow.put( 1000, a );              // unchanged: not marked again
+    HT_CHECK( eepromShadow.dirty() );
+    HT_CHECK_EQ( HostSim::eepromStats().putCalls, 0u );
+    uint32_t got = 0;
+    HT_CHECK_EQ( eepromShadow.get( 1000, got ), a );
+
+    HT_CHECK_EQ( eepromShadow.commit(), 2 );
+    HT_CHECK( !eepromShadow.dirty() );
+    HT_CHECK_EQ( HostSim::eepromStats().putCalls, 2u );
+    HT_CHECK_EQ( EEPROM.get( 1006, got ), b );
+    HT_CHECK_EQ( EEPROM.read( 1500 ), 0x5A );
+
+    const EEPROMShadow::Stats &st = eepromShadow.stats();
+    HT_CHECK_EQ( st.logicalWrites, 4u );
+    HT_CHECK_EQ( st.physicalWrites, 2u );
+    HT_CHECK_EQ( st.physicalBytes, 11u );
+    HT_CHECK_EQ( eepromShadow.commit(), 0 );
+}
+
+HT_TEST(uncommitted_writes_do_not_survive_reset) {
+    HostTest::bootFirmware( T0 );
+    eepromShadow.commit();
+    uint8_t before = EEPROM.read( 1200 );
+    eepromShadow.write( 1200, (uint8_t)~before );
+    eepromShadow.begin();                     // as after a reset
+    HT_CHECK_EQ( eepromShadow.read( 1200 ), before );
+}
+
+HT_TEST(upper_region_passes_through) {
+    HostTest::bootFirmware( T0 );
+    uint16_t v = 0xBEEF, got = 0;
+    eepromShadow.put( EEPROMShadow::BYTES - 1, v );   // straddles the boundary
+    HT_CHECK_EQ( EEPROM.read( EEPROMShadow::BYTES ), 0xBE );
+    HT_CHECK_EQ( eepromShadow.get( EEPROMShadow::BYTES - 1, got ), v );
+    eepromShadow.commit();
+    HT_CHECK_EQ( EEPROM.get( EEPROMShadow::BYTES - 1, got ), v );
+}
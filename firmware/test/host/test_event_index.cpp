@@ -0,0 +1,134 @@
+/**
+ * @file    test_event_index.cpp
+ * @brief   EventIndex unit checks plus a differential test against the
+ *          legacy setNextEvent() overlap loop (LegacySchedule.h).
+ */
+
+#include "HostTest.h"
+#include "EventIndex.h"
+#include "LegacySchedule.h"
+
+#include <random>
+
+static const time_t NOW = 1750000000;
+
+// Build spans exactly as EventManager::setNextEvent() does, then query.
+static LegacyResult indexSetNextEvent( const std::vector<time_t> &b,
+                                       const std::vector<time_t> &e, time_t now ) {
+    time_t nullT = now + 30L * 24 * 60 * 60;
+    std::vector<EventSpan> spans;
+    for ( size_t i = 0; i < b.size(); i++ ) {
+        time_t end = ( e[i] == 0 ) ? nullT : e[i];
+        if ( b[i] > now || ( b[i] > 0 && end > now ) ) spans.push_back( { b[i], end } );
+    }
+    int n = EventIndex::merge( spans.data(), (int)spans.size() );
+    LegacyResult r;
+    r.orderedSta = EventIndex::query( spans.data(), n, now, r.nextChange, r.nextSta );
+    return r;
+}
+
+HT_TEST(merge_coalesces_overlapping_and_touching) {
+    EventSpan s[] = { { 50, 60 }, { 10, 20 }, { 20, 30 }, { 25, 40 }, { 41, 45 } };
+    int n = EventIndex::merge( s, 5 );
+    HT_CHECK_EQ( n, 3 );
+    HT_CHECK_EQ( (long)s[0].begin, 10L ); HT_CHECK_EQ( (long)s[0].end, 40L );
+    HT_CHECK_EQ( (long)s[1].begin, 41L ); HT_CHECK_EQ( (long)s[1].end, 45L );
+    HT_CHECK_EQ( (long)s[2].begin, 50L ); HT_CHECK_EQ( (long)s[2].end, 60L );
+
+    HT_CHECK_EQ( EventIndex::find( s, n, 9 ),  -1 );
+    HT_CHECK_EQ( EventIndex::find( s, n, 10 ),  0 );
+    HT_CHECK_EQ( EventIndex::find( s, n, 40 ), -1 );   // half-open
+    HT_CHECK_EQ( EventIndex::firstAfter( s, n, 40 ), 1 );
+    HT_CHECK_EQ( EventIndex::firstAfter( s, n, 50 ), -1 );
+}
+
+HT_TEST(query_reports_station_and_next_change) {
+    EventSpan s[] = { { 100, 200 }, { 300, 400 } };
+    time_t nc; FlagStation ns;
+    HT_CHECK( EventIndex::query( s, 2, 50, nc, ns ) == FLAG_FULL );
+    HT_CHECK_EQ( (long)nc, 100L ); HT_CHECK( ns == FLAG_HALF );
+    HT_CHECK( EventIndex::query( s, 2, 150, nc, ns ) == FLAG_HALF );
+    HT_CHECK_EQ( (long)nc, 200L ); HT_CHECK( ns == FLAG_FULL );
+    HT_CHECK( EventIndex::query( s, 2, 500, nc, ns ) == FLAG_FULL );
+    HT_CHECK_EQ( (long)nc, 0L ); HT_CHECK( ns == FLAG_UNKNOWN );
+}
+
+HT_TEST(differential_against_legacy_overlap_loop) {
+    std::mt19937 rng( 12345 );
+    const int sizes[] = { 1, 2, 5, 20, 200, 2000 };
+    int trials = 0;
+    for ( int n : sizes ) {
+        int reps = n >= 200 ? 50 : 2000;
+        for ( int r = 0; r < reps; r++ ) {
+            // Mix of past, in-progress, future, open-ended, touching and
+            // zero-length windows on a coarse grid so collisions are common.
+            std::uniform_int_distribution<int> slot( -40, 80 );
+            std::uniform_int_distribution<int> len ( 0, 12 );
+            std::uniform_int_distribution<int> kind( 0, 9 );
+            std::vector<time_t> b( n ), e( n );
+            for ( int i = 0; i < n; i++ ) {
+                b[i] = NOW + slot( rng ) * 3600L;
+                int k = kind( rng );
+                if      ( k == 0 ) e[i] = 0;                              // open-ended
+                else if ( k == 1 ) e[i] = b[i];                           // empty window
+                else               e[i] = b[i] + len( rng ) * 3600L;
+                if ( kind( rng ) == 0 ) b[i] = NOW;                       // starts exactly now
+            }
+            LegacyResult want = legacySetNextEvent( b, e, NOW );
+            LegacyResult got  = indexSetNextEvent( b, e, NOW );
+            HT_CHECK( want.orderedSta == got.orderedSta );
+            HT_CHECK_EQ( (long)want.nextChange, (long)got.nextChange );
+            HT_CHECK( want.nextSta == got.nextSta );
+            trials++;
+        }
+    }
+    HT_CHECK( trials > 0 );
+}
+
+HT_TEST(transitions_list_changes_in_window) {
+    EventSpan s[] = { { 100, 200 }, { 300, 400 }, { 500, 900 } };
+    EventTransition tr[8];
+    int n = EventIndex::transitions( s, 3, 150, 600, 900, tr, 0, 8 );
+    HT_CHECK_EQ( n, 4 );                                // in progress at 150: no HALF at 100
+    HT_CHECK_EQ( (long)tr[0].at, 200L ); HT_CHECK( tr[0].sta == FLAG_FULL );
+    HT_CHECK_EQ( (long)tr[1].at, 300L ); HT_CHECK( tr[1].sta == FLAG_HALF );
+    HT_CHECK_EQ( (long)tr[2].at, 400L ); HT_CHECK( tr[2].sta == FLAG_FULL );
+    HT_CHECK_EQ( (long)tr[3].at, 500L ); HT_CHECK( tr[3].sta == FLAG_HALF );
+
+    // Open-ended end is never reported, even inside the window
+    HT_CHECK_EQ( EventIndex::transitions( s, 3, 150, 1000, 900, tr, 0, 8 ), 4 );
+    HT_CHECK_EQ( EventIndex::transitions( s, 3, 150, 1000, 0,   tr, 0, 8 ), 5 );
+
+    // Paging: total is reported, only the requested slice is written
+    HT_CHECK_EQ( EventIndex::transitions( s, 3, 150, 600, 900, tr, 3, 2 ), 4 );
+    HT_CHECK_EQ( (long)tr[0].at, 500L );
+    HT_CHECK_EQ( EventIndex::transitions( s, 3, 1000, 2000, 900, tr, 0, 8 ), 0 );
+}
+
+HT_TEST(transitions_replay_matches_query) {
+    std::mt19937 rng( 777 );
+    std::uniform_int_distribution<int> slot( -20, 60 );
+    std::uniform_int_distribution<int> len ( 0, 8 );
+    for ( int r = 0; r < 2000; r++ ) {
+        EventSpan s[20];
+        for ( int i = 0; i < 20; i++ ) {
+            s[i].begin = NOW + slot( rng ) * 3600L;
+            s[i].end   = s[i].begin + len( rng ) * 3600L;
+        }
+        int n = EventIndex::merge( s, 20 );
+
+        EventTransition tr[40];
+        time_t to = NOW + 48 * 3600L;
+        int nt = EventIndex::transitions( s, n, NOW, to, -1, tr, 0, 40 );
+        HT_CHECK( nt <= 40 );
+
+        // Replaying the changes from the station at NOW reproduces query() throughout
+        time_t nc; FlagStation ns;
+        FlagStation sta = EventIndex::query( s, n, NOW, nc, ns );
+        int k = 0;
+        for ( time_t t = NOW; t <= to; t += 1800 ) {
+            while ( k < nt && tr[k].at <= t ) sta = tr[k++].sta;
+            HT_CHECK( sta == EventIndex::query( s, n, t, nc, ns ) );
+        }
+    }
+}
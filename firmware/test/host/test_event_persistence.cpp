@@ -0,0 +1,354 @@
+/**
+ * @file    test_event_persistence.cpp
+ * @brief   Packed event persistence: change-only writes, per-record CRC,
+ *          loading of sparse / corrupt tables, and migration of v3 images.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "EEPROMShadow.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static void inject( int id, bool del = false ) {
+    String js = HostTest::eventJSON( id );
+    if ( del ) js = js.substring( 0, js.length() - 1 ) + ",\"DEL\":true}";
+    HostSim::deliver( "FE-US", js.c_str() );
+}
+
+// Record @p n of a table of SJR-less events
+//  Raw EEPROM bytes of record @p n, once loop() would have flushed the shadow
+static uint8_t *recBytes( int n ) {
+    eepromShadow.commit();
+    return EEPROM.image() + EEPROM_ADDR_EVENT_RECS + n * PACKED_EVENT_BASE;
+}
+
+static FlagEvent v3Event( const char *idv, const char *flg, const char *bmk, const char *emk,
+                          std::initializer_list<uint16_t> sjr = {} ) {
+    FlagEvent e;
+    memset( &e, 0, sizeof(e) );
+    strncpy( e.idv, idv, sizeof(e.idv) - 1 );
+    strncpy( e.flg, flg, sizeof(e.flg) - 1 );
+    strncpy( e.jur, "FE-US", sizeof(e.jur) - 1 );
+    packEventMark( e.bmk, TimeMarks::compile( bmk ) );
+    strncpy( e.emk, emk, sizeof(e.emk) - 1 );           // as images before compiled marks
+    for ( uint16_t id : sjr ) e.sjrList[e.sjrCount++] = id;
+    return e;
+}
+
+// Rewrite the image as EEPROM v3: 80-byte FlagEvent slots from EVENT_LIST
+static void writeV3Image( const FlagEvent *ev, int n, bool slotCRC ) {
+    eepromShadow.commit();
+    EEPROMHeader h;
+    EEPROM.get( EEPROM_ADDR_HEADER, h );
+    h.version = 3;
+    EEPROM.put( EEPROM_ADDR_HEADER, h );
+    EEPROM.put( EEPROM_ADDR_CONFIG, configData() );       // v3: one ConfigData block
+
+    EventHeader eh = {};
+    eh.eventCount = (uint8_t)n;
+    eh.flags      = slotCRC ? EVH_FLAG_CRC : 0;
+    EEPROM.put( EEPROM_ADDR_EVENT_HDR, eh );
+    for ( int i = 0; i < n; i++ ) {
+        FlagEvent e = ev[i];
+        e.crc8 = slotCRC ? eventCRC( e ) : 0;
+        EEPROM.put( EEPROM_ADDR_EVENT_LIST + i * (int)sizeof(FlagEvent), e );
+    }
+}
+
+HT_TEST(receive_writes_only_the_changed_slot) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    for ( int id = 1; id <= 10; id++ ) inject( id );
+
+    uint32_t slots0 = evMgr.eventSlotWrites(), bytes0 = evMgr.eventBytesWritten();
+    inject( 11 );
+    HT_CHECK_EQ( evMgr.eventSlotWrites() - slots0, 1u );
+    HT_CHECK_EQ( evMgr.eventBytesWritten() - bytes0, (uint32_t)( PACKED_EVENT_BASE + sizeof(EventHeader) ) );
+
+    // A full reprocess with nothing new writes nothing
+    bytes0 = evMgr.eventBytesWritten();
+    HostSim::resetEepromStats();
+    evMgr.reprocessEvents();
+    HT_CHECK_EQ( evMgr.eventBytesWritten(), bytes0 );
+}
+
+HT_TEST(sparse_slots_survive_reboot) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    inject( 1 ); inject( 2 ); inject( 3 );
+    inject( 1, true );                  // free slot 0; events remain in slots 1 and 2
+    HT_CHECK_EQ( evMgr.getNEvents(), 2 );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 2 );
+    HT_CHECK_EQ( evMgr.corruptSlotsSkipped(), 0u );
+}
+
+HT_TEST(corrupt_slot_is_skipped) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    inject( 1 ); inject( 2 ); inject( 3 );
+
+    recBytes( 1 )[ offsetof(PackedEvent, bmk) ] ^= 0x40;   // flip a bit in event 2's begin mark
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 2 );
+    HT_CHECK_EQ( evMgr.corruptSlotsSkipped(), 1u );
+
+    // The slot is rewritten empty on the next save, so the following boot is clean
+    HostTest::bootFirmware( T0 + 120, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 2 );
+    HT_CHECK_EQ( evMgr.corruptSlotsSkipped(), 0u );
+}
+
+// The header count on EEPROM never covers a record that is not there yet
+HT_TEST(count_is_ordered_against_records) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    inject( 1 ); inject( 2 );
+    eepromShadow.commit();
+
+    EventHeader eh;
+    inject( 3 );                        // growing: records reach EEPROM, count still pending
+    EEPROM.get( EEPROM_ADDR_EVENT_HDR, eh );
+    HT_CHECK_EQ( eh.eventCount, 2 );
+    HT_CHECK( EEPROM.image()[ EEPROM_ADDR_EVENT_RECS + 2 * PACKED_EVENT_BASE ] != 0 );
+    eepromShadow.commit();
+    EEPROM.get( EEPROM_ADDR_EVENT_HDR, eh );
+    HT_CHECK_EQ( eh.eventCount, 3 );
+
+    inject( 1, true );                  // shrinking: the new count is written first
+    EEPROM.get( EEPROM_ADDR_EVENT_HDR, eh );
+    HT_CHECK_EQ( eh.eventCount, 2 );
+    HT_CHECK( eepromShadow.dirty() );   // moved records still pending
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 2 );
+    HT_CHECK_EQ( evMgr.corruptSlotsSkipped(), 0u );
+}
+
+// Every JUR / FLG intern() accepts has an EventStrings entry, so what was
+// received is what comes back after a reboot
+HT_TEST(distinct_jurisdictions_survive_reboot) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    for ( int k = 0; k < 20; k++ ) {
+        String js = String::format(
+            "{\"IDV\":\"%d.1\",\"JUR\":\"FE-OH-%c\",\"FLG\":\"OH\",\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\"}",
+            k + 1, 'A' + k );
+        HT_CHECK_EQ( evMgr.receiveEvent( js ), (int)EMrc::SUCCESS );
+    }
+    HT_CHECK_EQ( evMgr.getNEvents(), 20 );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 20 );
+}
+
+HT_TEST(full_string_table_rejects_ingest) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+
+    // Two new strings per event: the table's 31 entries take 15 events
+    int accepted = 0, rc = (int)EMrc::SUCCESS;
+    for ( int id = 1; id <= EventManager::N_EVENTS && rc == (int)EMrc::SUCCESS; id++ ) {
+        String js = String::format(
+            "{\"IDV\":\"%d.1\",\"JUR\":\"FE-OH-%d\",\"FLG\":\"F%d\",\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\"}",
+            id, id, id );
+        rc = evMgr.receiveEvent( js );
+        if ( rc == (int)EMrc::SUCCESS ) accepted++;
+    }
+    HT_CHECK_EQ( rc, (int)EMrc::EVL_OVERFLOW );
+    HT_CHECK_EQ( accepted, ( EVS_STR_N - 1 ) / 2 );
+    HT_CHECK_EQ( atoi( evMgr.showDigest().c_str() ), accepted );   // held, applying or not
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( atoi( evMgr.showDigest().c_str() ), accepted );
+}
+
+HT_TEST(full_table_survives_reboot) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    for ( int id = 1; id <= EventManager::N_EVENTS; id++ ) inject( id );
+    HT_CHECK_EQ( atoi( evMgr.showDigest().c_str() ), EventManager::N_EVENTS );
+    String digest = evMgr.showDigest();
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK( evMgr.showDigest() == digest );
+}
+
+// SJR entries make records longer; an event that would not fit the record
+// area is refused rather than kept in RAM only
+HT_TEST(record_area_bounds_ingest) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    const int fit = EVENT_RECS_BYTES / ( PACKED_EVENT_BASE + 2 * FlagEventEx::MAX_SJR );
+
+    int rc = (int)EMrc::SUCCESS, id = 0;
+    while ( rc == (int)EMrc::SUCCESS && id < EventManager::N_EVENTS ) {
+        id++;
+        rc = evMgr.receiveEvent( String::format(
+            "{\"IDV\":\"%d.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\","
+            "\"SJR\":[1,2,3,4,5,6,7]}", id ) );
+    }
+    HT_CHECK_EQ( rc, (int)EMrc::EVL_OVERFLOW );
+    HT_CHECK_EQ( id, fit + 1 );
+
+    // A shorter update of a held event still fits
+    HT_CHECK_EQ( evMgr.receiveEvent( HostTest::eventJSON( 1, 2 ) ), (int)EMrc::SUCCESS );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( atoi( evMgr.showDigest().c_str() ), fit );
+    HT_CHECK_EQ( evMgr.corruptSlotsSkipped(), 0u );
+}
+
+// A reset after the string entries reach EEPROM but before the records do:
+// the old records must still read their own JUR / FLG text
+HT_TEST(torn_flush_keeps_record_strings) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    const char *ev = "{\"IDV\":\"%d.1\",\"JUR\":\"FE-OH-%c\",\"FLG\":\"OH\",\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\"}";
+    evMgr.receiveEvent( String::format( ev, 1, 'A' ) );
+    evMgr.receiveEvent( String::format( ev, 2, 'B' ) );
+    eepromShadow.commit();
+
+    // Deleting 1 frees "FE-OH-A" in the same save that interns "FE-OH-C"
+    String batch = "[{\"IDV\":\"1.2\",\"DEL\":true}," + String::format( ev, 3, 'C' ) + "]";
+    HT_CHECK_EQ( evMgr.receiveEvents( batch ), (int)EMrc::SUCCESS );
+    std::vector<uint8_t> recs( EEPROM.image() + EEPROM_ADDR_EVENT_RECS,
+                               EEPROM.image() + EEPROM_ADDR_EVENT_RECS + EVENT_RECS_BYTES );
+    eepromShadow.commit();
+    memcpy( EEPROM.image() + EEPROM_ADDR_EVENT_RECS, recs.data(), recs.size() );   // records span lost
+
+    HostTest::bootFirmware( T0 + 60, true );
+    for ( int i = 0; i < EventManager::N_EVENTS; i++ ) {
+        evMgr.setShowIdx( i );
+        String js = evMgr.showEventAtCursor();
+        if ( js.indexOf( "\"1.1\"" ) > 0 ) HT_CHECK( js.indexOf( "FE-OH-A" ) > 0 );
+        if ( js.indexOf( "\"2.1\"" ) > 0 ) HT_CHECK( js.indexOf( "FE-OH-B" ) > 0 );
+    }
+}
+
+// With every free entry pinned, the event needing new strings waits for a
+// second pass in the same save
+HT_TEST(pinned_full_table_saves_in_two_passes) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    const char *ev = "{\"IDV\":\"%d.1\",\"JUR\":\"FE-OH-%d\",\"FLG\":\"F%d\",\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\"}";
+    const int n = ( EVS_STR_N - 1 ) / 2;            // one entry left over
+    for ( int id = 1; id <= n; id++ ) evMgr.receiveEvent( String::format( ev, id, id, id ) );
+
+    uint32_t saves0 = evMgr.eventSaveCalls();
+    String batch = "[{\"IDV\":\"1.2\",\"DEL\":true}," + String::format( ev, 99, 99, 99 ) + "]";
+    HT_CHECK_EQ( evMgr.receiveEvents( batch ), (int)EMrc::SUCCESS );
+    HT_CHECK_EQ( evMgr.eventSaveCalls() - saves0, 1u );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( atoi( evMgr.showDigest().c_str() ), n );
+    bool found = false;
+    for ( int i = 0; i < EventManager::N_EVENTS; i++ ) {
+        evMgr.setShowIdx( i );
+        String js = evMgr.showEventAtCursor();
+        if ( js.indexOf( "\"99.1\"" ) < 0 ) continue;
+        found = js.indexOf( "FE-OH-99" ) > 0 && js.indexOf( "F99" ) > 0;
+    }
+    HT_CHECK( found );
+}
+
+static std::string eventDump() {
+    std::string all;
+    for ( int i = 0; i < EventManager::N_EVENTS; i++ ) {
+        evMgr.setShowIdx( i );
+        all += evMgr.showEventAtCursor().c_str();
+    }
+    return all;
+}
+
+HT_TEST(v3_image_migrates_in_place) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    const char *js[] = {
+        "{\"IDV\":\"5.2\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\"}",
+        "{\"IDV\":\"6.1\",\"JUR\":\"FE-US\",\"FLG\":\"OH\",\"BMK\":\"2025-06-21\",\"EMK\":\"2025-06-21T23:30L\",\"SJR\":[39049,39041]}",
+        "{\"IDV\":\"7.3\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-06-22TSR\",\"EMK\":\"TBD\"}",
+    };
+    for ( const char *e : js ) HostSim::deliver( "FE-US", e );
+    HT_CHECK( evMgr.showHaveList() == "{\"N\":3,\"P\":0,\"NP\":1,\"H\":\"5.2,6.1,7.3\"}" );   // 6.1 stored, but SJR-targeted
+    std::string before = eventDump();
+
+    const FlagEvent v3[] = {
+        v3Event( "5.2", "US", "2025-06-20T12:00Z", "2025-06-20T13:00Z" ),
+        v3Event( "6.1", "OH", "2025-06-21",        "2025-06-21T23:30L", { 39049, 39041 } ),
+        v3Event( "7.3", "US", "2025-06-22TSR",     "TBD" ),
+    };
+    writeV3Image( v3, 3, true );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    EEPROMHeader h;
+    EEPROM.get( EEPROM_ADDR_HEADER, h );
+    HT_CHECK_EQ( h.version, EEPROM_VERSION );
+    HT_CHECK( evMgr.showHaveList() == "{\"N\":3,\"P\":0,\"NP\":1,\"H\":\"5.2,6.1,7.3\"}" );
+    HT_CHECK( eventDump() == before );
+
+    // 18 bytes per record plus 2 per SJR, against 80 per v3 slot
+    EventHeader eh;
+    EEPROM.get( EEPROM_ADDR_EVENT_HDR, eh );
+    HT_CHECK_EQ( eh.eventCount, 3 );
+    PackedEvent rec;
+    int offset = 0;
+    for ( int n = 0; n < 3; n++ ) {
+        HT_CHECK( readPackedEvent( offset, rec ) );
+        HT_CHECK_EQ( rec.crc8, packedCRC( rec ) );
+        offset += rec.len;
+    }
+    HT_CHECK_EQ( offset, 3 * PACKED_EVENT_BASE + 4 );
+}
+
+HT_TEST(pre_crc_v3_image_migrates) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+
+    const FlagEvent v3[] = { v3Event( "1.1", "US", "2025-06-20T12:00Z", "2025-06-20T13:00Z" ) };
+    writeV3Image( v3, 1, false );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 1 );
+    EventHeader hdr;
+    EEPROM.get( EEPROM_ADDR_EVENT_HDR, hdr );
+    HT_CHECK( hdr.flags & EVH_FLAG_CRC );
+}
+
+HT_TEST(string_table_keeps_indices) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    inject( 1 );
+    EventStrings t0;
+    readEventStrings( t0 );
+
+    const char *oh = "{\"IDV\":\"%d.1\",\"JUR\":\"FE-OH\",\"FLG\":\"OH\",\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\"}";
+    HostSim::deliver( "FE-OH", String::format( oh, 2 ).c_str() );
+    inject( 1, true );
+    EventStrings t1;
+    readEventStrings( t1 );
+
+    // "FE-OH" / "OH" took free entries; "FE-US" / "US" stay while event 1's
+    // record is still on EEPROM, and are freed by the next save
+    int used = 0;
+    for ( int i = 1; i < EVS_STR_N; i++ ) used += t1.s[i][0] != '\0';
+    HT_CHECK_EQ( used, 4 );
+    HostSim::deliver( "FE-OH", String::format( oh, 3 ).c_str() );
+    readEventStrings( t1 );
+    used = 0;
+    for ( int i = 1; i < EVS_STR_N; i++ ) used += t1.s[i][0] != '\0';
+    HT_CHECK_EQ( used, 2 );
+    for ( int i = 1; i < EVS_STR_N; i++ ) {
+        if ( t1.s[i][0] == '\0' ) continue;
+        HT_CHECK( strcmp( t0.s[i], "" ) == 0 );     // placed in an entry that was free before
+    }
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 2 );
+    evMgr.setShowIdx( 0 );
+    HT_CHECK( evMgr.showEventAtCursor().indexOf( "FE-OH" ) > 0 );
+}
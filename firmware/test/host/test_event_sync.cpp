@@ -0,0 +1,214 @@
+/**
+ * @file    test_event_sync.cpp
+ * @brief   s_EvDigest / s_EvHave delta sync: a backend stand-in diffs the
+ *          have-list against its catalogue and pushes only what is missing.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+#include <map>
+#include <cstdlib>
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static String variable( const char *name ) {
+    String out;
+    HostSim::readVariable( name, out );
+    return out;
+}
+
+struct HavePage {
+    int    n = -1, p = -1, np = -1;
+    String list;
+};
+
+//  Select and read one s_EvHave page
+static HavePage havePage( int p ) {
+    int rc = -1;
+    HT_CHECK( HostSim::callFunction( "s_EvHavePg", String::format( "%d", p ), rc ) );
+    HT_CHECK_EQ( rc, p );
+    HavePage pg;
+    String v = variable( "s_EvHave" );
+    HT_CHECK( v.length() <= 622 );
+    HT_CHECK_EQ( sscanf( v.c_str(), "{\"N\":%d,\"P\":%d,\"NP\":%d", &pg.n, &pg.p, &pg.np ), 3 );
+    int h = v.indexOf( "\"H\":\"" ) + 5;
+    pg.list = v.substring( h, v.indexOf( '"', h ) );
+    return pg;
+}
+
+//  Every s_EvHave page's entries, joined
+static String haveList() {
+    String all;
+    HavePage pg;
+    for ( int p = 0; p == 0 || p < pg.np; p++ ) {
+        pg = havePage( p );
+        if ( all.length() && pg.list.length() ) all += ",";
+        all += pg.list;
+    }
+    return all;
+}
+
+// ── Backend stand-in ─────────────────────────────────────────────────────────
+//  Holds id → version for every event the unit should have.  sync() reads
+//  s_EvDigest, and on a mismatch reads every s_EvHave page and injects the
+//  missing or newer events as s_InjectEv batches of at most ARG_MAX bytes (the
+//  firmware parses one JSON_BUF).  Returns the number of events pushed.
+struct Backend {
+    static const size_t ARG_MAX = 1023;
+
+    std::map<int, int> catalogue;
+    size_t             bytesSent = 0;
+
+    String digest() const {
+        uint32_t d = 0;
+        for ( const auto &e : catalogue ) d ^= EventManager::pairDigest( e.first, e.second );
+        return String::format( "%d:%08lx", (int)catalogue.size(), (unsigned long)d );
+    }
+
+    int sync() {
+        if ( variable( "s_EvDigest" ) == digest() ) return 0;
+
+        std::map<int, int> have;
+        String list = haveList();
+        const char *p = list.c_str();
+        while ( *p ) {
+            char *end;
+            int id  = (int)strtol( p, &end, 10 );
+            int ver = ( *end == '.' ) ? (int)strtol( end + 1, &end, 10 ) : 0;
+            have[id] = ver;
+            p = ( *end == ',' ) ? end + 1 : end;
+        }
+
+        String batch;
+        int    n = 0;
+        for ( const auto &e : catalogue ) {
+            auto h = have.find( e.first );
+            if ( h != have.end() && h->second >= e.second ) continue;
+            String ev = HostTest::eventJSON( e.first, e.second );
+            if ( batch.length() && batch.length() + ev.length() + 2 > ARG_MAX ) flush( batch );
+            batch += batch.length() ? "," : "[";
+            batch += ev;
+            n++;
+        }
+        if ( batch.length() ) flush( batch );
+        return n;
+    }
+
+    void flush( String &batch ) {
+        batch += "]";
+        int rc = -1;
+        HT_CHECK( HostSim::callFunction( "s_InjectEv", batch, rc ) );
+        HT_CHECK_EQ( rc, (int)EMrc::SUCCESS );
+        bytesSent += batch.length();
+        batch = "";
+    }
+};
+
+HT_TEST(digest_tracks_table) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    HT_CHECK( variable( "s_EvDigest" ) == "0:00000000" );
+    HT_CHECK( haveList() == "" );
+
+    evMgr.receiveEvent( HostTest::eventJSON( 30, 1 ) );
+    evMgr.receiveEvent( HostTest::eventJSON( 12, 2 ) );
+    evMgr.receiveEvent( HostTest::eventJSON( 21, 1 ) );
+    HT_CHECK( haveList() == "12.2,21.1,30.1" );
+
+    uint32_t d = EventManager::pairDigest( 30, 1 ) ^ EventManager::pairDigest( 12, 2 )
+               ^ EventManager::pairDigest( 21, 1 );
+    HT_CHECK_EQ( evMgr.eventDigest(), d );
+
+    // Newer version replaces the term; an older one changes nothing
+    evMgr.receiveEvent( HostTest::eventJSON( 21, 3 ) );
+    evMgr.receiveEvent( HostTest::eventJSON( 12, 1 ) );
+    d ^= EventManager::pairDigest( 21, 1 ) ^ EventManager::pairDigest( 21, 3 );
+    HT_CHECK_EQ( evMgr.eventDigest(), d );
+    HT_CHECK( haveList() == "12.2,21.3,30.1" );
+
+    // Delete removes it
+    evMgr.receiveEvent( "{\"IDV\":\"30.2\",\"DEL\":true,\"JUR\":\"FE-US\",\"FLG\":\"US\","
+                        "\"BMK\":\"2025-06-16T12:00Z\",\"EMK\":\"2025-06-16T13:00Z\"}" );
+    d ^= EventManager::pairDigest( 30, 1 );
+    HT_CHECK_EQ( evMgr.eventDigest(), d );
+    HT_CHECK( variable( "s_EvDigest" ) == String::format( "2:%08lx", (unsigned long)d ) );
+}
+
+HT_TEST(digest_survives_reboot) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    for ( int i = 0; i < 5; i++ ) evMgr.receiveEvent( HostTest::eventJSON( 40 + i, 1 + i ) );
+    String digest = variable( "s_EvDigest" );
+    String have   = haveList();
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK( variable( "s_EvDigest" ) == digest );
+    HT_CHECK( haveList() == have );
+}
+
+HT_TEST(backend_sends_only_the_delta) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+
+    Backend cloud;
+    for ( int i = 0; i < 12; i++ ) cloud.catalogue[100 + i] = 1;
+    HT_CHECK_EQ( cloud.sync(), 12 );
+    HT_CHECK_EQ( evMgr.getNEvents(), 12 );
+    HT_CHECK_EQ( cloud.sync(), 0 );                     // digests agree: nothing read or sent
+    size_t fullBytes = cloud.bytesSent;
+
+    // Offline: two new events, one revision.  Only those three go out.
+    HostTest::bootFirmware( T0 + 3600, true );
+    cloud.catalogue[112] = 1;
+    cloud.catalogue[113] = 1;
+    cloud.catalogue[105] = 2;
+    HT_CHECK_EQ( cloud.sync(), 3 );
+    HT_CHECK( cloud.bytesSent - fullBytes < fullBytes / 3 );
+    HT_CHECK( variable( "s_EvDigest" ) == cloud.digest() );
+    HT_CHECK_EQ( cloud.sync(), 0 );
+}
+
+HT_TEST(full_table_have_list_pages) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+
+    // The longest IDVs the firmware prints, in every slot
+    for ( int k = 0; k < EventManager::N_EVENTS; k++ ) {
+        HT_CHECK_EQ( evMgr.receiveEvent( HostTest::eventJSON( 2147483647 - k, 2147483647 ) ), (int)EMrc::SUCCESS );
+    }
+    HavePage pg;
+    int entries = 0;
+    for ( int p = 0; p == 0 || p < pg.np; p++ ) {
+        pg = havePage( p );
+        HT_CHECK_EQ( pg.n, EventManager::N_EVENTS );
+        HT_CHECK_EQ( pg.p, p );
+        for ( const char *e = pg.list.c_str(); *e; entries++ ) {   // whole "id.ver" entries only
+            char *end;
+            HT_CHECK( strtol( e, &end, 10 ) > 2147483647L - EventManager::N_EVENTS );
+            HT_CHECK( *end == '.' && strtol( end + 1, &end, 10 ) == 2147483647L );
+            e = ( *end == ',' ) ? end + 1 : end;
+        }
+    }
+    HT_CHECK_EQ( pg.np, ( EventManager::N_EVENTS + EventManager::HAVE_PAGE - 1 ) / EventManager::HAVE_PAGE );
+    HT_CHECK_EQ( entries, EventManager::N_EVENTS );
+    HT_CHECK( havePage( pg.np ).list == "" );                  // past the end
+}
+
+HT_TEST(backend_syncs_a_full_table) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+
+    Backend cloud;
+    for ( int i = 0; i < EventManager::N_EVENTS; i++ ) cloud.catalogue[1000 + i] = 1;
+    HT_CHECK_EQ( cloud.sync(), EventManager::N_EVENTS );
+    HT_CHECK( variable( "s_EvDigest" ) == cloud.digest() );
+
+    // Revisions spread over every page go out alone
+    cloud.catalogue[1000] = 2;
+    cloud.catalogue[1000 + EventManager::N_EVENTS / 2] = 2;
+    cloud.catalogue[1000 + EventManager::N_EVENTS - 1] = 2;
+    HT_CHECK_EQ( cloud.sync(), 3 );
+    HT_CHECK_EQ( cloud.sync(), 0 );
+}
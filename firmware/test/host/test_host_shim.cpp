@@ -0,0 +1,109 @@
+/**
+ * @file    test_host_shim.cpp
+ * @brief   Sanity checks for the host Particle shim and virtual clock.
+ */
+
+#include "HostTest.h"
+#include "BuzzerManager.h"
+
+HT_TEST(virtual_clock_drives_millis_and_time) {
+    HostSim::reset();
+    HT_CHECK_EQ( millis(), 0UL );
+    HT_CHECK( !Time.isValid() );
+
+    HostSim::setTime( 1750000000, false );
+    HT_CHECK( Time.isValid() );
+    HT_CHECK_EQ( (long)Time.now(), 1750000000L );
+
+    HostSim::advanceMs( 2500 );
+    HT_CHECK_EQ( millis(), 2500UL );
+    HT_CHECK_EQ( (long)Time.now(), 1750000002L );
+    HT_CHECK( Time.format( 1750000000, TIME_FORMAT_ISO8601_FULL ) == "2025-06-15T15:06:40Z" );
+}
+
+HT_TEST(software_timer_fires_on_schedule) {
+    HostSim::reset();
+    int fired = 0;
+    Timer t( 100, [&fired]() { fired++; } );
+    t.start();
+    HostSim::advanceMs( 99 );
+    HT_CHECK_EQ( fired, 0 );
+    HostSim::advanceMs( 1 );
+    HT_CHECK_EQ( fired, 1 );
+    HostSim::advanceMs( 1000 );
+    HT_CHECK_EQ( fired, 11 );
+    t.stop();
+}
+
+HT_TEST(eeprom_put_get_and_write_counters) {
+    HostSim::reset();
+    HostSim::resetEepromStats();
+    struct { uint32_t a; uint16_t b; } in = { 0x11223344, 0x5566 }, out = {};
+    EEPROM.put( 100, in );
+    EEPROM.get( 100, out );
+    HT_CHECK_EQ( out.a, in.a );
+    HT_CHECK_EQ( out.b, in.b );
+    EEPROM.put( 100, in );   // identical rewrite: bytes written, none changed
+    HostSim::EepromStats st = HostSim::eepromStats();
+    HT_CHECK_EQ( st.putCalls, 2u );
+    HT_CHECK_EQ( st.bytesWritten, (uint32_t)( 2 * sizeof(in) ) );
+    HT_CHECK_EQ( st.bytesChanged, (uint32_t)sizeof(in) );
+}
+
+HT_TEST(json_parse_and_write_round_trip) {
+    JSONValue root = JSONValue::parseCopy( "{\"IDV\":\"12.3\",\"SJR\":[4,5],\"DEL\":false,\"LAT\":40.5}" );
+    HT_CHECK( root.isObject() );
+    JSONObjectIterator it( root );
+    int n = 0;
+    while ( it.next() ) {
+        String k = String( it.name() );
+        if ( k == "IDV" ) HT_CHECK( String( it.value().toString() ) == "12.3" );
+        if ( k == "SJR" ) { HT_CHECK( it.value().isArray() ); JSONArrayIterator a( it.value() ); int s = 0; while ( a.next() ) s += a.value().toInt(); HT_CHECK_EQ( s, 9 ); }
+        if ( k == "DEL" ) HT_CHECK( !it.value().toBool() );
+        if ( k == "LAT" ) HT_CHECK( it.value().toDouble() == 40.5 );
+        n++;
+    }
+    HT_CHECK_EQ( n, 4 );
+    HT_CHECK( !JSONValue::parseCopy( "{\"a\":" ).isValid() );
+
+    char buf[64] = {0};
+    JSONBufferWriter w( buf, sizeof(buf) - 1 );
+    w.beginObject();
+    w.name("A").value( 1 );
+    w.name("B").beginArray(); w.value( "x" ); w.nullValue(); w.endArray();
+    w.name("C").value( 1.25, 1 );
+    w.endObject();
+    HT_CHECK( String( buf ) == "{\"A\":1,\"B\":[\"x\",null],\"C\":1.2}" );
+}
+
+HT_TEST(cloud_registry_routes_subscriptions_and_functions) {
+    HostSim::reset();
+    static int got = 0;
+    got = 0;
+    Particle.subscribe( "FE-US", []( const char *, const char * ) { got++; } );
+    HT_CHECK_EQ( HostSim::deliver( "FE-US", "{}" ), 1 );
+    HT_CHECK_EQ( HostSim::deliver( "FE-UT", "{}" ), 0 );
+    HT_CHECK_EQ( got, 1 );
+
+    Particle.function( "echo", []( String s ) -> int { return s.toInt(); } );
+    int rc = 0;
+    HT_CHECK( HostSim::callFunction( "echo", "42", rc ) );
+    HT_CHECK_EQ( rc, 42 );
+}
+
+// Host port of the abandoned AUnit test in test/test_buzzer.cpp.
+HT_TEST(buzzer_pattern_runs_to_completion) {
+    HostSim::reset();
+    BuzzerManager b;
+    b.begin();
+    b.playPattern( "123 " );
+    unsigned long start = millis();
+    while ( !b.isFinished() && millis() - start < 5000 ) {
+        b.update();
+        HostSim::advanceMs( 10 );
+    }
+    HT_CHECK( b.isFinished() );
+    // 120 + 240 + 360 + 60 ms of symbols, plus one update tick per symbol
+    HT_CHECK( millis() - start >= 780 );
+    HT_CHECK( millis() - start <  900 );
+}
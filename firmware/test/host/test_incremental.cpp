@@ -0,0 +1,122 @@
+/**
+ * @file    test_incremental.cpp
+ * @brief   Per-slot dirty tracking: each kind of change recomputes only the
+ *          slots it invalidates, and the result matches a full reprocess.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+// 2025-06-15 12:00:00 UTC (a Sunday)
+static const time_t T0 = 1749988800;
+
+static void inject( int id, const char *bmk, const char *emk ) {
+    HostSim::deliver( "FE-US", HostTest::eventJSON( id, 1, "FE-US", bmk, emk ).c_str() );
+}
+
+// Four of each mark kind: sun (date-only / SR), local (L), absolute (Z)
+static void loadMixedEvents() {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    for ( int i = 0; i < 4; i++ ) {
+        String d = String::format( "2025-06-%02d", 17 + i );
+        inject( 10 + i, d.c_str(),                   ( d + "T23:00Z" ).c_str() );
+        inject( 20 + i, ( d + "T08:00L" ).c_str(),   ( d + "T20:00L" ).c_str() );
+        inject( 30 + i, ( d + "T12:00Z" ).c_str(),   ( d + "T13:00Z" ).c_str() );
+    }
+    HT_CHECK_EQ( evMgr.getNEvents(), 12 );
+}
+
+struct Work { uint32_t marks, applies; };
+static Work snap() { return { evMgr.markResolutions(), evMgr.applyChecks() }; }
+static Work since( Work w ) { return { evMgr.markResolutions() - w.marks, evMgr.applyChecks() - w.applies }; }
+
+HT_TEST(receive_touches_one_slot) {
+    loadMixedEvents();
+    Work w = snap();
+    inject( 40, "2025-06-25T10:00Z", "2025-06-25T11:00Z" );
+    Work d = since( w );
+    HT_CHECK_EQ( d.marks,   1u );
+    HT_CHECK_EQ( d.applies, 1u );
+    HT_CHECK_EQ( evMgr.getNEvents(), 13 );
+}
+
+HT_TEST(applicability_change_skips_mark_resolution) {
+    loadMixedEvents();
+    Work w = snap();
+    HostTest::configureUnit( "{\"FLG\":\"IN\"}" );
+    Work d = since( w );
+    HT_CHECK_EQ( d.marks,   0u );
+    HT_CHECK_EQ( d.applies, 12u );
+}
+
+HT_TEST(site_change_resolves_sun_and_local_slots_only) {
+    loadMixedEvents();
+    Work w = snap();
+    HostTest::configureUnit( "{\"LAT\":41.0}" );
+    Work d = since( w );
+    HT_CHECK_EQ( d.marks,   8u );    // sun + local; absolute Z slots untouched
+    HT_CHECK_EQ( d.applies, 0u );
+}
+
+HT_TEST(dst_toggle_resolves_local_slots_only) {
+    loadMixedEvents();
+    Work w = snap();
+    HostTest::configureUnit( "{\"DST\":false}" );
+    Work d = since( w );
+    HT_CHECK_EQ( d.marks,   4u );
+    HT_CHECK_EQ( d.applies, 0u );
+}
+
+HT_TEST(unrelated_config_does_no_slot_work) {
+    loadMixedEvents();
+    Work w = snap();
+    HostTest::configureUnit( "{\"FPR\":3,\"ZIP\":\"43215\"}" );
+    Work d = since( w );
+    HT_CHECK_EQ( d.marks,   0u );
+    HT_CHECK_EQ( d.applies, 0u );
+}
+
+HT_TEST(clock_jump_resolves_marks_only) {
+    loadMixedEvents();
+    Work w = snap();
+    HostSim::setTime( T0 + 30 );    // time_changed → reprocessEvents()
+    Work d = since( w );
+    HT_CHECK_EQ( d.marks,   12u );
+    HT_CHECK_EQ( d.applies, 0u );   // applicability is cached per slot
+}
+
+HT_TEST(boot_checks_applicability_once) {
+    loadMixedEvents();
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.applyChecks(), 12u );
+    HostSim::setTime( T0 + 90 );
+    evMgr.reprocessEvents();
+    HT_CHECK_EQ( evMgr.applyChecks(), 12u );
+}
+
+HT_TEST(timer_fire_only_reschedules) {
+    loadMixedEvents();
+    inject( 50, "2025-06-15T13:00Z", "2025-06-15T14:00Z" );
+    Work w = snap();
+    HostTest::runLoop( 3600UL * 1000 + 1000, 1000 );
+    HT_CHECK( evMgr.orderedStation() == FLAG_HALF );
+    Work d = since( w );
+    HT_CHECK_EQ( d.marks,   0u );
+    HT_CHECK_EQ( d.applies, 0u );
+}
+
+HT_TEST(incremental_matches_full_reprocess) {
+    loadMixedEvents();
+    HostTest::configureUnit( "{\"LNG\":-84.5,\"STD\":-6}" );
+    HostTest::configureUnit( "{\"DST\":false}" );
+    inject( 60, "2025-06-16", "2025-06-16T23:30Z" );
+    time_t      next = evMgr.nextFlagChange();
+    FlagStation sta  = evMgr.nextFlagStation();
+    int         n    = evMgr.getNEvents();
+
+    evMgr.reprocessEvents( EVD_ALL );
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)next );
+    HT_CHECK( evMgr.nextFlagStation() == sta );
+    HT_CHECK_EQ( evMgr.getNEvents(), n );
+}
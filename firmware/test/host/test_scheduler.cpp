@@ -0,0 +1,89 @@
+/**
+ * @file    test_scheduler.cpp
+ * @brief   End-to-end scheduling through the real setup()/loop() on the host.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "HalyardManager.h"
+#include "Subscriptions.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern HalyardManager halMgr1;
+
+// 2025-06-15 12:00:00 UTC (a Sunday)
+static const time_t T0 = 1749988800;
+
+HT_TEST(boot_registers_cloud_surface) {
+    HostTest::bootFirmware( T0 );
+    String v;
+    HT_CHECK( HostSim::readVariable( "s_EventLIST", v ) );
+    HT_CHECK( HostSim::readVariable( "Status", v ) );
+    HostTest::configureUnit();
+    // FE-US / FE-OH routed; the boot-time FE-XX stays subscribed but unrouted
+    std::vector<std::string> subs = HostSim::subscriptions();
+    HT_CHECK_EQ( subscriptions.routeCount(), 2 );
+    HT_CHECK( std::find( subs.begin(), subs.end(), "FE-OH" ) != subs.end() );
+    HT_CHECK( evMgr.orderedStation() == FLAG_FULL );
+}
+
+// A full table of the longest IDVs the firmware prints, read page by page
+HT_TEST(event_list_pages_fit_publish_limit) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    for ( int k = 0; k < EventManager::N_EVENTS; k++ ) {
+        HT_CHECK_EQ( evMgr.receiveEvent( HostTest::eventJSON( 2147483647 - k, 2147483647 ) ), (int)EMrc::SUCCESS );
+    }
+
+    int pages = 0, slots = 0;
+    for ( int p = 0; p == 0 || p < pages; p++ ) {
+        int rc = -1;
+        HT_CHECK( HostSim::callFunction( "s_EvLPage", String::format( "%d", p ), rc ) );
+        HT_CHECK_EQ( rc, p );
+        String v;
+        HT_CHECK( HostSim::readVariable( "s_EventLIST", v ) );
+        HT_CHECK( v.length() <= 622 );
+        int page = -1;
+        HT_CHECK_EQ( sscanf( v.c_str(), "{\"P\":%d,\"NP\":%d", &page, &pages ), 2 );
+        HT_CHECK_EQ( page, p );
+        for ( const char *q = strstr( v.c_str(), ".2147483647\"" ); q; q = strstr( q + 1, ".2147483647\"" ) ) slots++;
+    }
+    HT_CHECK_EQ( pages, ( EventManager::N_EVENTS + EventManager::EL_PAGE - 1 ) / EventManager::EL_PAGE );
+    HT_CHECK_EQ( slots, EventManager::N_EVENTS );
+}
+
+HT_TEST(event_lowers_and_raises_on_schedule) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+
+    // Half-staff from 13:00Z to 15:00Z today
+    HT_CHECK_EQ( HostSim::deliver( "FE-US",
+        "{\"IDV\":\"101.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-06-15T13:00Z\",\"EMK\":\"2025-06-15T15:00Z\"}" ), 1 );
+    HT_CHECK_EQ( evMgr.getNEvents(), 1 );
+    HT_CHECK( evMgr.orderedStation() == FLAG_FULL );
+    HT_CHECK( evMgr.nextFlagStation() == FLAG_HALF );
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)( T0 + 3600 ) );
+
+    HostTest::runLoop( 3600UL * 1000 + 1000, 1000 );
+    HT_CHECK( evMgr.orderedStation() == FLAG_HALF );
+    HT_CHECK( halMgr1.getOrderedStation() == FLAG_HALF );
+    HT_CHECK_EQ( evMgr.firstActiveEvent(), 101 );
+
+    HostTest::runLoop( 2UL * 3600 * 1000, 1000 );
+    HT_CHECK( evMgr.orderedStation() == FLAG_FULL );
+    HT_CHECK_EQ( evMgr.firstActiveEvent(), -1 );
+}
+
+HT_TEST(events_survive_reboot) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    HostSim::deliver( "FE-OH",
+        "{\"IDV\":\"7.2\",\"JUR\":\"FE-OH\",\"FLG\":\"OH\",\"BMK\":\"2025-06-16\",\"EMK\":\"2025-06-16T22:00Z\"}" );
+    HT_CHECK_EQ( evMgr.getNEvents(), 1 );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 1 );
+    HT_CHECK( evMgr.nextFlagStation() == FLAG_HALF );
+}
@@ -0,0 +1,105 @@
+/**
+ * @file    test_status_log.cpp
+ * @brief   StatusData log: unchanged writes are skipped, the newest valid
+ *          record wins after wrap or a torn write, and v4 images migrate.
+ */
+
+#include "HostTest.h"
+#include "EEPROMManager.h"
+#include "EEPROMShadow.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static int slotAddr( int i ) { return EEPROM_ADDR_STATUS_LOG + i * (int)sizeof(StatusRec); }
+
+HT_TEST(unchanged_status_is_not_written) {
+    HostTest::bootFirmware( T0 );
+    saveOSTA( FLAG_HALF );
+    HostSim::resetEepromStats();
+    HostSim::advanceMs( 5000 );                 // a later TIME alone is not a change
+
+    saveOSTA( FLAG_HALF );
+    saveOSTA( FLAG_HALF );
+    HT_CHECK_EQ( HostSim::eepromStats().putCalls, 0u );
+    HT_CHECK_EQ( HostSim::eepromStats().getCalls, 0u );
+
+    saveOSTA( FLAG_FULL );
+    HT_CHECK_EQ( HostSim::eepromStats().putCalls, 1u );
+    HT_CHECK_EQ( HostSim::eepromStats().bytesWritten, (uint32_t)sizeof(StatusRec) );
+}
+
+HT_TEST(newest_record_survives_wrap_and_reboot) {
+    HostTest::bootFirmware( T0 );
+    StatusData st;
+    readStatus( st );
+    uint32_t boots = st.reboot_count;
+
+    for ( int i = 1; i <= 3 * STATUS_LOG_SLOTS + 5; i++ ) {
+        st.NEXT = (uint32_t)i;
+        writeStatus( st );
+    }
+    // Every slot holds a record, none older than one lap
+    for ( int i = 0; i < STATUS_LOG_SLOTS; i++ ) {
+        StatusRec r;
+        EEPROM.get( slotAddr( i ), r );
+        HT_CHECK_EQ( r.magic, (uint8_t)STATUS_REC_MAGIC );
+        HT_CHECK( r.NEXT > (uint32_t)( 2 * STATUS_LOG_SLOTS + 5 ) );
+    }
+
+    HostTest::bootFirmware( T0 + 60, true );
+    readStatus( st );
+    HT_CHECK_EQ( st.NEXT, (uint32_t)( 3 * STATUS_LOG_SLOTS + 5 ) );
+    HT_CHECK_EQ( st.reboot_count, boots + 1 );
+}
+
+HT_TEST(torn_record_falls_back_to_previous) {
+    HostTest::bootFirmware( T0 );
+    StatusData st;
+    readStatus( st );
+    st.NEXT = 111;
+    writeStatus( st );
+    st.NEXT = 222;
+    writeStatus( st );
+
+    // Corrupt the newest record (the one holding NEXT 222)
+    int newest = -1;
+    for ( int i = 0; i < STATUS_LOG_SLOTS; i++ ) {
+        StatusRec r;
+        EEPROM.get( slotAddr( i ), r );
+        if ( r.magic == STATUS_REC_MAGIC && r.NEXT == 222 ) newest = i;
+    }
+    HT_CHECK( newest >= 0 );
+    EEPROM.write( slotAddr( newest ) + offsetof( StatusRec, NEXT ), 0x5A );
+
+    reloadStatusLog();
+    readStatus( st );
+    HT_CHECK_EQ( st.NEXT, 111u );
+}
+
+HT_TEST(v4_status_block_migrates) {
+    HostTest::bootFirmware( T0 );
+    eepromShadow.commit();
+    EEPROMHeader hdr;
+    EEPROM.get( EEPROM_ADDR_HEADER, hdr );
+    hdr.version = 4;
+    EEPROM.put( EEPROM_ADDR_HEADER, hdr );
+    StatusData v4 = {};
+    v4.OSTA = FLAG_HALF;
+    v4.NSTA = FLAG_FULL;
+    v4.reboot_count = 41;
+    v4.NEXT = 12345;
+    strcpy( v4.AEID, "77.1" );
+    EEPROM.put( EEPROM_ADDR_STATUS, v4 );
+    for ( int i = 0; i < STATUS_LOG_SLOTS; i++ ) EEPROM.write( slotAddr( i ), 0 );
+
+    HostTest::bootFirmware( T0 + 60, true );
+    EEPROM.get( EEPROM_ADDR_HEADER, hdr );
+    HT_CHECK_EQ( hdr.version, (uint8_t)EEPROM_VERSION );
+    StatusData st;
+    readStatus( st );
+    HT_CHECK_EQ( st.reboot_count, 42u );
+    HT_CHECK_EQ( st.NEXT, 12345u );
+    HT_CHECK( st.NSTA == FLAG_FULL );
+    HT_CHECK( strcmp( st.AEID, "77.1" ) == 0 );
+}
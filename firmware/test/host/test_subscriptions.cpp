@@ -0,0 +1,99 @@
+/**
+ * @file    test_subscriptions.cpp
+ * @brief   Subscription registry: topic changes subscribe only what is new,
+ *          routing drops retired topics, and extra SUB jurisdiction topics.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "Subscriptions.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+HT_TEST(topic_changes_subscribe_only_new_topics) {
+    HostTest::bootFirmware( T0 );                           // default FE-US / FE-XX
+    size_t unsub0 = HostSim::unsubscribeCalls();
+    size_t sub0   = HostSim::subscribeCalls();
+
+    // A moved state topic is added alongside; the old one is no longer routed
+    HostTest::configureUnit( "{\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\"}" );
+    HT_CHECK_EQ( HostSim::subscribeCalls(), sub0 + 1 );
+    HT_CHECK_EQ( HostSim::unsubscribeCalls(), unsub0 );
+    int n0 = evMgr.getNEvents();
+    HostSim::deliver( "FE-XX", HostTest::eventJSON( 7, 1, "FE-XX" ).c_str() );
+    HT_CHECK_EQ( evMgr.getNEvents(), n0 );
+    HostSim::deliver( "FE-OH", HostTest::eventJSON( 8, 1, "FE-OH" ).c_str() );
+    HT_CHECK_EQ( evMgr.getNEvents(), n0 + 1 );
+
+    HostTest::configureUnit( "{\"SUB\":[\"FE-OH-X\"]}" );   // covered by FE-OH
+    HT_CHECK_EQ( HostSim::subscribeCalls(), sub0 + 1 );
+    HostTest::configureUnit( "{\"SUB\":[\"CUSTOM\"]}" );
+    HT_CHECK_EQ( HostSim::subscribeCalls(), sub0 + 2 );
+    HostTest::configureUnit( "{\"LAT\":41.0}" );   // not a topic field
+    HT_CHECK_EQ( HostSim::subscribeCalls(), sub0 + 2 );
+    HT_CHECK_EQ( HostSim::unsubscribeCalls(), unsub0 );
+
+    // A fifth topic does not fit: one reset to exactly the wanted set
+    HostTest::configureUnit( "{\"STA\":\"FE-KY\"}" );
+    HT_CHECK_EQ( HostSim::unsubscribeCalls(), unsub0 + 1 );
+    HT_CHECK_EQ( subscriptions.resets(), 1u );
+    HT_CHECK_EQ( subscriptions.activeCount(), 3 );
+    HT_CHECK_EQ( (int)HostSim::subscriptions().size(), 3 );
+}
+
+HT_TEST(extra_topic_routes_and_applies) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit( "{\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\",\"SUB\":[\"FE-OH-X\",\"TRIBAL\"]}" );
+    int n0 = evMgr.getNEvents();
+    HT_CHECK_EQ( HostSim::deliver( "TRIBAL-7", HostTest::eventJSON( 21, 1, "TRIBAL-7" ).c_str() ), 1 );
+    HT_CHECK_EQ( evMgr.getNEvents(), n0 + 1 );
+
+    // Persisted in ConfigExt and reported by s_ShowConfig / Config
+    HostTest::bootFirmware( T0 + 60, true );
+    String cfg;
+    HT_CHECK( HostSim::readVariable( "s_ShowConfig", cfg ) );
+    HT_CHECK( cfg.indexOf( "\"SUB\":[\"FE-OH-X\",\"TRIBAL\"]" ) >= 0 );
+    HT_CHECK( HostSim::readVariable( "Config", cfg ) );
+    HT_CHECK( cfg.indexOf( "\"SUB\":[\"FE-OH-X\",\"TRIBAL\"]" ) >= 0 );
+    HT_CHECK_EQ( evMgr.getNEvents(), n0 + 1 );
+
+    HostTest::configureUnit( "{\"SUB\":[]}" );
+    HT_CHECK( HostSim::readVariable( "s_ShowConfig", cfg ) );
+    HT_CHECK( cfg.indexOf( "\"SUB\":[]" ) >= 0 );
+    HT_CHECK_EQ( evMgr.getNEvents(), n0 );                  // TRIBAL event no longer applies
+}
+
+static int s_calls[2];
+static void countA( const char *, const char *, void *ctx ) { s_calls[(intptr_t)ctx]++; }
+
+HT_TEST(owners_share_topics_and_are_called_once) {
+    HostSim::reset();
+    subscriptions.clear();
+    s_calls[0] = s_calls[1] = 0;
+
+    const char *a[] = { "FE-US", "FE-US-X", "FE-US" };    // overlapping and repeated
+    const char *b[] = { "FE-US", "WX" };
+    HT_CHECK( subscriptions.setTopics( countA, (void *)0, a, 3 ) );
+    HT_CHECK( subscriptions.setTopics( countA, (void *)1, b, 2 ) );
+    HT_CHECK_EQ( subscriptions.activeCount(), 2 );
+    HT_CHECK_EQ( (int)HostSim::subscribeCalls(), 2 );
+
+    HT_CHECK_EQ( HostSim::deliver( "FE-US-X", "{}" ), 1 );
+    HT_CHECK_EQ( s_calls[0], 1 );
+    HT_CHECK_EQ( s_calls[1], 1 );
+    HostSim::deliver( "WX", "{}" );
+    HT_CHECK_EQ( s_calls[0], 1 );
+    HT_CHECK_EQ( s_calls[1], 2 );
+
+    // A new topic that prefixes an active one would double-deliver: reset
+    const char *c[] = { "W" };
+    subscriptions.setTopics( countA, (void *)1, c, 1 );
+    HT_CHECK_EQ( subscriptions.resets(), 1u );
+    HT_CHECK_EQ( subscriptions.activeCount(), 2 );
+    HT_CHECK_EQ( HostSim::deliver( "WX", "{}" ), 1 );
+    HT_CHECK_EQ( s_calls[1], 3 );
+
+    const char *tooLong[] = { "ABCDEFGHIJKLMNOPQRSTUVWXYZ" };
+    HT_CHECK( !subscriptions.setTopics( countA, (void *)1, tooLong, 1 ) );
+}
@@ -0,0 +1,62 @@
+/**
+ * @file    test_sun_cache.cpp
+ * @brief   Day-of-year sunrise/sunset cache in EventManager.
+ *
+ * The annual sun table (test_sun_table.cpp) answers lookups ahead of the
+ * cache, so each case here switches it off after boot.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+// 2025-03-01 12:00:00 UTC
+static const time_t T0 = 1740830400;
+
+static void inject( int id, const char *bmk, const char *emk ) {
+    HostSim::deliver( "FE-US", HostTest::eventJSON( id, 1, "FE-US", bmk, emk ).c_str() );
+}
+
+HT_TEST(repeated_days_hit_the_cache) {
+    HostTest::bootFirmware( T0 );
+    evMgr.setSunTableEnabled( false );
+    HostTest::configureUnit( "{\"LAT\":38.9,\"LNG\":-77.0,\"FED\":\"FE-US\",\"STA\":\"FE-VA\"}" );
+
+    // Five events on the same two days: sunrise one day, sunset the next
+    for ( int id = 1; id <= 5; id++ ) inject( id, "2025-03-10", "2025-03-11T22:00Z" );
+    HT_CHECK_EQ( evMgr.getNEvents(), 5 );
+
+    uint32_t hits0 = evMgr.sunCacheHits(), miss0 = evMgr.sunCacheMisses();
+    evMgr.reprocessEvents();
+    HT_CHECK_EQ( evMgr.sunCacheMisses(), miss0 );          // everything already cached
+    HT_CHECK( evMgr.sunCacheHits() >= hits0 + 5 );
+}
+
+HT_TEST(cached_times_match_fresh_computation) {
+    HostTest::bootFirmware( T0 );
+    evMgr.setSunTableEnabled( false );
+    HostTest::configureUnit( "{\"LAT\":38.9,\"LNG\":-77.0,\"FED\":\"FE-US\",\"STA\":\"FE-VA\"}" );
+    inject( 1, "2025-03-10", "2025-03-11T22:00Z" );
+    time_t cached = evMgr.nextFlagChange();
+
+    // A fresh EventManager on the same EEPROM starts with an empty cache
+    HostTest::bootFirmware( T0, true );
+    evMgr.setSunTableEnabled( false );
+    evMgr.reprocessEvents();
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)cached );
+}
+
+HT_TEST(lat_lng_change_invalidates) {
+    HostTest::bootFirmware( T0 );
+    evMgr.setSunTableEnabled( false );
+    HostTest::configureUnit( "{\"LAT\":38.9,\"LNG\":-77.0,\"FED\":\"FE-US\",\"STA\":\"FE-VA\"}" );
+    inject( 1, "2025-03-10", "2025-03-11T22:00Z" );
+    time_t east = evMgr.nextFlagChange();
+
+    uint32_t miss0 = evMgr.sunCacheMisses();
+    HostTest::configureUnit( "{\"STD\":-5}" );   // no site change: still cached
+    HT_CHECK_EQ( evMgr.sunCacheMisses(), miss0 );
+
+    HostTest::configureUnit( "{\"LNG\":-90.0}" );   // site moved west: recompute
+    HT_CHECK( evMgr.sunCacheMisses() > miss0 );
+    HT_CHECK( evMgr.nextFlagChange() > east );             // later sunrise in UTC
+}
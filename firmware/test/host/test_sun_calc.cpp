@@ -0,0 +1,47 @@
+/**
+ * @file    test_sun_calc.cpp
+ * @brief   SunCalc::fast() against the Gen2 kernel over ±66° latitude and
+ *          every day of the year, holding it to FAST_MAX_ERR_S.
+ */
+
+#include "HostTest.h"
+#include "SunCalc.h"
+
+#include <cstdlib>
+
+static const float LNGS[] = { -83.0f, -122.4f, 0.0f, 151.2f };
+
+HT_TEST(fast_within_documented_error) {
+    int worst = 0, compared = 0;
+    for ( int q = -264; q <= 264; q++ ) {                 // every 0.25°
+        float lat = q * 0.25f;
+        for ( float lng : LNGS ) {
+            SunCalc::Site site = SunCalc::site( lat, lng );
+            for ( int doy = 0; doy <= 365; doy++ ) {
+                for ( int rs = 0; rs < 2; rs++ ) {
+                    int a = SunCalc::exact( lat, lng, doy, rs );
+                    int b = SunCalc::fast( site, doy, rs );
+                    HT_CHECK_EQ( a == SunCalc::NONE, b == SunCalc::NONE );
+                    if ( a == SunCalc::NONE || b == SunCalc::NONE ) continue;
+                    worst = std::max( worst, abs( a - b ) );
+                    compared++;
+                }
+            }
+        }
+    }
+    HT_CHECK( compared > 700000 );
+    HT_CHECK( worst <= SunCalc::FAST_MAX_ERR_S );
+}
+
+HT_TEST(polar_days_match) {
+    // 68° N: midnight sun at the June solstice, polar night at the December
+    // one, an ordinary day at the equinox
+    SunCalc::Site north = SunCalc::site( 68.0f, 25.7f );
+    for ( int doy : { 171, 354 } ) {
+        for ( int rs = 0; rs < 2; rs++ ) {
+            HT_CHECK_EQ( SunCalc::exact( 68.0f, 25.7f, doy, rs ), SunCalc::NONE );
+            HT_CHECK_EQ( SunCalc::fast( north, doy, rs ), SunCalc::NONE );
+        }
+    }
+    HT_CHECK( SunCalc::fast( north, 79, 1 ) != SunCalc::NONE );
+}
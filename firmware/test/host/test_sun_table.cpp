@@ -0,0 +1,88 @@
+/**
+ * @file    test_sun_table.cpp
+ * @brief   Per-site annual sun table: exactness against the runtime solve,
+ *          persistence across reboot, and rebuild on LAT/LNG change.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+// 2025-01-01 12:00:00 UTC
+static const time_t T0 = 1735732800;
+
+static void inject( int id, const char *bmk, const char *emk ) {
+    HostSim::deliver( "FE-US", HostTest::eventJSON( id, 1, "FE-US", bmk, emk ).c_str() );
+}
+
+// Next transition with the table on and off must agree to the second.
+static void checkSite( const char *cfg ) {
+    static const char *days[] = { "2025-01-20", "2025-03-20", "2025-06-21", "2025-09-22", "2025-12-21" };
+
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit( cfg );
+    HT_CHECK( evMgr.sunTableActive() );
+
+    for ( const char *d : days ) {
+        String emk = String( d ) + "T23:00Z";
+        inject( 1, d, emk.c_str() );
+
+        evMgr.setSunTableEnabled( false );
+        evMgr.reprocessEvents();
+        time_t solved = evMgr.nextFlagChange();
+
+        evMgr.setSunTableEnabled( true );
+        uint32_t hits0 = evMgr.sunTableHits(), miss0 = evMgr.sunCacheMisses();
+        evMgr.reprocessEvents();
+        HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)solved );
+        HT_CHECK( evMgr.sunTableHits() > hits0 );
+        HT_CHECK_EQ( evMgr.sunCacheMisses(), miss0 );
+    }
+}
+
+HT_TEST(table_matches_runtime_solve) {
+    checkSite( "{\"LAT\":38.9,\"LNG\":-77.0,\"FED\":\"FE-US\",\"STA\":\"FE-VA\"}" );
+    checkSite( "{\"LAT\":61.2,\"LNG\":-149.9,\"FED\":\"FE-US\",\"STA\":\"FE-AK\"}" );
+    checkSite( "{\"LAT\":21.3,\"LNG\":-157.8,\"FED\":\"FE-US\",\"STA\":\"FE-HI\"}" );
+    checkSite( "{\"LAT\":13.4,\"LNG\":144.8,\"FED\":\"FE-US\",\"STA\":\"FE-GU\"}" );
+}
+
+HT_TEST(polar_days_have_no_sun_event) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit( "{\"LAT\":71.3,\"LNG\":-156.8,\"FED\":\"FE-US\",\"STA\":\"FE-AK\"}" );
+    HT_CHECK( evMgr.sunTableActive() );
+
+    SunTable t;
+    readSunTable( t );
+    HT_CHECK_EQ( t.sec[1][0],   SUNTAB_NONE );   // Utqiagvik: polar night on 1 Jan
+    HT_CHECK_EQ( t.sec[1][171], SUNTAB_NONE );   //            midnight sun at the solstice
+    HT_CHECK( t.sec[1][80] != SUNTAB_NONE );     //            ordinary sunrise at the equinox
+}
+
+HT_TEST(table_persists_across_reboot) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit( "{\"LAT\":38.9,\"LNG\":-77.0,\"FED\":\"FE-US\",\"STA\":\"FE-VA\"}" );
+    inject( 1, "2025-01-20", "2025-01-20T23:00Z" );
+    time_t before = evMgr.nextFlagChange();
+
+    HostTest::bootFirmware( T0, true );
+    HT_CHECK( evMgr.sunTableActive() );
+    HT_CHECK( HostSim::eepromStats().bytesWritten < sizeof(SunTable) );   // loaded, not rebuilt
+    HT_CHECK_EQ( evMgr.sunCacheMisses(), 0u );
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)before );
+}
+
+HT_TEST(site_change_rebuilds_table) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit( "{\"LAT\":38.9,\"LNG\":-77.0,\"FED\":\"FE-US\",\"STA\":\"FE-VA\"}" );
+
+    HostSim::resetEepromStats();
+    HostTest::configureUnit( "{\"STD\":-5}" );
+    HT_CHECK( HostSim::eepromStats().bytesWritten < sizeof(SunTable) );
+
+    HostTest::configureUnit( "{\"LNG\":-90.0}" );
+    SunTable t;
+    readSunTable( t );
+    HT_CHECK( t.LNG == -90.0f );
+    HT_CHECK( t.LAT == 38.9f );
+    HT_CHECK( evMgr.sunTableActive() );
+}
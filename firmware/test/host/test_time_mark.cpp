@@ -0,0 +1,183 @@
+/**
+ * @file    test_time_mark.cpp
+ * @brief   TimeMark compile/format round trip, packed EEPROM form, and the
+ *          heap-free event record.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "TimeMark.h"
+#include "EEPROMShadow.h"
+
+#include <cstring>
+#include <ctime>
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static std::string roundTrip( const char *s ) {
+    char buf[TimeMarks::MAX_LEN + 1];
+    TimeMarks::format( TimeMarks::compile( s ), buf, sizeof(buf) );
+    return buf;
+}
+
+HT_TEST(canonical_marks_round_trip) {
+    const char *marks[] = { "TBD", "2025-06-16", "2025-06-16TSR", "2025-06-16TSS",
+                            "2025-06-16T08:05", "2025-06-16T23:59Z", "2025-12-31T00:00L" };
+    for ( const char *m : marks ) HT_CHECK( roundTrip( m ) == m );
+}
+
+HT_TEST(kinds_and_fields) {
+    TimeMark m = TimeMarks::compile( "2025-03-09T07:30L" );
+    HT_CHECK_EQ( m.kind, TMK_L );
+    HT_CHECK_EQ( m.year, 2025 );
+    HT_CHECK_EQ( m.month, 3 );
+    HT_CHECK_EQ( m.day, 9 );
+    HT_CHECK_EQ( m.minutes, 7 * 60 + 30 );
+    HT_CHECK( TimeMarks::usesLocal( m ) );
+    HT_CHECK( !TimeMarks::usesSun( m ) );
+    HT_CHECK( TimeMarks::usesSun( TimeMarks::compile( "2025-03-09" ) ) );
+    HT_CHECK( !TimeMarks::usesSun( TimeMarks::compile( "2025-03-09T07:30Z" ) ) );
+}
+
+HT_TEST(bad_marks_carry_gen2_error_codes) {
+    HT_CHECK_EQ( TimeMarks::compile( "2025-6-1" ).err,          (int)EMrc::PARSE_ERROR );
+    HT_CHECK_EQ( TimeMarks::compile( "2025-06-16TXX" ).err,     (int)EMrc::NOT_SRSS );
+    HT_CHECK_EQ( TimeMarks::compile( "2025-06-16T08:00Q" ).err, (int)EMrc::NOT_ZL );
+    HT_CHECK_EQ( TimeMarks::compile( "2025-06-16T08" ).kind,    TMK_BAD );
+    HT_CHECK_EQ( TimeMarks::compile( "2025-06-16T8" ).kind,     TMK_OTHER );
+}
+
+HT_TEST(epoch_day_matches_mktime) {
+    // Every day 1970..2100, plus the out-of-range month / day values atoi()
+    // can produce, which mktime() normalises by carrying
+    for ( int y = 1970; y <= 2100; y++ ) {
+        for ( int mon = 0; mon <= 13; mon++ ) {
+            for ( int d = 0; d <= 32; d++ ) {
+                TimeMark m = {};
+                m.year = (uint16_t)y; m.month = (uint8_t)mon; m.day = (uint8_t)d;
+                struct tm t = {};
+                t.tm_year = y - 1900; t.tm_mon = mon - 1; t.tm_mday = d;
+                time_t ref = mktime( &t );
+                if ( ref < 0 ) continue;                    // before 1970-01-01
+
+                HT_CHECK_EQ( (time_t)TimeMarks::epochDay( m ) * 86400, ref );
+            }
+        }
+    }
+}
+
+static const char *MARK_EVENTS[] = {
+    "{\"IDV\":\"1.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-12-01\",\"EMK\":\"2025-12-02\"}",
+    "{\"IDV\":\"2.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-12-03TSR\",\"EMK\":\"2025-12-03TSS\"}",
+    "{\"IDV\":\"3.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-12-04T08:05\",\"EMK\":\"2025-12-04T23:59Z\"}",
+    "{\"IDV\":\"4.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-07-04T07:00L\",\"EMK\":\"TBD\"}",
+};
+
+static std::string eventDump() {
+    std::string all;
+    for ( int i = 0; i < EventManager::N_EVENTS; i++ ) {
+        evMgr.setShowIdx( i );
+        all += evMgr.showEventAtCursor().c_str();
+    }
+    return all;
+}
+
+HT_TEST(marks_pack_losslessly) {
+    const char *marks[] = { "TBD", "2025-06-16", "2025-06-16TSR", "2025-06-16TSS",
+                            "2025-06-16T08:05", "2025-06-16T23:59Z", "2127-12-31T00:00L" };
+    for ( const char *s : marks ) {
+        TimeMark m = TimeMarks::compile( s ), back;
+        PackedMark p;
+        HT_CHECK( packMark( p, m ) );
+        back = unpackMark( p );
+        HT_CHECK( memcmp( &back, &m, sizeof(m) ) == 0 );
+    }
+    PackedMark p;
+    HT_CHECK( !packMark( p, TimeMarks::compile( "1999-12-31" ) ) );    // no 4-byte form
+    HT_CHECK( !packMark( p, TimeMarks::compile( "2025-06-16T08:00Q" ) ) );
+}
+
+HT_TEST(marks_persist_packed) {
+    HostTest::bootFirmware( T0 );
+    int rc = -1;
+    HostSim::callFunction( "s_Config",
+        "{\"LAT\":40.0,\"LNG\":-83.0,\"STD\":-5,\"DST\":true,\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\"}", rc );
+    for ( const char *js : MARK_EVENTS ) evMgr.receiveEvent( js );
+    HT_CHECK_EQ( evMgr.getNEvents(), 4 );
+    std::string before = eventDump();
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 4 );
+    HT_CHECK( eventDump() == before );
+}
+
+HT_TEST(v3_string_marks_migrate) {
+    HostTest::bootFirmware( T0 );
+    int rc = -1;
+    HostSim::callFunction( "s_Config",
+        "{\"LAT\":40.0,\"LNG\":-83.0,\"STD\":-5,\"DST\":true,\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\"}", rc );
+    for ( const char *js : MARK_EVENTS ) evMgr.receiveEvent( js );
+    std::string before = eventDump();
+
+    // The same events as a v3 image from before compiled marks: mark strings
+    static const char *MARKS[4][2] = {
+        { "2025-12-01", "2025-12-02" }, { "2025-12-03TSR", "2025-12-03TSS" },
+        { "2025-12-04T08:05", "2025-12-04T23:59Z" }, { "2025-07-04T07:00L", "TBD" },
+    };
+    eepromShadow.commit();
+    EEPROMHeader h;
+    EEPROM.get( EEPROM_ADDR_HEADER, h );
+    h.version = 3;
+    EEPROM.put( EEPROM_ADDR_HEADER, h );
+    EEPROM.put( EEPROM_ADDR_CONFIG, configData() );       // v3: one ConfigData block
+    EventHeader eh = { 4, EVH_FLAG_CRC, {0} };
+    EEPROM.put( EEPROM_ADDR_EVENT_HDR, eh );
+    for ( int i = 0; i < 4; i++ ) {
+        FlagEvent e;
+        memset( &e, 0, sizeof(e) );
+        snprintf( e.idv, sizeof(e.idv), "%d.1", i + 1 );
+        strcpy( e.flg, "US" );
+        strcpy( e.jur, "FE-US" );
+        strcpy( e.bmk, MARKS[i][0] );
+        strcpy( e.emk, MARKS[i][1] );
+        e.crc8 = eventCRC( e );
+        EEPROM.put( EEPROM_ADDR_EVENT_LIST + i * (int)sizeof(FlagEvent), e );
+    }
+
+    HostTest::bootFirmware( T0 + 60, true );
+    HT_CHECK_EQ( evMgr.getNEvents(), 4 );
+    HT_CHECK( eventDump() == before );
+}
+
+HT_TEST(event_record_is_heap_free) {
+    HT_CHECK( std::is_trivially_copyable<FlagEventEx>::value );
+    HT_CHECK( sizeof(FlagEventEx) <= 64 );
+}
+
+HT_TEST(intern_table_reclaims_codes) {
+    HostTest::bootFirmware( T0 );
+    int rc = -1;
+    HostSim::callFunction( "s_Config", "{\"FED\":\"FE-US\",\"STA\":\"FE-OH\",\"FLG\":\"OH\"}", rc );
+
+    // Far more distinct jurisdictions over time than the table holds
+    for ( int id = 1; id <= 200; id++ ) {
+        String add = String::format( "{\"IDV\":\"%d.1\",\"JUR\":\"J%d\",\"FLG\":\"F%d\","
+                                     "\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\"}", id, id, id );
+        HostSim::callFunction( "s_InjectEv", add, rc );
+        HT_CHECK_EQ( rc, 0 );
+        String del = String::format( "{\"IDV\":\"%d.2\",\"DEL\":true}", id );
+        HostSim::callFunction( "s_InjectEv", del, rc );
+        HT_CHECK_EQ( rc, 0 );
+    }
+
+    HostSim::callFunction( "s_InjectEv",
+        "{\"IDV\":\"900.1\",\"JUR\":\"FE-US\",\"FLG\":\"US\",\"BMK\":\"2025-06-20T12:00Z\",\"EMK\":\"2025-06-20T13:00Z\"}", rc );
+    HT_CHECK_EQ( rc, 0 );
+    HT_CHECK_EQ( evMgr.getNEvents(), 1 );
+
+    evMgr.setShowIdx( 0 );
+    String js = evMgr.showEventAtCursor();
+    HT_CHECK( js.indexOf( "\"JUR\":\"FE-US\"" ) >= 0 );
+    HT_CHECK( js.indexOf( "\"FLG\":\"US\"" ) >= 0 );
+}
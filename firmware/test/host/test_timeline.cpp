@@ -0,0 +1,131 @@
+/**
+ * @file    test_timeline.cpp
+ * @brief   s_Timeline forward schedule: merge rules, open-ended events,
+ *          horizon, paging and the 622-byte payload limit.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static void inject( int id, const char *bmk, const char *emk ) {
+    evMgr.receiveEvent( HostTest::eventJSON( id, 1, "FE-US", bmk, emk ) );
+}
+
+struct Page {
+    int    np = -1, p = -1, days = -1;
+    String now;
+    std::vector<std::pair<long, String>> tr;
+    size_t bytes = 0;
+};
+
+static Page readPage() {
+    Page pg;
+    String js;
+    HT_CHECK( HostSim::readVariable( "s_Timeline", js ) );
+    pg.bytes = js.length();
+
+    JSONValue outer = JSONValue::parseCopy( js.c_str() );
+    JSONObjectIterator it( outer );
+    while ( it.next() ) {
+        String k = String( it.name() );
+        if      ( k == "NP" ) pg.np   = it.value().toInt();
+        else if ( k == "P"  ) pg.p    = it.value().toInt();
+        else if ( k == "D"  ) pg.days = it.value().toInt();
+        else if ( k == "S"  ) pg.now  = String( it.value().toString() );
+        else if ( k == "TR" ) {
+            JSONArrayIterator a( it.value() );
+            while ( a.next() ) {
+                JSONArrayIterator e( a.value() );
+                e.next(); long at = (long)e.value().toDouble();
+                e.next(); pg.tr.push_back( { at, String( e.value().toString() ) } );
+            }
+        }
+    }
+    return pg;
+}
+
+HT_TEST(overlapping_events_merge) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    inject( 1, "2025-06-16T10:00Z", "2025-06-16T14:00Z" );
+    inject( 2, "2025-06-16T13:00Z", "2025-06-16T18:00Z" );   // overlaps 1
+    inject( 3, "2025-06-16T18:00Z", "2025-06-16T19:00Z" );   // touches 2
+    inject( 4, "2025-06-18T12:00Z", "2025-06-18T13:00Z" );
+
+    Page pg = readPage();
+    HT_CHECK( pg.now == "F" );
+    HT_CHECK_EQ( pg.np, 1 );
+    HT_CHECK_EQ( (int)pg.tr.size(), 4 );
+    HT_CHECK_EQ( pg.tr[0].first, 1750068000L ); HT_CHECK( pg.tr[0].second == "H" );   // 06-16 10:00
+    HT_CHECK_EQ( pg.tr[1].first, 1750100400L ); HT_CHECK( pg.tr[1].second == "F" );   // 06-16 19:00
+    HT_CHECK_EQ( pg.tr[2].first, 1750248000L ); HT_CHECK( pg.tr[2].second == "H" );   // 06-18 12:00
+    HT_CHECK_EQ( pg.tr[3].first, 1750251600L ); HT_CHECK( pg.tr[3].second == "F" );
+
+    // The first change is the one setNextEvent() schedules
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), pg.tr[0].first );
+}
+
+HT_TEST(in_progress_and_open_ended) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    inject( 1, "2025-06-15T10:00Z", "2025-06-15T16:00Z" );   // in progress at T0
+    inject( 2, "2025-06-17T10:00Z", "TBD" );                 // open-ended
+
+    Page pg = readPage();
+    HT_CHECK( pg.now == "H" );
+    HT_CHECK_EQ( (int)pg.tr.size(), 2 );
+    HT_CHECK( pg.tr[0].second == "F" );
+    HT_CHECK( pg.tr[1].second == "H" );                     // no FULL for the open end
+}
+
+HT_TEST(horizon_is_selectable) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    inject( 1, "2025-06-16T10:00Z", "2025-06-16T11:00Z" );
+    inject( 2, "2025-06-25T10:00Z", "2025-06-25T11:00Z" );   // day 10
+
+    HT_CHECK_EQ( (int)readPage().tr.size(), 2 );
+
+    int rc = -1;
+    HT_CHECK( HostSim::callFunction( "s_TlPage", "0,14", rc ) );
+    Page pg = readPage();
+    HT_CHECK_EQ( pg.days, 14 );
+    HT_CHECK_EQ( (int)pg.tr.size(), 4 );
+
+    HostSim::callFunction( "s_TlPage", "0,365", rc );
+    HT_CHECK_EQ( readPage().days, EventManager::TL_DAYS_MAX );
+}
+
+HT_TEST(full_table_pages_within_publish_limit) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    // Twelve disjoint half-hour events a day from 2025-06-16
+    for ( int i = 0; i < EventManager::N_EVENTS; i++ ) {
+        char b[24], e[24];
+        snprintf( b, sizeof(b), "2025-06-%02dT%02d:00Z", 16 + i / 12, 2 * ( i % 12 ) );
+        snprintf( e, sizeof(e), "2025-06-%02dT%02d:30Z", 16 + i / 12, 2 * ( i % 12 ) );
+        inject( i + 1, b, e );
+    }
+    HT_CHECK_EQ( evMgr.getNEvents(), EventManager::N_EVENTS );
+
+    const int nTr = 2 * EventManager::N_EVENTS;
+    const int np  = ( nTr + EventManager::TL_PAGE - 1 ) / EventManager::TL_PAGE;
+    int  rc = -1, total = 0;
+    long last = 0;
+    for ( int p = 0; p <= np; p++ ) {
+        HostSim::callFunction( "s_TlPage", String::format( "%d,14", p ), rc );
+        Page pg = readPage();
+        HT_CHECK_EQ( pg.np, np );
+        HT_CHECK( pg.bytes <= 622 );
+        HT_CHECK_EQ( (int)pg.tr.size(), min( EventManager::TL_PAGE, nTr - total ) );
+        if ( !pg.tr.empty() ) {
+            HT_CHECK( last < pg.tr.front().first );
+            last = pg.tr.back().first;
+        }
+        total += (int)pg.tr.size();
+    }
+    HT_CHECK_EQ( total, nTr );
+}
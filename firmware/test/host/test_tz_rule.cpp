@@ -0,0 +1,166 @@
+/**
+ * @file    test_tz_rule.cpp
+ * @brief   DST rule parsing, the cached transition table, and local-time marks
+ *          re-resolved at the DST boundary.
+ */
+
+#include "HostTest.h"
+#include "EventManager.h"
+#include "TzRule.h"
+
+#include <cstring>
+
+// 2025-06-15 12:00:00 UTC
+static const time_t T0 = 1749988800;
+
+static time_t at( int32_t day, int h, int m ) { return (time_t)day * 86400 + h * 3600 + m * 60; }
+
+static void inject( int id, const char *bmk, const char *emk ) {
+    evMgr.receiveEvent( HostTest::eventJSON( id, 1, "FE-US", bmk, emk ) );
+}
+
+HT_TEST(rule_days) {
+    TzRule us = TzRules::northAmerica();
+    HT_CHECK_EQ( TzRules::ruleDay( us.start, 2025 ), 20156 );    // 2025-03-09
+    HT_CHECK_EQ( TzRules::ruleDay( us.end,   2025 ), 20394 );    // 2025-11-02
+    HT_CHECK_EQ( TzRules::ruleDay( us.start, 2026 ), 20520 );    // 2026-03-08
+
+    TzRule eu;
+    HT_CHECK( TzRules::parse( "M3.5.0/2,M10.5.0/3", eu ) );
+    HT_CHECK_EQ( TzRules::ruleDay( eu.start, 2025 ), 20177 );    // 2025-03-30
+    HT_CHECK_EQ( TzRules::ruleDay( eu.end,   2025 ), 20387 );    // 2025-10-26
+    HT_CHECK_EQ( TzRules::ruleDay( eu.start, 2024 ), 19813 );    // 2024-03-31
+    HT_CHECK_EQ( TzRules::ruleDay( eu.end,   2024 ), 20023 );    // 2024-10-27
+}
+
+HT_TEST(parse_and_format) {
+    const char *rules[] = { "M3.2.0/2,M11.1.0/2", "M3.5.0/2,M10.5.0/3", "M10.1.0/2,M4.1.0/3", "M9.1.6/23:30,M4.1.0/1" };
+    for ( const char *s : rules ) {
+        TzRule r;
+        HT_CHECK( TzRules::parse( s, r ) );
+        char buf[TzRules::MAX_LEN + 1];
+        TzRules::format( r, buf, sizeof(buf) );
+        HT_CHECK( strcmp( buf, s ) == 0 );
+    }
+
+    TzRule r;
+    HT_CHECK( TzRules::parse( "M3.2.0,M11.1.0", r ) );          // time defaults to 02:00
+    TzRule us = TzRules::northAmerica();
+    HT_CHECK( memcmp( &r, &us, sizeof(TzRule) ) == 0 );
+
+    const char *bad[] = { "", "M3.2.0", "M13.2.0,M11.1.0", "M3.6.0,M11.1.0", "M3.2.7,M11.1.0",
+                          "M3.2.0/25,M11.1.0", "M3.2.0,M11.1.0x", "J60,J300" };
+    for ( const char *s : bad ) {
+        TzRule keep = us;
+        HT_CHECK( !TzRules::parse( s, keep ) );
+        HT_CHECK( memcmp( &keep, &us, sizeof(TzRule) ) == 0 );
+    }
+}
+
+HT_TEST(us_boundaries) {
+    TzTable tz;
+    tz.build( TzRules::northAmerica(), -300, 2025 );
+
+    // Spring forward 2025-03-09 02:00 EST
+    HT_CHECK_EQ( tz.toUTC( at( 20156, 1, 59 ) ), at( 20156, 6, 59 ) );
+    HT_CHECK_EQ( tz.toUTC( at( 20156, 2, 30 ) ), at( 20156, 6, 30 ) );   // skipped hour: daylight
+    HT_CHECK_EQ( tz.toUTC( at( 20156, 3,  0 ) ), at( 20156, 7,  0 ) );
+
+    // Fall back 2025-11-02 02:00 EDT
+    HT_CHECK_EQ( tz.toUTC( at( 20394, 0, 59 ) ), at( 20394, 4, 59 ) );
+    HT_CHECK_EQ( tz.toUTC( at( 20394, 1, 30 ) ), at( 20394, 5, 30 ) );   // repeated hour: first
+    HT_CHECK_EQ( tz.toUTC( at( 20394, 2,  0 ) ), at( 20394, 7,  0 ) );
+
+    HT_CHECK_EQ( tz.nextChange( T0 ),                at( 20394, 6, 0 ) );
+    HT_CHECK_EQ( tz.nextChange( at( 20394, 6, 0 ) ), at( 20520, 7, 0 ) );   // 2026-03-08
+}
+
+HT_TEST(southern_rule_wraps_the_year) {
+    TzRule au;
+    HT_CHECK( TzRules::parse( "M10.1.0/2,M4.1.0/3", au ) );
+    TzTable tz;
+    tz.build( au, 600, 2025 );
+
+    // January is daylight time; DST ends 2025-04-06 03:00 and starts 2025-10-05 02:00
+    HT_CHECK_EQ( tz.toUTC( at( 20120, 12, 0 ) ), at( 20120, 1, 0 ) );     // 2025-01-31
+    HT_CHECK_EQ( tz.toUTC( at( 20184,  2, 30 ) ), at( 20183, 15, 30 ) );  // before the end
+    HT_CHECK_EQ( tz.toUTC( at( 20184,  3,  0 ) ), at( 20183, 17,  0 ) );
+    HT_CHECK_EQ( tz.toUTC( at( 20366,  1, 59 ) ), at( 20365, 15, 59 ) );
+    HT_CHECK_EQ( tz.toUTC( at( 20366,  3,  0 ) ), at( 20365, 16,  0 ) );
+}
+
+HT_TEST(out_of_window_matches_fresh_table) {
+    TzRule eu;
+    HT_CHECK( TzRules::parse( "M3.5.0/2,M10.5.0/3", eu ) );
+    TzTable cached, fresh;
+    cached.build( eu, 60, 2025 );
+
+    for ( int y = 2020; y <= 2035; y++ ) {
+        fresh.build( eu, 60, y );
+        for ( int32_t d = TzRules::ruleDay( eu.start, y ) - 2; d <= TzRules::ruleDay( eu.end, y ) + 2; d += 1 ) {
+            for ( int h = 0; h < 24; h++ ) {
+                HT_CHECK_EQ( cached.toUTC( at( d, h, 30 ) ), fresh.toUTC( at( d, h, 30 ) ) );
+            }
+        }
+    }
+
+    TzRule none = eu;
+    none.saveMin = 0;
+    cached.build( none, 60, 2025 );
+    HT_CHECK_EQ( cached.toUTC( at( 20300, 12, 0 ) ), at( 20300, 11, 0 ) );
+    HT_CHECK_EQ( cached.nextChange( T0 ), (time_t)0 );
+}
+
+HT_TEST(local_marks_change_at_the_rule_time) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+
+    inject( 1, "2025-06-17T08:00L", "2025-06-17T20:00L" );
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)at( 20256, 12, 0 ) );
+
+    // Before 02:00 on the spring-forward day the clock is still on EST
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    inject( 2, "2026-03-08T01:00L", "2026-03-08T04:00L" );
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)at( 20520, 6, 0 ) );
+}
+
+HT_TEST(dst_boundary_resolves_local_slots_only) {
+    const time_t before = at( 20394, 5, 30 );   // 2025-11-02 01:30 EDT
+    HostTest::bootFirmware( before );
+    HostTest::configureUnit();
+    HT_CHECK_EQ( (long)evMgr.nextDstChange(), (long)at( 20394, 6, 0 ) );
+
+    inject( 1, "2025-11-03T08:00L", "2025-11-03T09:00L" );
+    inject( 2, "2025-11-04T08:00L", "2025-11-04T09:00L" );
+    inject( 3, "2025-11-05T12:00Z", "2025-11-05T13:00Z" );
+
+    uint32_t marks = evMgr.markResolutions();
+    uint32_t dst   = evMgr.dstBoundaries();
+    HostTest::runLoop( 60UL * 60 * 1000, 1000 );
+
+    HT_CHECK_EQ( evMgr.dstBoundaries() - dst,     1u );
+    HT_CHECK_EQ( evMgr.markResolutions() - marks, 2u );
+    HT_CHECK_EQ( (long)evMgr.nextDstChange(), (long)at( 20520, 7, 0 ) );
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)at( 20395, 13, 0 ) );   // 08:00 EST
+}
+
+HT_TEST(rule_set_through_config_persists) {
+    HostTest::bootFirmware( T0 );
+    HostTest::configureUnit();
+    HostTest::configureUnit( "{\"STD\":1,\"TZR\":\"M3.5.0/2,M10.5.0/3\"}" );
+    inject( 1, "2025-06-17T12:00L", "2025-06-17T13:00L" );
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)at( 20256, 10, 0 ) );
+
+    HostTest::configureUnit( "{\"TZR\":\"bogus\"}" );   // field rejected, rule kept
+    HT_CHECK( evMgr.showConfig().indexOf( "\"TZR\":\"M3.5.0/2,M10.5.0/3\"" ) >= 0 );
+
+    HostTest::bootFirmware( T0, true );
+    HT_CHECK( evMgr.showConfig().indexOf( "\"TZR\":\"M3.5.0/2,M10.5.0/3\"" ) >= 0 );
+    HT_CHECK( configToJSON().indexOf( "\"TZR\":\"M3.5.0/2,M10.5.0/3\"" ) >= 0 );
+    HT_CHECK_EQ( (long)evMgr.nextFlagChange(), (long)at( 20256, 10, 0 ) );
+
+    HostTest::configureUnit( "{\"TZR\":\"\"}" );   // back to North American rules
+    HostTest::bootFirmware( T0, true );
+    HT_CHECK( configToJSON().indexOf( "\"TZR\":\"M3.2.0/2,M11.1.0/2\"" ) >= 0 );
+}